@@ -9,6 +9,8 @@
 #include "../simd.h"
 #include "../simd_reductions.h"
 #include "../mask_reductions.h"
+#include "bench_output.h"
+#include "perf_counters.h"
 
 #include <array>
 #include <iostream>
@@ -91,6 +93,110 @@ template <class...>
 
 struct NoRef {};
 
+// the name of T, right-aligned to 6 characters
+template <class T>
+  constexpr const char*
+  value_type_name()
+  {
+    if constexpr (std::is_same_v<T, float>)
+      return " float";
+    else if constexpr (std::is_same_v<T, double>)
+      return "double";
+#ifdef __STDCPP_FLOAT16_T__
+    else if constexpr (std::is_same_v<T, std::float16_t>)
+      return " flt16";
+#endif
+#ifdef __STDCPP_FLOAT32_T__
+    else if constexpr (std::is_same_v<T, std::float32_t>)
+      return " flt32";
+#endif
+#ifdef __STDCPP_FLOAT64_T__
+    else if constexpr (std::is_same_v<T, std::float64_t>)
+      return " flt64";
+#endif
+    else if constexpr (std::is_same_v<T, long long>)
+      return " llong";
+    else if constexpr (std::is_same_v<T, unsigned long long>)
+      return "ullong";
+    else if constexpr (std::is_same_v<T, long>)
+      return "  long";
+    else if constexpr (std::is_same_v<T, unsigned long>)
+      return " ulong";
+    else if constexpr (std::is_same_v<T, int>)
+      return "   int";
+    else if constexpr (std::is_same_v<T, unsigned>)
+      return "  uint";
+    else if constexpr (std::is_same_v<T, short>)
+      return " short";
+    else if constexpr (std::is_same_v<T, unsigned short>)
+      return "ushort";
+    else if constexpr (std::is_same_v<T, char>)
+      return "  char";
+    else if constexpr (std::is_same_v<T, signed char>)
+      return " schar";
+    else if constexpr (std::is_same_v<T, unsigned char>)
+      return " uchar";
+    else if constexpr (std::is_same_v<T, char8_t>)
+      return " char8";
+    else if constexpr (std::is_same_v<T, char16_t>)
+      return "char16";
+    else if constexpr (std::is_same_v<T, char32_t>)
+      return "char32";
+    else if constexpr (std::is_same_v<T, wchar_t>)
+      return " wchar";
+    else
+      return "??????";
+  }
+
+// The name of the type A, from the pretty function name ("[with A = ...; ...]" with GCC,
+// "[A = ...]" with clang), without the std:: qualifications.
+template <class A>
+  std::string
+  type_name()
+  {
+    std::string_view f = __PRETTY_FUNCTION__;
+    f.remove_prefix(f.find("A = ") + 4);
+    f = f.substr(0, std::min(f.find(';'), f.rfind(']')));
+    std::string r(f);
+    for (std::size_t i = r.find("std::"); i != r.npos; i = r.find("std::", i))
+      r.erase(i, 5);
+    return r;
+  }
+
+template <class T>
+  std::string
+  abi_name()
+  {
+    if constexpr (vec_builtin<T>)
+      return "[[gnu::vector_size(" + std::to_string(sizeof(T)) + ")]]";
+    else if constexpr (std::is_simd_v<T>)
+      return type_name<typename T::abi_type>();
+    else
+      return "scalar";
+  }
+
+// Prints the events of perf_samples, scaled to the units of results (i.e. divided by what run()
+// divided the cycles by). Nothing if the counters are not available or if run() did not record
+// exactly one sample per column.
+template <std::size_t N>
+  void
+  print_counters(const Times<N>& results)
+  {
+    const perf_counters& counters = perf_counters::get();
+    for (std::size_t i = 0; i < N; ++i)
+      for (int e = 0; e < counters.size(); ++e)
+        {
+          if (perf_samples.size() != N)
+            {
+              std::cout << std::setw(10) << "n/a";
+              continue;
+            }
+          const perf_sample& sample = perf_samples[i];
+          const double scale = sample.cycles > 0 ? results[i] / sample.cycles : 1.;
+          std::cout << std::setprecision(3) << std::setw(10) << sample.events[e] * scale;
+        }
+  }
+
 template <class T, class... ExtraFlags, class Ref = NoRef>
   auto
   bench_lat_thr(const char* id, const Ref& ref = {})
@@ -106,11 +212,14 @@ template <class T, class... ExtraFlags, class Ref = NoRef>
         static constexpr char dgreen[] = "\033[0;40;32m";
         static constexpr char normal[] = "\033[0m";
 
+        perf_samples.clear();
         const Times<N> results = B::template run<T>();
+        Times<N> speedups;
         std::cout << id;
         for (int i = 0; i < N; ++i)
           {
-            double speedup = 1;
+            double& speedup = speedups[i];
+            speedup = 1;
             if constexpr (!std::is_same_v<Ref, NoRef>)
               speedup = ref[i] * size_v<T> / results[i];
 
@@ -123,7 +232,19 @@ template <class T, class... ExtraFlags, class Ref = NoRef>
               std::cout << red;
             std::cout << std::setw(12) << speedup << normal;
           }
+        print_counters(results);
         std::cout << std::endl;
+        if (bench_output& output = bench_output::get())
+          {
+            std::string flags;
+            ((flags += flags.empty() ? "" : " ", flags += ExtraFlags::name), ...);
+            const std::string abi = abi_name<T>();
+            std::string_view type = value_type_name<value_type_t<T>>();
+            type.remove_prefix(type.find_first_not_of(' '));
+            for (int i = 0; i < N; ++i)
+              output.write({flags, type, abi, size_v<T>, B::info[i], results[i], speedups[i],
+                            perf_samples.size() == N ? &perf_samples[i] : nullptr});
+          }
         if constexpr (std::same_as<Ref, NoRef>)
           return results;
         else
@@ -138,9 +259,18 @@ template <class B, std::size_t N>
   void
   print_header(const cstr<N> &id_name)
   {
+    const perf_counters& counters = perf_counters::get();
+    [[maybe_unused]] static bool once = [&] {
+      std::cout << (counters.core_cycles() ? "cycles: core clock (perf_event)\n"
+                                           : "cycles: TSC (no perf_event access)\n");
+      return true;
+    }();
     std::cout << id_name;
     for (int i = 0; i < B::info.size(); ++i)
       std::cout << ' ' << std::setw(14) << B::info[i] << std::setw(12) << "Speedup";
+    for (int i = 0; i < B::info.size(); ++i)
+      for (int e = 0; e < counters.size(); ++e)
+        std::cout << std::setw(10) << counters.name(e);
     std::cout << '\n';
 
     char pad[N] = {};
@@ -149,6 +279,9 @@ template <class B, std::size_t N>
     std::cout << pad;
     for (int i = 0; i < B::info.size(); ++i)
       std::cout << std::setw(15) << "[cycles/call]" << std::setw(12) << "[per value]";
+    for (int i = 0; i < B::info.size(); ++i)
+      for (int e = 0; e < counters.size(); ++e)
+        std::cout << std::setw(10) << (e == 0 ? B::info[i] : "");
     std::cout << '\n';
   }
 
@@ -171,54 +304,7 @@ template <class T, class... ExtraFlags>
     id[value_type_field] = ',';
     char* extraflags = id + type_field + 1;
 
-    if constexpr (std::is_same_v<T, float>)
-      std::strncpy(typestr, " float", value_type_field);
-    else if constexpr (std::is_same_v<T, double>)
-      std::strncpy(typestr, "double", value_type_field);
-#ifdef __STDCPP_FLOAT16_T__
-    else if constexpr (std::is_same_v<T, std::float16_t>)
-      std::strncpy(typestr, " flt16", value_type_field);
-#endif
-#ifdef __STDCPP_FLOAT32_T__
-    else if constexpr (std::is_same_v<T, std::float32_t>)
-      std::strncpy(typestr, " flt32", value_type_field);
-#endif
-#ifdef __STDCPP_FLOAT64_T__
-    else if constexpr (std::is_same_v<T, std::float64_t>)
-      std::strncpy(typestr, " flt64", value_type_field);
-#endif
-    else if constexpr (std::is_same_v<T, long long>)
-      std::strncpy(typestr, " llong", value_type_field);
-    else if constexpr (std::is_same_v<T, unsigned long long>)
-      std::strncpy(typestr, "ullong", value_type_field);
-    else if constexpr (std::is_same_v<T, long>)
-      std::strncpy(typestr, "  long", value_type_field);
-    else if constexpr (std::is_same_v<T, unsigned long>)
-      std::strncpy(typestr, " ulong", value_type_field);
-    else if constexpr (std::is_same_v<T, int>)
-      std::strncpy(typestr, "   int", value_type_field);
-    else if constexpr (std::is_same_v<T, unsigned>)
-      std::strncpy(typestr, "  uint", value_type_field);
-    else if constexpr (std::is_same_v<T, short>)
-      std::strncpy(typestr, " short", value_type_field);
-    else if constexpr (std::is_same_v<T, unsigned short>)
-      std::strncpy(typestr, "ushort", value_type_field);
-    else if constexpr (std::is_same_v<T, char>)
-      std::strncpy(typestr, "  char", value_type_field);
-    else if constexpr (std::is_same_v<T, signed char>)
-      std::strncpy(typestr, " schar", value_type_field);
-    else if constexpr (std::is_same_v<T, unsigned char>)
-      std::strncpy(typestr, " uchar", value_type_field);
-    else if constexpr (std::is_same_v<T, char8_t>)
-      std::strncpy(typestr, " char8", value_type_field);
-    else if constexpr (std::is_same_v<T, char16_t>)
-      std::strncpy(typestr, "char16", value_type_field);
-    else if constexpr (std::is_same_v<T, char32_t>)
-      std::strncpy(typestr, "char32", value_type_field);
-    else if constexpr (std::is_same_v<T, wchar_t>)
-      std::strncpy(typestr, " wchar", value_type_field);
-    else
-      std::strncpy(typestr, "??????", value_type_field);
+    std::strncpy(typestr, value_type_name<T>(), value_type_field);
 
     ([&] {
       std::strncpy(extraflags, ExtraFlags::name, sizeof(ExtraFlags::name) - 1);
@@ -275,10 +361,9 @@ template <class T, class... ExtraFlags>
         bench_lat_thr<V64, ExtraFlags...>(id, ref);
       }
 
-    char sep[id_size + 2 * 15 + 2 * 12];
-    std::memset(sep, '-', sizeof(sep) - 1);
-    sep[sizeof(sep) - 1] = '\0';
-    std::cout << sep << std::endl;
+    constexpr std::size_t columns = Benchmark<ExtraFlags...>::info.size();
+    std::cout << std::string(id_size - 1 + columns * (15 + 12 + 10 * perf_counters::get().size()),
+                             '-') << std::endl;
   }
 
 template <long Iterations, int Retries = 10, class F>
@@ -288,8 +373,9 @@ template <long Iterations, int Retries = 10, class F>
   {
     struct {
       double mean = 0;
-      double minimum = std::numeric_limits<double>::max();
-      unsigned long tsc_start = 0;
+      double sum2 = 0;
+      perf_sample minimum;
+      perf_sample start;
       int todo = Retries;
       long it = 1;
 
@@ -299,48 +385,77 @@ template <long Iterations, int Retries = 10, class F>
         if (--it > 0) [[likely]]
           return true;
 
-        unsigned int tmp = 0;
-        const auto tsc_end = __rdtscp(&tmp);
+        const perf_sample end = perf_counters::get().now();
         if (todo < Retries)
           {
-            const double elapsed = tsc_end - tsc_start;
-            const double one_mean = elapsed / Iterations;
-            mean += one_mean / Retries;
-            minimum = std::min(minimum, one_mean);
+            const perf_sample one_mean = (end - start) / Iterations;
+            mean += one_mean.cycles / Retries;
+            sum2 += one_mean.cycles * one_mean.cycles;
+            if (one_mean.cycles < minimum.cycles)
+              minimum = one_mean;
           }
         if (todo) [[likely]]
           {
             --todo;
             it = Iterations + 1;
-            tsc_start = __rdtscp(&tmp);
+            start = perf_counters::get().now();
             return true;
           }
         return false;
       }
     } collector;
+    collector.minimum.cycles = std::numeric_limits<double>::max();
     fun(collector);
-    return collector.minimum;
+    collector.minimum.mean = collector.mean;
+    collector.minimum.variance
+      = Retries > 1 ? std::max(0., (collector.sum2 - Retries * collector.mean * collector.mean)
+                                     / (Retries - 1))
+                    : 0.;
+    collector.minimum.retries = Retries;
+    perf_samples.push_back(collector.minimum);
+    return collector.minimum.cycles;
   }
 
+// Returns the minimum number of cycles per call of fun (core cycles if available, see
+// perf_counters.h) and appends the counters of that run to perf_samples.
 template <long Iterations, int Retries = 10, class F, class... Args>
   double
   time_mean(F&& fun, Args&&... args)
   {
-    double minimum = std::numeric_limits<double>::max();
+    const perf_counters& counters = perf_counters::get();
+    perf_sample minimum;
+    minimum.cycles = std::numeric_limits<double>::max();
+    double sum = 0;
+    double sum2 = 0;
     for (int tries = 0; tries < Retries; ++tries)
       {
-        unsigned int tmp;
         long i = Iterations;
-        const auto start = __rdtscp(&tmp);
+        const perf_sample start = counters.now();
         for (; i; --i)
           fun(std::forward<Args>(args)...);
-        const auto end = __rdtscp(&tmp);
-        const double elapsed = end - start;
-        minimum = std::min(minimum, elapsed);
+        const perf_sample elapsed = counters.now() - start;
+        if (elapsed.cycles < minimum.cycles)
+          minimum = elapsed;
+        sum += elapsed.cycles;
+        sum2 += elapsed.cycles * elapsed.cycles;
       }
-    return minimum / Iterations;
+    minimum.mean = sum / Retries;
+    minimum.variance = Retries > 1 ? std::max(0., (sum2 - sum * minimum.mean) / (Retries - 1)) : 0.;
+    minimum.retries = Retries;
+    perf_samples.push_back(minimum / Iterations);
+    return perf_samples.back().cycles;
   }
 
+// Replaces the last two entries of perf_samples (from two time_mean calls) by their difference,
+// divided by n.
+inline void
+perf_samples_subtract(double n)
+{
+  const perf_sample diff = perf_samples.end()[-2] - perf_samples.end()[-1];
+  perf_samples.pop_back();
+  perf_samples.back() = diff / n;
+}
+
 template <typename T>
   [[gnu::always_inline]] inline void
   fake_modify_one(T& x)
@@ -354,8 +469,13 @@ template <typename T>
         for (auto& d : __data(x))
           fake_modify_one(d);
       }
+    else if constexpr (requires { {auto(__data(x))} -> std::integral; })
+      fake_modify_one(__data(x));
     else if constexpr (sizeof(x) >= 16)
       asm volatile("" : "+v,x"(x));
+    else if constexpr (std::is_integral_v<T>)
+      // not "g": a memory operand adds a store/load round trip to the chain (e.g. simd<char, 1>)
+      asm volatile("" : "+r"(x));
     else
       asm volatile("" : "+v,x,g"(x));
   }
@@ -404,6 +524,7 @@ template <long Iterations = 200'000, int Retries = 10, typename T, std::size_t N
 
     const double dt = time_mean<Iterations, Retries>([&] { process_one(data[0]); })
                         - time_mean<Iterations, Retries>([&] { fake_one(data[0]); });
+    perf_samples_subtract(1);
 
     if (dt >= 0.98)
       return dt;
@@ -427,6 +548,7 @@ template <long Iterations = 200'000, int Retries = 10, typename T, std::size_t N
                (fake_one(data[Is]), ...);
              }, std::make_index_sequence<N>()))
           / N;
+    perf_samples_subtract(N);
 
     return dt;
   }
@@ -0,0 +1,175 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef BENCH_OUTPUT_H_
+#define BENCH_OUTPUT_H_
+
+#include "perf_counters.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+/* Machine-readable results
+ * ========================
+ *
+ * With BENCH_OUTPUT=<file>, every cell of the bench_all tables is also appended to <file>, one
+ * record per row and Times column: as CSV if the file name ends in ".csv" (with a header line if
+ * the file is new), as JSON Lines otherwise. The fields are
+ *
+ *   benchmark, arch, compiler, clock ("core" or "tsc"), flags (the names of the ExtraFlags), type,
+ *   abi (the abi_type of simd types, e.g. _VecAbi<8>), width, column (the Info name), value,
+ *   speedup (the printed numbers), mean, stddev, retries (the statistics of the time_mean retries
+ *   the value is the minimum of, in the units of value), and, in JSON only, events (see
+ *   perf_counters.h).
+ *
+ * mean and stddev are empty (CSV) or null (JSON) if the benchmark did not record one sample per
+ * column. BENCH_NAME and BENCH_ARCH set the benchmark and arch fields (run.sh sets both); the
+ * defaults are the program name and "".
+ *
+ * compare.sh compares two CSV files.
+ */
+
+#ifdef __clang__
+inline constexpr char bench_compiler[] = "clang " __clang_version__;
+#else
+inline constexpr char bench_compiler[] = "gcc " __VERSION__;
+#endif
+
+struct bench_record
+{
+  std::string_view flags;
+  std::string_view type;
+  std::string_view abi;
+  int width;
+  std::string_view column;
+  double value;
+  double speedup;
+  // nullptr if unknown
+  const perf_sample* sample;
+};
+
+class bench_output
+{
+  std::ofstream file;
+
+  bool csv = false;
+
+  std::string benchmark;
+
+  std::string arch;
+
+  bench_output()
+  {
+    const char* path = std::getenv("BENCH_OUTPUT");
+    if (not path or not *path)
+      return;
+    const char* name = std::getenv("BENCH_NAME");
+    const char* arch_env = std::getenv("BENCH_ARCH");
+    benchmark = name ? name : program_invocation_short_name;
+    arch = arch_env ? arch_env : "";
+    csv = std::string_view(path).ends_with(".csv");
+    const bool is_new = not std::ifstream(path).good();
+    file.open(path, std::ios::app);
+    file.precision(6);
+    if (csv and is_new)
+      file << "benchmark,arch,compiler,clock,flags,type,abi,width,column,value,speedup,mean,stddev,"
+              "retries\n";
+  }
+
+  // CSV fields must not contain commas
+  static std::string
+  csv_field(std::string_view s)
+  {
+    std::string r(s);
+    for (char& c : r)
+      if (c == ',')
+        c = ';';
+    return r;
+  }
+
+  static std::string
+  json_string(std::string_view s)
+  {
+    std::string r = "\"";
+    for (char c : s)
+      {
+        if (c == '"' or c == '\\')
+          r += '\\';
+        r += c;
+      }
+    return r + '"';
+  }
+
+public:
+  static bench_output&
+  get()
+  {
+    static bench_output output;
+    return output;
+  }
+
+  explicit
+  operator bool() const
+  { return file.is_open(); }
+
+  void
+  write(const bench_record& r)
+  {
+    if (not file.is_open())
+      return;
+    const perf_counters& counters = perf_counters::get();
+    const char* clock = counters.core_cycles() ? "core" : "tsc";
+    // the sample in the units of value (see print_counters)
+    const double scale
+      = r.sample and r.sample->cycles > 0 ? r.value / r.sample->cycles : 1.;
+    if (csv)
+      {
+        file << csv_field(benchmark) << ',' << csv_field(arch) << ',' << csv_field(bench_compiler)
+             << ',' << clock << ',' << csv_field(r.flags) << ',' << csv_field(r.type) << ','
+             << csv_field(r.abi) << ',' << r.width << ',' << csv_field(r.column) << ','
+             << r.value << ',' << r.speedup << ',';
+        if (r.sample)
+          file << r.sample->mean * scale << ',' << std::sqrt(r.sample->variance) * scale << ','
+               << r.sample->retries;
+        else
+          file << ",,";
+        file << '\n';
+      }
+    else
+      {
+        file << "{\"benchmark\": " << json_string(benchmark)
+             << ", \"arch\": " << json_string(arch)
+             << ", \"compiler\": " << json_string(bench_compiler)
+             << ", \"clock\": \"" << clock
+             << "\", \"flags\": " << json_string(r.flags)
+             << ", \"type\": " << json_string(r.type)
+             << ", \"abi\": " << json_string(r.abi)
+             << ", \"width\": " << r.width
+             << ", \"column\": " << json_string(r.column)
+             << ", \"value\": " << r.value
+             << ", \"speedup\": " << r.speedup;
+        if (r.sample)
+          {
+            file << ", \"mean\": " << r.sample->mean * scale
+                 << ", \"stddev\": " << std::sqrt(r.sample->variance) * scale
+                 << ", \"retries\": " << r.sample->retries << ", \"events\": {";
+            for (int e = 0; e < counters.size(); ++e)
+              file << (e == 0 ? "" : ", ") << json_string(counters.name(e)) << ": "
+                   << r.sample->events[e] * scale;
+            file << '}';
+          }
+        else
+          file << ", \"mean\": null, \"stddev\": null, \"retries\": null, \"events\": {}";
+        file << "}\n";
+      }
+    file.flush();
+  }
+};
+
+#endif  // BENCH_OUTPUT_H_
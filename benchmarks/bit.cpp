@@ -0,0 +1,127 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_bit.h"
+
+struct BitReverse
+{ static constexpr char name[] = "bit_reverse"; };
+
+namespace my
+{
+  template <std::unsigned_integral T>
+    T
+    popcount(T x)
+    { return T(std::popcount(x)); }
+
+  template <typename T>
+    requires std::is_simd_v<T>
+    T
+    popcount(T x)
+    { return std::bit_cast<T>(std::popcount(x)); }
+
+  template <std::unsigned_integral T>
+    T
+    bit_reverse(T x)
+    {
+      T r = 0;
+      for (int i = 0; i < std::numeric_limits<T>::digits; ++i)
+        r = T(r << 1) | T((x >> i) & 1);
+      return r;
+    }
+
+  using std::bit_reverse;
+}
+
+// Population count (i.e. _S_popcount)
+template <>
+  struct Benchmark<>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::unsigned_integral<value_type_t<T>> and not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        T one = T() + TT(1);
+        fake_modify(one);
+
+        auto process_one = [&](T& inout) {
+          T x = inout + one;
+          fake_modify(x);
+          x = my::popcount(x);
+          inout = x - one;
+        };
+
+        auto fake_one = [&](T& inout) {
+          T x = inout + one;
+          fake_modify(x);
+          inout = x - one;
+        };
+
+        // the fake_modify in both lambdas cancels out, leaving the cost of the bit operation
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+// Reversal of the bit order (i.e. _S_bit_reverse)
+template <>
+  struct Benchmark<BitReverse>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::unsigned_integral<value_type_t<T>> and not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        T one = T() + TT(1);
+        fake_modify(one);
+
+        auto process_one = [&](T& inout) {
+          T x = inout + one;
+          fake_modify(x);
+          x = my::bit_reverse(x);
+          inout = x - one;
+        };
+
+        auto fake_one = [&](T& inout) {
+          T x = inout + one;
+          fake_modify(x);
+          inout = x - one;
+        };
+
+        // the fake_modify in both lambdas cancels out, leaving the cost of the bit operation
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+int
+main()
+{
+  bench_all<unsigned char>();
+  bench_all<unsigned char, BitReverse>();
+  bench_all<unsigned short>();
+  bench_all<unsigned short, BitReverse>();
+  bench_all<unsigned int>();
+  bench_all<unsigned int, BitReverse>();
+  bench_all<unsigned long>();
+  bench_all<unsigned long, BitReverse>();
+}
@@ -0,0 +1,121 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_integer.h"
+
+namespace my
+{
+  using std::add_sat;
+  using std::sub_sat;
+  using std::avg;
+
+  template <std::integral T>
+    T
+    add_sat(T x, T y)
+    {
+      T r;
+      if (not __builtin_add_overflow(x, y, &r))
+        return r;
+      else if (std::is_unsigned_v<T> or x > 0)
+        return std::numeric_limits<T>::max();
+      else
+        return std::numeric_limits<T>::min();
+    }
+
+  template <std::integral T>
+    T
+    sub_sat(T x, T y)
+    {
+      T r;
+      if (not __builtin_sub_overflow(x, y, &r))
+        return r;
+      else if (std::is_unsigned_v<T> or x < 0)
+        return std::numeric_limits<T>::min();
+      else
+        return std::numeric_limits<T>::max();
+    }
+
+  template <std::integral T>
+    T
+    avg(T x, T y)
+    { return (x | y) - ((x ^ y) >> 1); }
+
+  template <vec_builtin V>
+    V
+    add_sat(V x, const V y)
+    {
+      for (int i = 0; i < size_v<V>; ++i)
+        x[i] = add_sat(x[i], y[i]);
+      return x;
+    }
+
+  template <vec_builtin V>
+    V
+    sub_sat(V x, const V y)
+    {
+      for (int i = 0; i < size_v<V>; ++i)
+        x[i] = sub_sat(x[i], y[i]);
+      return x;
+    }
+
+  template <vec_builtin V>
+    V
+    avg(V x, const V y)
+    {
+      for (int i = 0; i < size_v<V>; ++i)
+        x[i] = avg(x[i], y[i]);
+      return x;
+    }
+}
+
+// Additive blend of a foreground layer onto a pixel, averaged with a background layer, followed by
+// a darkening pass. All steps saturate or round like image processing code does.
+template <>
+  struct Benchmark<>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = std::integral<value_type_t<T>>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        T fg = T() + TT(3);
+        T bg = T() + TT(std::numeric_limits<TT>::max() / 2);
+        T dark = T() + TT(1);
+        fake_modify(fg, bg, dark);
+
+        auto process_one = [&](T& inout) {
+          const T x = my::avg(my::add_sat(inout, fg), bg);
+          inout = my::sub_sat(x, dark);
+        };
+
+        auto fake_one = [&](T& inout) {
+          T x = inout + fg;
+          fake_modify(x);
+          inout = x - dark;
+        };
+
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+int
+main()
+{
+  bench_all<signed char>();
+  bench_all<unsigned char>();
+  bench_all<signed short>();
+  bench_all<unsigned short>();
+  bench_all<signed int>();
+  bench_all<unsigned int>();
+}
@@ -0,0 +1,99 @@
+#!/bin/bash
+## SPDX-License-Identifier: GPL-3.0-or-later
+## Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+##                       Matthias Kretz <m.kretz@gsi.de>
+
+usage() {
+  cat <<EOF
+Usage: $0 [-a|--all] <old.csv> <new.csv>
+
+Compares two benchmark runs recorded with BENCH_OUTPUT=<file>.csv (see bench_output.h and
+run.sh). Records are matched on benchmark, arch, flags, type, abi, width, and column. For every
+match the mean cycles of the old and new run are compared with Welch's t-test (from the mean,
+stddev, and number of retries of time_mean). Only significant differences (95%, two-sided) are
+listed, unless -a is given.
+
+The exit status is 1 if any record got significantly slower, 0 otherwise.
+EOF
+}
+
+all=0
+files=()
+while (($# > 0)); do
+  case "$1" in
+    -h|--help)
+      usage
+      exit 0
+      ;;
+    -a|--all)
+      all=1
+      ;;
+    *)
+      files=("${files[@]}" "$1")
+      ;;
+  esac
+  shift
+done
+
+if ((${#files[@]} != 2)); then
+  usage
+  exit 2
+fi
+
+awk -F, -v all=$all '
+function key() { return $1 "," $2 "," $5 "," $6 "," $7 "," $8 "," $9 }
+
+# the 97.5% quantile of the t distribution with df degrees of freedom (Cornish-Fisher expansion)
+function t_crit(df,   z) {
+  z = 1.959964
+  return z + (z^3 + z) / (4 * df) + (5 * z^5 + 16 * z^3 + 3 * z) / (96 * df^2)
+}
+
+FNR == 1 { next }  # header
+
+NR == FNR {
+  if ($12 != "") {
+    mean[key()] = $12
+    sd[key()] = $13
+    n[key()] = $14
+  }
+  next
+}
+
+{
+  k = key()
+  if (!(k in mean) || $12 == "") {
+    ++unmatched
+    next
+  }
+  m1 = mean[k]; s1 = sd[k]; n1 = n[k]
+  m2 = $12; s2 = $13; n2 = $14
+  se2 = s1^2 / n1 + s2^2 / n2
+  change = m1 != 0 ? (m2 - m1) / m1 * 100 : 0
+  if (se2 > 0) {
+    t = (m2 - m1) / sqrt(se2)
+    df = se2^2 / ((s1^2 / n1)^2 / (n1 - 1) + (s2^2 / n2)^2 / (n2 - 1))
+    sig = (t > t_crit(df) || -t > t_crit(df))
+  } else {
+    t = 0
+    sig = (m1 != m2)
+  }
+  if (sig && m2 > m1) ++slower
+  if (sig && m2 < m1) ++faster
+  if (all || sig) {
+    if (!header++)
+      printf "%-60s %12s %12s %9s %8s\n", "benchmark,arch,flags,type,abi,width,column", "old", "new",
+             "change", "t"
+    printf "%-60s %12.4g %12.4g %8.1f%% %8.2f%s\n", k, m1, m2, change, t,
+           sig ? (m2 > m1 ? " slower" : " faster") : ""
+  }
+}
+
+END {
+  printf "%d significantly slower, %d significantly faster, %d without a match\n",
+         slower, faster, unmatched
+  exit slower > 0
+}
+' "${files[0]}" "${files[1]}"
+
+# vim: tw=0 si sw=2
@@ -0,0 +1,112 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "../simd_complex.h"
+
+// must be declared before bench.h, so that its templates find the overloads
+template <typename T>
+  void
+  fake_modify_one(std::complex<T>& x);
+
+template <typename V, std::simd_complex_layout L>
+  void
+  fake_modify_one(std::simd_complex<V, L>& x);
+
+#include "bench.h"
+
+template <typename T>
+  [[gnu::always_inline]] inline void
+  fake_modify_one(std::complex<T>& x)
+  {
+    auto& parts = reinterpret_cast<T(&)[2]>(x);
+    fake_modify_one(parts[0]);
+    fake_modify_one(parts[1]);
+  }
+
+template <typename V, std::simd_complex_layout L>
+  [[gnu::always_inline]] inline void
+  fake_modify_one(std::simd_complex<V, L>& x)
+  {
+    // simd_complex stores either one interleaved simd or two simds
+    if constexpr (L == std::simd_complex_layout::interleaved)
+      fake_modify_one(reinterpret_cast<std::resize_simd_t<2 * V::size(), V>&>(x));
+    else
+      {
+        auto& parts = reinterpret_cast<std::array<V, 2>&>(x);
+        fake_modify_one(parts[0]);
+        fake_modify_one(parts[1]);
+      }
+  }
+
+struct Split
+{ static constexpr char name[] = "split"; };
+
+template <typename T, std::simd_complex_layout L>
+  struct complex_type
+  { using type = std::complex<T>; };
+
+template <typename T, std::simd_complex_layout L>
+  requires std::is_simd_v<T> and requires { typename std::simd_complex<T, L>; }
+  struct complex_type<T, L>
+  { using type = std::simd_complex<T, L>; };
+
+template <std::simd_complex_layout L>
+  struct ComplexMultiply
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = std::floating_point<value_type_t<T>> and not vec_builtin<T>
+                                       and (not std::is_simd_v<T>
+                                              or requires { typename std::simd_complex<T, L>; });
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        using C = typename complex_type<T, L>::type;
+        C w = C(std::complex<TT>(TT(.6), TT(.8)));
+        C one = C(std::complex<TT>(TT(1), TT(0)));
+        fake_modify(w, one);
+
+        auto process_one = [&](C& inout) {
+          C x = inout + one;
+          fake_modify(x);
+          x = x * w;
+          inout = x - one;
+        };
+
+        auto fake_one = [&](C& inout) {
+          C x = inout + one;
+          fake_modify(x);
+          inout = x - one;
+        };
+
+        C a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+// std::complex<T> vs. interleaved simd_complex (fmaddsub)
+template <>
+  struct Benchmark<> : ComplexMultiply<std::simd_complex_layout::interleaved>
+  {};
+
+// std::complex<T> vs. split simd_complex
+template <>
+  struct Benchmark<Split> : ComplexMultiply<std::simd_complex_layout::split>
+  {};
+
+int
+main()
+{
+  bench_all<float>();
+  bench_all<float, Split>();
+  bench_all<double>();
+  bench_all<double, Split>();
+}
@@ -0,0 +1,97 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+
+struct ToShort
+{
+  static constexpr char name[] = "via short";
+
+  using type = short;
+};
+
+struct ToInt
+{
+  static constexpr char name[] = "via int";
+
+  using type = int;
+};
+
+struct ToFloat
+{
+  static constexpr char name[] = "via float";
+
+  using type = float;
+};
+
+struct ToDouble
+{
+  static constexpr char name[] = "via double";
+
+  using type = double;
+};
+
+template <typename U, typename T>
+  [[gnu::always_inline]] inline auto
+  convert(const T& x)
+  {
+    if constexpr (std::is_simd_v<T>)
+      return std::rebind_simd_t<U, T>(x);
+    else
+      return U(x);
+  }
+
+// Conversion to To::type and back with the converting constructors:
+// `T(rebind_simd_t<To::type, T>(x))`
+template <class To>
+  struct Benchmark<To>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        T one = T() + TT(1);
+        fake_modify(one);
+
+        // the fake_modify in both lambdas cancels out, leaving the cost of the two conversions;
+        // the one in between keeps the compiler from eliding exact round trips
+        auto process_one = [&](T& inout) {
+          fake_modify(inout);
+          auto x = convert<typename To::type>(inout);
+          fake_modify(x);
+          inout = convert<TT>(x) + one;
+        };
+
+        auto fake_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout + one;
+        };
+
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+int
+main()
+{
+  bench_all<float, ToInt>();
+  bench_all<float, ToDouble>();
+  bench_all<double, ToFloat>();
+  bench_all<double, ToInt>();
+  bench_all<int, ToFloat>();
+  bench_all<int, ToDouble>();
+  bench_all<int, ToShort>();
+  bench_all<short, ToInt>();
+  bench_all<short, ToFloat>();
+}
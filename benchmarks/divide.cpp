@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_divider.h"
+
+struct Divider
+{ static constexpr char name[] = "simd_divider"; };
+
+// Division by a runtime-invariant divisor: `x / V(d)` (i.e. _S_divides)
+template <>
+  struct Benchmark<>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = std::integral<value_type_t<T>>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        T d = T() + TT(7);
+        T one = T() + TT(1);
+        fake_modify(d, one);
+
+        // the fake_modify in both lambdas cancels out, leaving the cost of the division
+        auto process_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout / d + one;
+        };
+
+        auto fake_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout + one;
+        };
+
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+// Division by the same divisor via simd_divider: high multiplication and shifts
+template <>
+  struct Benchmark<Divider>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = std::is_simd_v<T> and std::integral<value_type_t<T>>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        TT d = 7;
+        T one = T() + TT(1);
+        fake_modify(d, one);
+        const std::simd_divider<TT> div(d);
+
+        // the fake_modify in both lambdas cancels out, leaving the cost of the division
+        auto process_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout / div + one;
+        };
+
+        auto fake_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout + one;
+        };
+
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+int
+main()
+{
+  bench_all<signed char>();
+  bench_all<signed char, Divider>();
+  bench_all<unsigned char>();
+  bench_all<unsigned char, Divider>();
+  bench_all<signed short>();
+  bench_all<signed short, Divider>();
+  bench_all<unsigned short>();
+  bench_all<unsigned short, Divider>();
+  bench_all<signed int>();
+  bench_all<signed int, Divider>();
+  bench_all<unsigned int>();
+  bench_all<unsigned int, Divider>();
+  bench_all<signed long>();
+  bench_all<signed long, Divider>();
+  bench_all<unsigned long>();
+  bench_all<unsigned long, Divider>();
+}
@@ -0,0 +1,111 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+
+struct Aligned
+{
+  static constexpr char name[] = "aligned";
+
+  static constexpr int offset = 0;
+
+  static constexpr auto flags = std::simd_flag_aligned;
+};
+
+struct Unaligned
+{
+  static constexpr char name[] = "unaligned";
+
+  // one element past the alignment boundary
+  static constexpr int offset = 1;
+
+  static constexpr auto flags = std::simd_flag_default;
+};
+
+struct Masked
+{
+  static constexpr char name[] = "masked";
+
+  static constexpr int offset = 0;
+
+  static constexpr auto flags = std::simd_flag_aligned;
+};
+
+// A store of x followed by a load from the same address: `x.copy_to(p); x = T(p)`. The latency is
+// the store-to-load forwarding latency, the throughput is limited by the store and load ports. The
+// masked variant stores and loads every second element with `copy_to(p, k)` and `copy_from(p, k)`.
+template <class Op>
+  struct Benchmark<Op>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    static constexpr bool masked = std::same_as<Op, Masked>;
+
+    // not for scalars, which may live in general purpose registers, where CPUs with memory
+    // renaming forward a store to a load without latency
+    template <typename T>
+      static constexpr bool accept = std::is_simd_v<T> and size_v<T> >= 2;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        // one row per element of `a` below, each starting on a cache line
+        constexpr int row = std::max(2 * size_v<T>, int(64 / sizeof(TT)));
+        alignas(64) TT mem[8][row] = {};
+        T one = T() + TT(1);
+        fake_modify(one);
+        T a[8] = {};
+
+        // the asm hides from the compiler that the load reads what the store wrote
+        auto process_one = [&](T& inout) {
+          fake_modify(inout);
+          TT* ptr = mem[&inout - a] + Op::offset;
+          if constexpr (masked)
+            {
+              typename T::mask_type k([](int i) { return i % 2 == 0; });
+              fake_modify(k);
+              inout.copy_to(ptr, k, Op::flags);
+              asm("" : "+r"(ptr));
+              inout.copy_from(ptr, k, Op::flags);
+              inout += one;
+            }
+          else
+            {
+              inout.copy_to(ptr, Op::flags);
+              asm("" : "+r"(ptr));
+              inout = T(ptr, Op::flags) + one;
+            }
+        };
+
+        // the fake_modify in both lambdas cancels out, leaving the cost of the store and the load
+        auto fake_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout + one;
+        };
+
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+int
+main()
+{
+  bench_all<float, Aligned>();
+  bench_all<float, Unaligned>();
+  bench_all<float, Masked>();
+  bench_all<double, Aligned>();
+  bench_all<double, Unaligned>();
+  bench_all<double, Masked>();
+  bench_all<int, Aligned>();
+  bench_all<int, Unaligned>();
+  bench_all<int, Masked>();
+  bench_all<short, Aligned>();
+  bench_all<short, Unaligned>();
+  bench_all<short, Masked>();
+}
@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+
+struct Select
+{
+  static constexpr char name[] = "simd_select";
+
+  static constexpr int min_size = 1;
+
+  // the compare and the blend
+  template <typename T>
+    static T
+    apply(const T& x, const T& limit, const T& one)
+    { return std::simd_select(x > limit, x, one); }
+};
+
+struct ReduceCount
+{
+  static constexpr char name[] = "reduce_count";
+
+  static constexpr int min_size = 1;
+
+  // the compare, the reduction, and the broadcast back into the chain
+  template <typename T>
+    static T
+    apply(const T& x, const T& limit, const T&)
+    { return x + value_type_t<T>(std::reduce_count(x > limit)); }
+};
+
+struct ReduceMinIndex
+{
+  static constexpr char name[] = "reduce_min_index";
+
+  // for a single value the index is always 0
+  static constexpr int min_size = 2;
+
+  // the compare, the reduction, and the broadcast back into the chain; `limit` is the lowest value,
+  // thus the mask is never empty
+  template <typename T>
+    static T
+    apply(const T& x, const T& limit, const T&)
+    { return x + value_type_t<T>(std::reduce_min_index(x >= limit)); }
+};
+
+// Functions of masks that the compiler cannot see through (the compare against `limit` depends on
+// the chain)
+template <class Op>
+  struct Benchmark<Op>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = not vec_builtin<T> and size_v<T> >= Op::min_size;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        T one = T() + TT(1);
+        T limit = T() + (std::same_as<Op, ReduceMinIndex> ? std::numeric_limits<TT>::lowest()
+                                                          : TT(3));
+        fake_modify(one, limit);
+
+        // the fake_modify in both lambdas cancels out, leaving the cost of Op
+        auto process_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = Op::apply(inout, limit, one) + one;
+        };
+
+        auto fake_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout + one;
+        };
+
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+template <typename T>
+  void
+  bench_masks()
+  {
+    bench_all<T, Select>();
+    bench_all<T, ReduceCount>();
+    bench_all<T, ReduceMinIndex>();
+  }
+
+int
+main()
+{
+  bench_masks<float>();
+  bench_masks<double>();
+  bench_masks<int>();
+  bench_masks<short>();
+  bench_masks<signed char>();
+}
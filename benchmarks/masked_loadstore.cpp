@@ -0,0 +1,123 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+
+struct Masked
+{ static constexpr char name[] = "masked copy"; };
+
+struct BitIteration
+{ static constexpr char name[] = "bit iteration"; };
+
+struct Convert
+{ static constexpr char name[] = "from/to short"; };
+
+struct PageSafe
+{ static constexpr char name[] = "page safe"; };
+
+// number of elements per call (L1 resident)
+constexpr int n = 2048;
+
+// cycles per step of size_v<T> elements
+template <typename T>
+  double
+  per_step(auto&& fun)
+  { return time_mean<2000>(fun) * size_v<T> / n; }
+
+// dst[i] = src[i] if cond[i] > 0, with a random condition (about every second element)
+template <typename TT, typename UU>
+  struct Buffers
+  {
+    alignas(64) TT cond[n];
+
+    alignas(64) UU src[n];
+
+    alignas(64) UU dst[n];
+
+    Buffers()
+    {
+      unsigned r = 1;
+      for (int i = 0; i < n; ++i)
+        {
+          r = r * 1103515245u + 12345u;
+          cond[i] = TT(int(r >> 16) % 2 == 0 ? 1 : -1);
+          src[i] = UU(i % 7);
+          dst[i] = UU();
+        }
+    }
+  };
+
+// copy_from and copy_to with a mask
+template <class... Flags>
+  struct Benchmark<Masked, Flags...>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = not vec_builtin<T>;
+
+    static constexpr bool bit_iteration = (std::same_as<Flags, BitIteration> or ...);
+
+    // __simd_flag_page_safe allows a full load + blend without a masked move instruction
+    static constexpr auto load_flags = [] {
+      if constexpr ((std::same_as<Flags, PageSafe> or ...))
+        return std::simd_flag_convert | std::__simd_flag_page_safe;
+      else
+        return std::simd_flag_convert;
+    }();
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        using UU = std::conditional_t<(std::same_as<Flags, Convert> or ...), short, TT>;
+        Buffers<TT, UU> buf;
+        asm volatile("" :: "r"(&buf) : "memory");
+        return {per_step<T>([&] {
+                  if constexpr (std::is_simd_v<T>)
+                    for (int i = 0; i + T::size() <= n; i += T::size())
+                      {
+                        const typename T::mask_type k = T(buf.cond + i) > TT();
+                        T x;
+                        if constexpr (bit_iteration and requires { typename T::_Impl::_Base; })
+                          {
+                            // the generic implementation: a scalar load/store per selected element
+                            using Base = typename T::_Impl::_Base;
+                            __data(x) = Base::_S_masked_load(__data(x), __data(k), buf.src + i);
+                            Base::_S_masked_store(__data(x), buf.dst + i, __data(k));
+                          }
+                        else
+                          {
+                            x.copy_from(buf.src + i, k, load_flags);
+                            x.copy_to(buf.dst + i, k, std::simd_flag_convert);
+                          }
+                      }
+                  else
+                    for (int i = 0; i < n; ++i)
+                      if (buf.cond[i] > TT())
+                        buf.dst[i] = buf.src[i];
+                  asm volatile("" ::: "memory");
+                })};
+      }
+  };
+
+int
+main()
+{
+  bench_all<float, Masked>();
+  bench_all<float, Masked, BitIteration>();
+  bench_all<float, Masked, Convert>();
+  bench_all<float, Masked, Convert, PageSafe>();
+  bench_all<float, Masked, Convert, BitIteration>();
+  bench_all<double, Masked>();
+  bench_all<double, Masked, BitIteration>();
+  bench_all<int, Masked>();
+  bench_all<int, Masked, BitIteration>();
+  bench_all<short, Masked>();
+  bench_all<short, Masked, PageSafe>();
+  bench_all<short, Masked, BitIteration>();
+}
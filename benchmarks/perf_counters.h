@@ -0,0 +1,270 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef BENCH_PERF_COUNTERS_H_
+#define BENCH_PERF_COUNTERS_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include <x86intrin.h>
+
+#if __has_include(<linux/perf_event.h>) and __has_include(<cpuid.h>)
+#include <cpuid.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BENCH_HAVE_PERF_EVENT 1
+#else
+#define BENCH_HAVE_PERF_EVENT 0
+#endif
+
+/* Hardware performance counters
+ * =============================
+ *
+ * The TSC counts at a fixed frequency, which is not the core clock under frequency scaling (hence
+ * benchmark-mode.sh). Where perf_event_open(2) grants access to the core cycle counter (Linux,
+ * perf_event_paranoid <= 2, and a PMU, i.e. not in most VMs), the benchmarks measure core cycles
+ * of user-space code instead, and report more counters in extra columns. Otherwise they use the
+ * TSC as before, without extra columns.
+ *
+ * The environment variable BENCH_COUNTERS selects the extra columns, as a comma-separated list of
+ *
+ *   instructions, uops, l1d-miss, llc-miss, branch-miss, port0, ..., port7, ports (all ports)
+ *
+ * The default is "instructions,uops,l1d-miss,llc-miss,branch-miss". BENCH_COUNTERS=none disables
+ * all counters, including the core cycle counter. uops is the number of retired uops (Intel and
+ * AMD); portN is the number of uops dispatched to port N (Intel, with the Skylake encoding). All
+ * counters are opened as one group with the cycle counter, so that they count the same code. A
+ * counter that is not supported or does not fit into the group is dropped.
+ */
+
+inline constexpr int perf_max_events = 12;
+
+// a measurement: cycles and events (in the order of perf_counters::name)
+// time_mean additionally fills in the mean and variance of the cycles over its retries; the
+// difference of two samples is treated as the difference of independent measurements
+struct perf_sample
+{
+  double cycles = 0;
+
+  std::array<double, perf_max_events> events = {};
+
+  double mean = 0;
+
+  double variance = 0;
+
+  int retries = 0;
+
+  friend perf_sample
+  operator-(perf_sample a, const perf_sample& b)
+  {
+    a.cycles -= b.cycles;
+    for (int i = 0; i < perf_max_events; ++i)
+      a.events[i] -= b.events[i];
+    a.mean -= b.mean;
+    a.variance += b.variance;
+    a.retries = std::min(a.retries, b.retries);
+    return a;
+  }
+
+  friend perf_sample
+  operator/(perf_sample a, double n)
+  {
+    a.cycles /= n;
+    for (double& x : a.events)
+      x /= n;
+    a.mean /= n;
+    a.variance /= n * n;
+    return a;
+  }
+};
+
+class perf_counters
+{
+  int leader = -1;
+
+  std::vector<int> fds;
+
+  std::vector<const char*> names;
+
+#if BENCH_HAVE_PERF_EVENT
+  struct event
+  {
+    const char* key;
+    const char* name;
+    std::uint32_t type;
+    std::uint64_t config;
+  };
+
+  static constexpr std::uint64_t
+  cache_miss(std::uint64_t cache)
+  {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  }
+
+  static int
+  open(std::uint32_t type, std::uint64_t config, int group)
+  {
+    perf_event_attr attr = {};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                         | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+  }
+
+  // whether the group is scheduled on the PMU (i.e. all its counters fit)
+  bool
+  scheduled() const
+  {
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    for (int i = 0; i < 100'000; ++i)
+      asm volatile("");
+    ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    std::array<std::uint64_t, 3 + perf_max_events + 1> buf;
+    return ::read(leader, buf.data(), sizeof(buf)) > 0 and buf[2] > 0;
+  }
+
+  void
+  add(const event& e)
+  {
+    if (fds.size() == perf_max_events)
+      return;
+    for (const char* name : names)
+      if (name == e.name)
+        return;
+    const int fd = open(e.type, e.config, leader);
+    if (fd < 0)
+      return;
+    if (scheduled())
+      {
+        fds.push_back(fd);
+        names.push_back(e.name);
+      }
+    else
+      ::close(fd);
+  }
+
+  perf_counters()
+  {
+    const char* env = std::getenv("BENCH_COUNTERS");
+    std::string_view list = env ? env : "instructions,uops,l1d-miss,llc-miss,branch-miss";
+    if (list == "none")
+      return;
+    leader = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (leader < 0)
+      return;
+
+    unsigned vendor[4] = {};
+    __get_cpuid(0, &vendor[3], &vendor[0], &vendor[2], &vendor[1]);
+    const bool intel = std::memcmp(vendor, "GenuineIntel", 12) == 0;
+    const bool amd = std::memcmp(vendor, "AuthenticAMD", 12) == 0;
+
+    std::vector<event> known = {
+      {"instructions", "instr", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {"l1d-miss", "L1D miss", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D)},
+      {"llc-miss", "LLC miss", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)},
+      {"branch-miss", "br miss", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+    if (intel)
+      {
+        // UOPS_RETIRED.RETIRE_SLOTS and UOPS_DISPATCHED_PORT.PORT_N
+        known.push_back({"uops", "uops", PERF_TYPE_RAW, 0x02c2});
+        static constexpr const char* ports[8]
+          = {"port0", "port1", "port2", "port3", "port4", "port5", "port6", "port7"};
+        for (int n = 0; n < 8; ++n)
+          known.push_back({ports[n], ports[n], PERF_TYPE_RAW, 0xa1 | (0x100u << n)});
+      }
+    else if (amd)
+      known.push_back({"uops", "uops", PERF_TYPE_RAW, 0xc1}); // Retired Uops
+
+    while (not list.empty())
+      {
+        const std::size_t comma = list.find(',');
+        const std::string_view key = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+        for (const event& e : known)
+          if (key == e.key or (key == "ports" and std::string_view(e.key).starts_with("port")))
+            add(e);
+      }
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  ~perf_counters()
+  {
+    for (int fd : fds)
+      ::close(fd);
+    if (leader >= 0)
+      ::close(leader);
+  }
+#else
+  perf_counters() = default;
+#endif
+
+public:
+  perf_counters(const perf_counters&) = delete;
+
+  static perf_counters&
+  get()
+  {
+    static perf_counters counters;
+    return counters;
+  }
+
+  /// Whether perf_sample::cycles are core cycles (otherwise TSC cycles).
+  bool
+  core_cycles() const
+  { return leader >= 0; }
+
+  /// The number of events in every perf_sample.
+  int
+  size() const
+  { return names.size(); }
+
+  /// The column name of the i-th event.
+  const char*
+  name(int i) const
+  { return names[i]; }
+
+  perf_sample
+  now() const
+  {
+    perf_sample r;
+#if BENCH_HAVE_PERF_EVENT
+    // nr, time_enabled, time_running, cycles, events...
+    std::array<std::uint64_t, 3 + 1 + perf_max_events> buf;
+    if (leader >= 0 and ::read(leader, buf.data(), sizeof(buf)) > 0)
+      {
+        // the counters are scaled up if the group was multiplexed with other perf users
+        const double scale = buf[2] > 0 ? double(buf[1]) / buf[2] : 1.;
+        r.cycles = buf[3] * scale;
+        for (std::size_t i = 0; i < fds.size(); ++i)
+          r.events[i] = buf[4 + i] * scale;
+        return r;
+      }
+#endif
+    unsigned int tmp = 0;
+    r.cycles = __rdtscp(&tmp);
+    return r;
+  }
+};
+
+// the samples of the time_mean, time_latency, and time_throughput calls of the current benchmark
+// run, in call order (see bench_lat_thr)
+inline std::vector<perf_sample> perf_samples;
+
+#endif  // BENCH_PERF_COUNTERS_H_
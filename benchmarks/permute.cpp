@@ -0,0 +1,205 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../permute.h"
+#include "../interleave.h"
+
+namespace perm = std::simd_permutations;
+
+struct Reverse
+{
+  static constexpr char name[] = "reverse";
+
+  static auto
+  apply(const auto& x)
+  { return std::simd_permute(x, perm::reverse); }
+};
+
+struct Rotate
+{
+  static constexpr char name[] = "rotate<1>";
+
+  static auto
+  apply(const auto& x)
+  { return std::simd_permute(x, perm::rotate<1>); }
+};
+
+struct Shift
+{
+  static constexpr char name[] = "shift<1>";
+
+  static auto
+  apply(const auto& x)
+  { return std::simd_permute(x, perm::shift<1>); }
+};
+
+struct DuplicateEven
+{
+  static constexpr char name[] = "duplicate_even";
+
+  static auto
+  apply(const auto& x)
+  { return std::simd_permute(x, perm::duplicate_even); }
+};
+
+struct SwapNeighbors
+{
+  static constexpr char name[] = "swap_neighbors";
+
+  static auto
+  apply(const auto& x)
+  { return std::simd_permute(x, perm::swap_neighbors<1>); }
+};
+
+struct Broadcast
+{
+  static constexpr char name[] = "broadcast_last";
+
+  static auto
+  apply(const auto& x)
+  { return std::simd_permute(x, perm::broadcast_last); }
+};
+
+struct Runtime
+{ static constexpr char name[] = "runtime index"; };
+
+struct Interleave
+{ static constexpr char name[] = "interleave"; };
+
+// A permutation with compile-time indexes: `simd_permute(x, Op)` (the shuffle instructions the
+// index pattern compiles to). Only up to the native width: beyond that, most of the permutation is
+// a renaming of registers, which the latency measurement cannot resolve.
+template <class Op>
+  struct Benchmark<Op>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::is_simd_v<T> and size_v<T> >= 2 and size_v<T> <= std::simd_size_v<value_type_t<T>>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        T one = T() + TT(1);
+        fake_modify(one);
+
+        // the fake_modify in both lambdas cancels out, leaving the cost of the permutation
+        auto process_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = Op::apply(inout) + one;
+        };
+
+        auto fake_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout + one;
+        };
+
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+// The reversal with runtime indexes: `simd_permute(x, idx)` (a variable shuffle)
+template <>
+  struct Benchmark<Runtime>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = std::is_simd_v<T> and size_v<T> >= 2;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        using II = std::__detail::__make_signed_int_t<TT>;
+        using I = std::rebind_simd_t<II, T>;
+        T one = T() + TT(1);
+        I idx([](int i) { return II(T::size() - 1 - i); });
+        fake_modify(one, idx);
+
+        auto process_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = std::simd_permute(inout, idx) + one;
+        };
+
+        auto fake_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout + one;
+        };
+
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+// Interleaving of two simds into two simds: `interleave(x, y)`, followed by one addition of the
+// two results (the reference adds x and y)
+template <>
+  struct Benchmark<Interleave>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = std::is_simd_v<T> and size_v<T> >= 2;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        T one = T() + TT(1);
+        fake_modify(one);
+
+        auto process_one = [&](T& inout) {
+          fake_modify(inout);
+          const auto [lo, hi] = std::interleave(inout, one);
+          inout = lo + hi;
+        };
+
+        auto fake_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout + one;
+        };
+
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+template <typename T>
+  void
+  bench_permutes()
+  {
+    bench_all<T, Reverse>();
+    bench_all<T, Rotate>();
+    bench_all<T, Shift>();
+    bench_all<T, DuplicateEven>();
+    bench_all<T, SwapNeighbors>();
+    bench_all<T, Broadcast>();
+    bench_all<T, Runtime>();
+    bench_all<T, Interleave>();
+  }
+
+int
+main()
+{
+  bench_permutes<float>();
+  bench_permutes<double>();
+  bench_permutes<int>();
+  bench_permutes<short>();
+  bench_permutes<signed char>();
+}
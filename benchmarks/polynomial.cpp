@@ -0,0 +1,177 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_polynomial.h"
+
+struct Estrin
+{ static constexpr char name[] = "estrin"; };
+
+struct Lut
+{ static constexpr char name[] = "lut_interpolate"; };
+
+namespace my
+{
+  // 1/k!: the degree 7 Taylor polynomial of exp
+  inline constexpr double coeff[] = {1., 1., 1. / 2, 1. / 6, 1. / 24, 1. / 120, 1. / 720, 1. / 5040};
+
+  inline constexpr double table[] = {0., .5, .75, 1., .75, .25, -.5, -1.};
+
+  // scalar Horner loop over a coefficient array
+  template <std::floating_point T>
+    T
+    horner(T x)
+    {
+      T r = T(coeff[7]);
+      for (int i = 6; i >= 0; --i)
+        r = r * x + T(coeff[i]);
+      return r;
+    }
+
+  template <typename V, typename T = typename V::value_type>
+    requires std::is_simd_v<V>
+    V
+    horner(V x)
+    {
+      return std::simd_horner(x, vir::cw<T(coeff[0])>, vir::cw<T(coeff[1])>, vir::cw<T(coeff[2])>,
+                              vir::cw<T(coeff[3])>, vir::cw<T(coeff[4])>, vir::cw<T(coeff[5])>,
+                              vir::cw<T(coeff[6])>, vir::cw<T(coeff[7])>);
+    }
+
+  template <typename V, typename T = typename V::value_type>
+    requires std::is_simd_v<V>
+    V
+    estrin(V x)
+    {
+      return std::simd_estrin(x, vir::cw<T(coeff[0])>, vir::cw<T(coeff[1])>, vir::cw<T(coeff[2])>,
+                              vir::cw<T(coeff[3])>, vir::cw<T(coeff[4])>, vir::cw<T(coeff[5])>,
+                              vir::cw<T(coeff[6])>, vir::cw<T(coeff[7])>);
+    }
+
+  // scalar table lookup and linear interpolation
+  template <std::floating_point T>
+    T
+    lut_interpolate(const std::array<T, 8>& tab, T x)
+    {
+      x = std::min(std::max(x, T()), T(7));
+      const int i = std::min(int(x), 6);
+      return tab[i] + (x - T(i)) * (tab[i + 1] - tab[i]);
+    }
+
+  template <typename V, typename T = typename V::value_type>
+    requires std::is_simd_v<V>
+    V
+    lut_interpolate(const std::simd<T, 8>& tab, V x)
+    { return std::simd_lut_interpolate(tab, x); }
+}
+
+template <typename T>
+  struct PolynomialBenchmark
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <class V>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<V>;
+        V one = V() + TT(1);
+        fake_modify(one);
+
+        auto process_one = [&](V& inout) {
+          V x = inout + one;
+          fake_modify(x);
+          x = T::eval(x);
+          inout = x - one;
+        };
+
+        auto fake_one = [&](V& inout) {
+          V x = inout + one;
+          fake_modify(x);
+          inout = x - one;
+        };
+
+        // the fake_modify in both lambdas cancels out, leaving the cost of the evaluation
+        V a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+// Horner's scheme: scalar loop vs. simd_horner
+template <>
+  struct Benchmark<> : PolynomialBenchmark<Benchmark<>>
+  {
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <typename V>
+      static V
+      eval(V x)
+      { return my::horner(x); }
+  };
+
+// Estrin's scheme: scalar Horner loop vs. simd_estrin
+template <>
+  struct Benchmark<Estrin> : PolynomialBenchmark<Benchmark<Estrin>>
+  {
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <typename V>
+      static V
+      eval(V x)
+      {
+        if constexpr (std::is_simd_v<V>)
+          return my::estrin(x);
+        else
+          return my::horner(x);
+      }
+  };
+
+// 8-entry table: scalar lookup vs. simd_lut_interpolate (permutes)
+template <>
+  struct Benchmark<Lut> : PolynomialBenchmark<Benchmark<Lut>>
+  {
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <typename V>
+      static V
+      eval(V x)
+      {
+        using TT = value_type_t<V>;
+        if constexpr (std::is_simd_v<V>)
+          {
+            constexpr std::simd<TT, 8> tab([](int i) { return TT(my::table[i]); });
+            return my::lut_interpolate(tab, x);
+          }
+        else
+          {
+            static constexpr std::array<TT, 8> tab = [] {
+              std::array<TT, 8> r;
+              for (int i = 0; i < 8; ++i)
+                r[i] = TT(my::table[i]);
+              return r;
+            }();
+            return my::lut_interpolate(tab, x);
+          }
+      }
+  };
+
+int
+main()
+{
+  bench_all<float>();
+  bench_all<float, Estrin>();
+  bench_all<float, Lut>();
+  bench_all<double>();
+  bench_all<double, Estrin>();
+  bench_all<double, Lut>();
+}
@@ -0,0 +1,166 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_loop.h"
+
+#include <vector>
+
+/* Calibration of the loop-level prefetch distance
+ * ===============================================
+ *
+ * Sweeps the distance of __simd_flag_prefetch_stream<Distance> for streaming workloads over arrays
+ * that do not fit into the last level cache and reports the fastest distance for the native simd
+ * width. Use the result for _GLIBCXX_SIMD_PREFETCH_DISTANCE.
+ */
+
+struct Transform
+{ static constexpr char name[] = "x * a + b"; };
+
+struct Reduce
+{ static constexpr char name[] = "reduce"; };
+
+// the digit of x at place, or a space for leading zeros
+constexpr char
+digit(std::size_t x, std::size_t place)
+{ return x < place and place > 1 ? ' ' : char('0' + x / place % 10); }
+
+template <std::size_t D>
+  struct Ahead
+  {
+    static constexpr char name[] = {digit(D, 10000), digit(D, 1000), digit(D, 100), digit(D, 10),
+                                    digit(D, 1), ' ', 'B', '\0'};
+  };
+
+// number of elements (64 MiB of float)
+constexpr int n = 16 << 20;
+
+// cycles per step of size_v<T> elements
+template <typename T>
+  double
+  per_step(auto&& fun)
+  { return time_mean<4>(fun) * size_v<T> / n; }
+
+template <typename TT>
+  TT*
+  buffer()
+  {
+    static std::vector<TT> mem = [] {
+      std::vector<TT> r(n);
+      for (int i = 0; i < n; ++i)
+        r[i] = TT(i % 7);
+      return r;
+    }();
+    return mem.data();
+  }
+
+template <class... Flags>
+  constexpr auto prefetch_flags = std::simd_flag_default;
+
+template <std::size_t D>
+  constexpr auto prefetch_flags<Ahead<D>> = std::__simd_flag_prefetch_stream<D>;
+
+template <class... Flags>
+  struct Benchmark<Transform, Flags...>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        TT* const p = buffer<TT>();
+        TT a = TT(.99), b = TT(.01);
+        fake_modify(a, b);
+        return {per_step<T>([&] {
+                  if constexpr (std::is_simd_v<T>)
+                    std::simd_for_each_aligned<T>(std::span<TT>(p, n), [&](auto chunk) {
+                      chunk.store(chunk.load() * a + b);
+                    }, prefetch_flags<Flags...>);
+                  else
+                    for (int i = 0; i < n; ++i)
+                      p[i] = p[i] * a + b;
+                  asm volatile("" ::: "memory");
+                })};
+      }
+  };
+
+template <class... Flags>
+  struct Benchmark<Reduce, Flags...>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        const TT* const p = buffer<TT>();
+        return {per_step<T>([&] {
+                  T sum = T();
+                  if constexpr (std::is_simd_v<T>)
+                    std::simd_for_each_aligned<T>(std::span<const TT>(p, n), [&](auto chunk) {
+                      sum += chunk.load();
+                    }, prefetch_flags<Flags...>);
+                  else
+                    for (int i = 0; i < n; ++i)
+                      sum += p[i];
+                  fake_read(sum);
+                })};
+      }
+  };
+
+// prints the distance with the smallest time for simd<T> (0: no prefetching is fastest)
+template <class Workload, typename T, std::size_t... Ds>
+  void
+  report_best()
+  {
+    using V = std::simd<T>;
+    std::size_t best = 0;
+    double best_time = Benchmark<Workload>::template run<V>()[0];
+    ([&] {
+      const double t = Benchmark<Workload, Ahead<Ds>>::template run<V>()[0];
+      if (t < best_time)
+        {
+          best_time = t;
+          best = Ds;
+        }
+    }(), ...);
+    std::cout << "best prefetch distance for " << Workload::name << " with simd<"
+              << (std::same_as<T, float> ? "float" : "double") << ", " << V::size() << ">: "
+              << best << " B (" << std::setprecision(3) << best_time << " cycles/step)\n";
+  }
+
+template <class Workload, typename T, std::size_t... Ds>
+  void
+  sweep()
+  {
+    bench_all<T, Workload>();
+    (bench_all<T, Workload, Ahead<Ds>>(), ...);
+  }
+
+int
+main()
+{
+  sweep<Transform, float, 256, 512, 1024, 2048, 4096, 8192>();
+  sweep<Reduce, float, 256, 512, 1024, 2048, 4096, 8192>();
+  sweep<Transform, double, 256, 512, 1024, 2048, 4096, 8192>();
+  sweep<Reduce, double, 256, 512, 1024, 2048, 4096, 8192>();
+  report_best<Transform, float, 256, 512, 1024, 2048, 4096, 8192>();
+  report_best<Reduce, float, 256, 512, 1024, 2048, 4096, 8192>();
+  report_best<Transform, double, 256, 512, 1024, 2048, 4096, 8192>();
+  report_best<Reduce, double, 256, 512, 1024, 2048, 4096, 8192>();
+}
@@ -17,6 +17,8 @@ $(cd "$dir"; echo *.cpp|sed 's/\.cpp\>//g')
 $archlist
 
 The arguments can be given in any order.
+
+Every run is recorded as CSV in ${BENCH_RESULTS:-$dir/results}; compare two runs with compare.sh.
 EOF
 }
 
@@ -87,16 +89,38 @@ fi
 
 CCACHE=`which ccache 2>/dev/null` || CCACHE=
 
-mkdir -p "$dir/bin"
+# With access to the core cycle counter (see perf_counters.h) the benchmarks neither need fixed
+# clocks nor root.
+if [[ -d /sys/bus/event_source/devices/cpu && \
+      $(cat /proc/sys/kernel/perf_event_paranoid 2>/dev/null || echo 3) -le 2 ]]; then
+  perf_event=true
+else
+  perf_event=false
+fi
+
+# Every run is recorded in results/<name>-<arch>-<date>.csv (see bench_output.h), for compare.sh.
+results="${BENCH_RESULTS:-$dir/results}"
+stamp=$(date +%Y%m%d-%H%M%S)
+export BENCH_NAME="$name"
+
+mkdir -p "$dir/bin" "$results"
 for arch in ${arch_list}; do
   CXXFLAGS="-g0 $opt $std -march=$arch -lmvec"
+  export BENCH_ARCH="$arch"
+  export BENCH_OUTPUT="$results/$name-$arch-$stamp.csv"
 
   echo $CCACHE $CXX $CXXFLAGS "${flags[@]}" "$dir/${name}.cpp" -o "$dir/bin/$name-$arch"
   $CCACHE $CXX $CXXFLAGS "${flags[@]}" "$dir/${name}.cpp" -o "$dir/bin/$name-$arch" && \
     echo "-march=$arch $flags:" && \
-    "$dir/benchmark-mode.sh" on && \
-    sudo chrt --fifo 50 "$dir/bin/$name-$arch"
-  "$dir/benchmark-mode.sh" off
+    if $perf_event; then
+      "$dir/bin/$name-$arch"
+    else
+      "$dir/benchmark-mode.sh" on && \
+      sudo --preserve-env=BENCH_NAME,BENCH_ARCH,BENCH_OUTPUT,BENCH_COUNTERS \
+        chrt --fifo 50 "$dir/bin/$name-$arch"
+      "$dir/benchmark-mode.sh" off
+    fi
+  test -f "$BENCH_OUTPUT" && echo "recorded in $BENCH_OUTPUT"
 done
 
 # vim: tw=0 si
@@ -0,0 +1,121 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+
+struct ShiftLeft
+{
+  static constexpr char name[] = "x << n";
+
+  static constexpr bool per_element = false;
+
+  template <typename T, typename U>
+    static T
+    apply(const T& x, const U& n)
+    { return x << n; }
+};
+
+struct ShiftRight
+{
+  static constexpr char name[] = "x >> n";
+
+  static constexpr bool per_element = false;
+
+  template <typename T, typename U>
+    static T
+    apply(const T& x, const U& n)
+    { return x >> n; }
+};
+
+struct ShiftLeftV
+{
+  static constexpr char name[] = "x << y";
+
+  static constexpr bool per_element = true;
+
+  template <typename T, typename U>
+    static T
+    apply(const T& x, const U& n)
+    { return x << n; }
+};
+
+struct ShiftRightV
+{
+  static constexpr char name[] = "x >> y";
+
+  static constexpr bool per_element = true;
+
+  template <typename T, typename U>
+    static T
+    apply(const T& x, const U& n)
+    { return x >> n; }
+};
+
+// Shifts by a runtime-invariant int (`x << n`) or by a vector of shift counts, one per element
+// (`x << y`)
+template <class Op>
+  struct Benchmark<Op>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = std::integral<value_type_t<T>>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        T one = T() + TT(1);
+        auto count = [] {
+          if constexpr (not Op::per_element)
+            return 1;
+          else if constexpr (std::is_simd_v<T>)
+            return T([](int i) { return TT(i % 4); });
+          else
+            return T() + TT(1);
+        }();
+        fake_modify(one, count);
+
+        // the fake_modify in both lambdas cancels out, leaving the cost of the shift
+        auto process_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = Op::apply(inout, count) + one;
+        };
+
+        auto fake_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout + one;
+        };
+
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+template <typename T>
+  void
+  bench_shifts()
+  {
+    bench_all<T, ShiftLeft>();
+    bench_all<T, ShiftRight>();
+    bench_all<T, ShiftLeftV>();
+    bench_all<T, ShiftRightV>();
+  }
+
+int
+main()
+{
+  bench_shifts<signed char>();
+  bench_shifts<unsigned char>();
+  bench_shifts<signed short>();
+  bench_shifts<unsigned short>();
+  bench_shifts<signed int>();
+  bench_shifts<unsigned int>();
+  bench_shifts<signed long>();
+  bench_shifts<unsigned long>();
+}
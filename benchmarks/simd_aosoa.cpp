@@ -0,0 +1,140 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_aosoa.h"
+
+#include <array>
+#include <vector>
+
+struct AoS
+{ static constexpr char name[] = "AoS"; };
+
+struct SoA
+{ static constexpr char name[] = "simd_vector"; };
+
+struct AoSoA
+{ static constexpr char name[] = "simd_aosoa"; };
+
+struct M2
+{
+  static constexpr char name[] = " 2 members";
+  static constexpr std::size_t value = 2;
+};
+
+struct M8
+{
+  static constexpr char name[] = " 8 members";
+  static constexpr std::size_t value = 8;
+};
+
+struct M32
+{
+  static constexpr char name[] = "32 members";
+  static constexpr std::size_t value = 32;
+};
+
+// number of elements per call: 4 MiB of floats for 32 members
+constexpr int n = 32768;
+
+// cycles per step of size_v<T> elements
+template <typename T>
+  double
+  per_step(auto&& fun)
+  { return time_mean<50>(fun) * size_v<T> / n; }
+
+// m[0] += (m[1] + m[2] + ... + m[M-1]) * dt, i.e. a kernel that reads every member
+template <typename V, std::size_t... Is>
+  V
+  kernel(const std::array<V, sizeof...(Is) + 1>& m, typename V::value_type dt,
+         std::index_sequence<Is...>)
+  { return m[0] + (m[Is + 1] + ...) * dt; }
+
+template <class Layout, class M>
+  struct Benchmark<Layout, M>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        constexpr int N = size_v<T>;
+        using V = std::simd<TT, N>;
+        using S = std::array<TT, M::value>;
+        using Rest = std::make_index_sequence<M::value - 1>;
+        auto make = [](int i) {
+          S s;
+          for (std::size_t j = 0; j < M::value; ++j)
+            s[j] = TT(i + j);
+          return s;
+        };
+        TT dt = TT(.01);
+        fake_modify(dt);
+
+        if constexpr (std::same_as<Layout, AoS>)
+          {
+            // simds are gathered from and scattered to the array of structs
+            std::vector<S> aos(n);
+            for (int i = 0; i < n; ++i)
+              aos[i] = make(i);
+            return {per_step<T>([&] {
+                      for (int i = 0; i < n; i += N)
+                        {
+                          const V x = [&]<std::size_t... Js>(std::index_sequence<Js...>) {
+                            return kernel(std::array<V, M::value>{
+                                            V([&](int k) { return aos[i + k][Js]; })...},
+                                          dt, Rest());
+                          }(std::make_index_sequence<M::value>());
+                          for (int k = 0; k < N; ++k)
+                            aos[i + k][0] = x[k];
+                        }
+                      asm volatile("" ::: "memory");
+                    })};
+          }
+        else
+          {
+            // one aligned load per member and chunk, one aligned store
+            std::conditional_t<std::same_as<Layout, SoA>, std::simd_vector<S, N>,
+                               std::simd_aosoa<S, N>> c;
+            for (int i = 0; i < n; ++i)
+              c.push_back(make(i));
+            return {per_step<T>([&] {
+                      for (auto chunk : c.chunks())
+                        {
+                          const V x = [&]<std::size_t... Js>(std::index_sequence<Js...>) {
+                            return kernel(std::array<V, M::value>{chunk.template get<Js>()...},
+                                          dt, Rest());
+                          }(std::make_index_sequence<M::value>());
+                          chunk.template set<0>(x);
+                        }
+                      asm volatile("" ::: "memory");
+                    })};
+          }
+      }
+  };
+
+int
+main()
+{
+  bench_all<float, AoS, M2>();
+  bench_all<float, SoA, M2>();
+  bench_all<float, AoSoA, M2>();
+  bench_all<float, AoS, M8>();
+  bench_all<float, SoA, M8>();
+  bench_all<float, AoSoA, M8>();
+  bench_all<float, AoS, M32>();
+  bench_all<float, SoA, M32>();
+  bench_all<float, AoSoA, M32>();
+  bench_all<double, AoS, M8>();
+  bench_all<double, SoA, M8>();
+  bench_all<double, AoSoA, M8>();
+}
@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_arena.h"
+
+#include <memory>
+
+struct Arena
+{ static constexpr char name[] = "simd_arena"; };
+
+// scratch arrays per batch and their number of elements (e.g. the result of a simd_split into 4)
+constexpr int allocations = 16;
+
+constexpr int elements = 4;
+
+// makes the compiler assume that p is read and written, so that the allocation is not elided
+template <typename T>
+  [[gnu::always_inline]] inline void
+  escape(T* p)
+  { asm volatile("" :: "r"(p) : "memory"); }
+
+// operator new/delete for every scratch array
+template <>
+  struct Benchmark<>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = not vec_builtin<T>;
+
+    template <class T>
+      static Times<1>
+      run()
+      {
+        return {time_mean<20'000>([] {
+                  std::unique_ptr<T[]> p[allocations];
+                  for (auto& x : p)
+                    {
+                      x.reset(new T[elements]);
+                      escape(x.get());
+                    }
+                }) / allocations};
+      }
+  };
+
+// the same with simd_arena::allocate and one reset per batch
+template <>
+  struct Benchmark<Arena>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = not vec_builtin<T>;
+
+    template <class T>
+      static Times<1>
+      run()
+      {
+        std::simd_arena& arena = std::this_thread_simd_arena();
+        return {time_mean<20'000>([&] {
+                  for (int i = 0; i < allocations; ++i)
+                    escape(arena.template allocate<T>(elements).data());
+                  arena.reset();
+                }) / allocations};
+      }
+  };
+
+int
+main()
+{
+  bench_all<float>();
+  bench_all<float, Arena>();
+  bench_all<double>();
+  bench_all<double, Arena>();
+}
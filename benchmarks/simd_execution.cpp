@@ -0,0 +1,116 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_execution.h"
+
+#include <vector>
+
+// The std algorithms with execution::unseq (relying on the auto-vectorizer) versus the same calls
+// in simd_execution (invoking the operations with simd arguments). The operations use a branch
+// (scalar) or simd_select (simd). Only the scalar row is meaningful: simd_execution chooses the
+// simd width from the value type.
+
+struct Clamp
+{ static constexpr char name[] = "transform(clamp)"; };
+
+struct Dot
+{ static constexpr char name[] = "transform_reduce(dot)"; };
+
+struct StdUnseq
+{ static constexpr char name[] = "std, unseq"; };
+
+struct SimdUnseq
+{ static constexpr char name[] = "simd_execution, unseq"; };
+
+struct SimdParUnseq
+{ static constexpr char name[] = "simd_execution, par_unseq"; };
+
+// number of elements (4 MiB of float, L3 resident)
+constexpr std::size_t n = 1 << 20;
+
+template <typename TT>
+  struct Arrays
+  {
+    std::vector<TT> a = [] {
+      std::vector<TT> r(n);
+      for (std::size_t i = 0; i < n; ++i)
+        r[i] = TT(i % 100);
+      return r;
+    }();
+
+    std::vector<TT> b = std::vector<TT>(n, TT(.5));
+
+    std::vector<TT> out = std::vector<TT>(n);
+  };
+
+template <class Algo, class Impl>
+  struct Benchmark<Algo, Impl>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T> and not std::is_simd_v<T>;
+
+    template <class T>
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        Arrays<TT> arr;
+        auto call = [&](auto policy, auto clamp) {
+          if constexpr (std::same_as<Algo, Clamp>)
+            {
+              if constexpr (std::same_as<Impl, StdUnseq>)
+                std::transform(policy, arr.a.begin(), arr.a.end(), arr.out.begin(), clamp);
+              else
+                std::simd_execution::transform(policy, arr.a.begin(), arr.a.end(),
+                                               arr.out.begin(), clamp);
+              asm volatile("" ::: "memory");
+            }
+          else
+            {
+              TT r;
+              if constexpr (std::same_as<Impl, StdUnseq>)
+                r = std::transform_reduce(policy, arr.a.begin(), arr.a.end(), arr.b.begin(),
+                                          TT());
+              else
+                r = std::simd_execution::transform_reduce(policy, arr.a.begin(), arr.a.end(),
+                                                          arr.b.begin(), TT());
+              fake_read(r);
+            }
+        };
+        return {time_mean<8>([&] {
+                  if constexpr (std::same_as<Impl, StdUnseq>)
+                    call(std::execution::unseq, [](TT x) { return x > TT(50) ? TT(50) : x; });
+                  else if constexpr (std::same_as<Impl, SimdUnseq>)
+                    call(std::execution::unseq, [](auto x) {
+                      return std::simd_select(x > TT(50), decltype(x)(TT(50)), x);
+                    });
+                  else
+                    call(std::execution::par_unseq, [](auto x) {
+                      return std::simd_select(x > TT(50), decltype(x)(TT(50)), x);
+                    });
+                }) / n};
+      }
+  };
+
+int
+main()
+{
+  bench_all<float, Clamp, StdUnseq>();
+  bench_all<float, Clamp, SimdUnseq>();
+  bench_all<float, Clamp, SimdParUnseq>();
+  bench_all<float, Dot, StdUnseq>();
+  bench_all<float, Dot, SimdUnseq>();
+  bench_all<float, Dot, SimdParUnseq>();
+  bench_all<double, Clamp, StdUnseq>();
+  bench_all<double, Clamp, SimdUnseq>();
+  bench_all<double, Clamp, SimdParUnseq>();
+  bench_all<double, Dot, StdUnseq>();
+  bench_all<double, Dot, SimdUnseq>();
+  bench_all<double, Dot, SimdParUnseq>();
+}
@@ -0,0 +1,105 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_executor.h"
+
+#include <thread>
+#include <vector>
+
+/* Strong scaling of simd_executor
+ * ===============================
+ *
+ * Runs a fixed problem (16 Mi elements) with 1, 2, 4, ... threads up to the number of hardware
+ * threads and reports the time per simd step of the whole range, the speedup over one thread, and
+ * the parallel efficiency (speedup / threads). Both workloads are memory bound; expect the speedup to level off
+ * when the memory bandwidth is saturated rather than at the number of cores.
+ */
+
+struct Transform
+{ static constexpr char name[] = "x * a + b"; };
+
+struct Reduce
+{ static constexpr char name[] = "reduce"; };
+
+// number of elements (64 MiB of float)
+constexpr std::size_t n = 16 << 20;
+
+template <typename TT>
+  std::span<TT>
+  buffer()
+  {
+    static std::vector<TT> mem = [] {
+      std::vector<TT> r(n);
+      for (std::size_t i = 0; i < n; ++i)
+        r[i] = TT(i % 7);
+      return r;
+    }();
+    return mem;
+  }
+
+// cycles per step of V::size() elements
+template <class Workload, typename V>
+  double
+  run(std::simd_executor& exec)
+  {
+    using TT = typename V::value_type;
+    const std::span<TT> data = buffer<TT>();
+    TT a = TT(.99), b = TT(.01);
+    fake_modify(a, b);
+    return time_mean<4>([&] {
+             if constexpr (std::same_as<Workload, Transform>)
+               {
+                 std::simd_for_each<V>(exec, data, [&](auto chunk) {
+                   if constexpr (decltype(chunk)::is_partial)
+                     (chunk.load() * a + b).copy_to(data.data() + chunk.index(), chunk.mask());
+                   else
+                     chunk.store(chunk.load() * a + b);
+                 });
+                 asm volatile("" ::: "memory");
+               }
+             else
+               {
+                 TT sum = std::simd_reduce<V>(exec, std::span<const TT>(data));
+                 fake_read(sum);
+               }
+           }) * V::size() / n;
+  }
+
+template <class Workload, typename T>
+  void
+  strong_scaling()
+  {
+    using V = std::simd<T>;
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << Workload::name << " with simd<" << (std::same_as<T, float> ? "float" : "double")
+              << ", " << V::size() << ">, " << (n * sizeof(T) >> 20) << " MiB\n"
+              << std::setw(8) << "threads" << std::setw(16) << "cycles/step" << std::setw(10)
+              << "speedup" << std::setw(12) << "efficiency" << '\n';
+    double t1 = 0;
+    for (unsigned threads = 1; threads <= max_threads;
+         threads = threads < max_threads and threads * 2 > max_threads ? max_threads : threads * 2)
+      {
+        std::simd_executor exec(threads);
+        const double t = run<Workload, V>(exec);
+        if (threads == 1)
+          t1 = t;
+        std::cout << std::setw(8) << threads << std::setw(16) << std::setprecision(4) << t
+                  << std::setw(10) << std::setprecision(3) << t1 / t << std::setw(11)
+                  << std::setprecision(3) << 100 * t1 / t / threads << "%\n";
+        if (threads == max_threads)
+          break;
+      }
+    std::cout << '\n';
+  }
+
+int
+main()
+{
+  strong_scaling<Reduce, float>();
+  strong_scaling<Transform, float>();
+  strong_scaling<Reduce, double>();
+  strong_scaling<Transform, double>();
+}
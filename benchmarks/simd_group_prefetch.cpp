@@ -0,0 +1,167 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_allocator.h"
+#include "../simd_group_prefetch.h"
+
+#include <chrono>
+#include <vector>
+
+/* Hash table lookups with group prefetching
+ * =========================================
+ *
+ * An open-addressing hash index (linear probing) of 2^27 uint32_t key/row pairs (1 GiB) at 50%
+ * load, pointing into a table of 2^26 rows (256 MiB), queried with 2^22 random keys that are all
+ * present. Thus every lookup takes two dependent cache misses. The table lists the nanoseconds per
+ * lookup:
+ *
+ * - scalar: one lookup after the other.
+ * - K = ...: simd_group_prefetch<K> with K lookups in flight; the values are summed up as
+ *   simd<uint32_t, K>.
+ */
+
+struct Entry
+{
+  std::uint32_t key = 0; // 0: empty
+  std::uint32_t row = 0;
+};
+
+constexpr int table_bits = 27;
+
+constexpr std::uint32_t table_mask = (std::uint32_t(1) << table_bits) - 1;
+
+constexpr std::size_t inserts = std::size_t(1) << (table_bits - 1);
+
+constexpr std::size_t lookups = std::size_t(1) << 22;
+
+// a bijection on uint32_t with fmix(0) == 0 (the MurmurHash3 finalizer)
+constexpr std::uint32_t
+fmix(std::uint32_t x)
+{
+  x ^= x >> 16;
+  x *= 0x85ebca6bu;
+  x ^= x >> 13;
+  x *= 0xc2b2ae35u;
+  x ^= x >> 16;
+  return x;
+}
+
+// the i-th key in the table (unique and non-zero)
+constexpr std::uint32_t
+key(std::size_t i)
+{ return fmix(std::uint32_t(i + 1)); }
+
+// the id of the i-th lookup: a random one of the inserted keys
+constexpr std::size_t
+lookup_key_index(std::size_t i)
+{ return fmix(std::uint32_t(i) ^ 0x5bd1e995u) % inserts; }
+
+constexpr std::uint32_t
+home_slot(std::uint32_t k)
+{ return (k * 0x9e3779b1u) >> (32 - table_bits); }
+
+// the payload, on huge pages if available (simd_allocator)
+const std::simd_buffer<std::uint32_t> rows = [] {
+  std::simd_buffer<std::uint32_t> r(inserts);
+  for (std::size_t i = 0; i < inserts; ++i)
+    r[i] = std::uint32_t(i % 1000);
+  return r;
+}();
+
+// the index
+const std::vector<Entry, std::simd_allocator<Entry, std::simd<std::uint32_t>>> table = [] {
+  std::vector<Entry, std::simd_allocator<Entry, std::simd<std::uint32_t>>> t(table_mask + 1);
+  for (std::size_t i = 0; i < inserts; ++i)
+    {
+      const std::uint32_t k = key(i);
+      std::uint32_t slot = home_slot(k);
+      while (t[slot].key != 0)
+        slot = (slot + 1) & table_mask;
+      // scatter the rows, so that the index order says nothing about the row order
+      t[slot] = {k, std::uint32_t(fmix(std::uint32_t(i)) % inserts)};
+    }
+  return t;
+}();
+
+std::uint32_t
+find(std::uint32_t k)
+{
+  for (std::uint32_t slot = home_slot(k);; slot = (slot + 1) & table_mask)
+    if (table[slot].key == k)
+      return rows[table[slot].row];
+    else if (table[slot].key == 0)
+      return 0;
+}
+
+std::simd_prefetch_task<std::uint32_t>
+find_interleaved(std::size_t i)
+{
+  const std::uint32_t k = key(lookup_key_index(i));
+  std::uint32_t slot = home_slot(k);
+  co_await std::simd_prefetch(&table[slot]);
+  for (;; slot = (slot + 1) & table_mask)
+    {
+      // prefetch the next cache line before crossing into it
+      if (slot % (std::__detail::__cache_line_size / sizeof(Entry)) == 0)
+        co_await std::simd_prefetch(&table[slot]);
+      if (table[slot].key == k)
+        {
+          const std::uint32_t row = table[slot].row;
+          co_await std::simd_prefetch(&rows[row]);
+          co_return rows[row];
+        }
+      else if (table[slot].key == 0)
+        co_return 0;
+    }
+}
+
+template <typename F>
+  double
+  ns_per_lookup(F&& f)
+  {
+    double best = 1e99;
+    for (int i = 0; i < 3; ++i)
+      {
+        const auto t0 = std::chrono::steady_clock::now();
+        f();
+        const std::chrono::duration<double, std::nano> dt = std::chrono::steady_clock::now() - t0;
+        best = std::min(best, dt.count() / lookups);
+      }
+    return best;
+  }
+
+template <int K>
+  void
+  print_interleaved()
+  {
+    std::cout << std::setw(8) << K << std::setw(16) << ns_per_lookup([] {
+      std::simd<std::uint32_t, K> sum = {};
+      std::simd_group_prefetch<K>(lookups, find_interleaved,
+                                  [&](const auto& values, const auto&, const auto&) {
+                                    sum += values;
+                                  });
+      fake_read(sum);
+    }) << std::endl;
+  }
+
+int
+main()
+{
+  std::cout << "hash table of " << (table.size() * sizeof(Entry) >> 20) << " MiB, "
+            << lookups << " lookups\n"
+            << std::setw(8) << "K" << std::setw(16) << "[ns/lookup]" << '\n'
+            << std::setprecision(1) << std::fixed;
+  std::cout << std::setw(8) << "scalar" << std::setw(16) << ns_per_lookup([] {
+    std::uint32_t sum = 0;
+    for (std::size_t i = 0; i < lookups; ++i)
+      sum += find(key(lookup_key_index(i)));
+    fake_read(sum);
+  }) << std::endl;
+  print_interleaved<4>();
+  print_interleaved<8>();
+  print_interleaved<16>();
+  print_interleaved<32>();
+}
@@ -0,0 +1,166 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_loop.h"
+
+struct Aligned
+{ static constexpr char name[] = "simd_for_each_aligned"; };
+
+struct Short
+{ static constexpr char name[] = "odd lengths"; };
+
+struct PageSafe
+{ static constexpr char name[] = "page safe"; };
+
+// number of elements per call (L1 resident, where split loads/stores hurt the most)
+constexpr int n = 2048;
+
+// cycles per step of size_v<T> elements
+template <typename T>
+  double
+  per_step(auto&& fun)
+  { return time_mean<2000>(fun) * size_v<T> / n; }
+
+// the buffer starts one element past a 64-byte boundary
+template <typename TT>
+  struct Buffer
+  {
+    alignas(64) TT mem[n + 64 / sizeof(TT)];
+
+    Buffer()
+    {
+      for (int i = 0; i < n; ++i)
+        data()[i] = TT(i % 7);
+    }
+
+    TT*
+    data()
+    { return mem + 1; }
+  };
+
+// x = x * a + b with element_aligned loads and a scalar epilogue, as in a simd_index loop
+template <>
+  struct Benchmark<>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        Buffer<TT> buf;
+        TT a = TT(.99), b = TT(.01);
+        fake_modify(a, b);
+        return {per_step<T>([&] {
+                  TT* p = buf.data();
+                  int i = 0;
+                  if constexpr (std::is_simd_v<T>)
+                    for (; i + T::size() <= n; i += T::size())
+                      (T(p + i) * a + b).copy_to(p + i);
+                  for (; i < n; ++i)
+                    p[i] = p[i] * a + b;
+                  asm volatile("" ::: "memory");
+                })};
+      }
+  };
+
+// the same with simd_for_each_aligned: a masked head and tail and aligned loads/stores
+template <>
+  struct Benchmark<Aligned>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        using V = std::simd<TT, size_v<T>>;
+        Buffer<TT> buf;
+        TT a = TT(.99), b = TT(.01);
+        fake_modify(a, b);
+        return {per_step<T>([&] {
+                  std::simd_for_each_aligned<V>(std::span<TT>(buf.data(), n), [&](auto chunk) {
+                    chunk.store(chunk.load() * a + b);
+                  });
+                  asm volatile("" ::: "memory");
+                })};
+      }
+  };
+
+// sums of 16 short arrays with the odd lengths 1, 3, ..., 31, stored back to back, i.e. mostly
+// head and tail chunks
+template <class... Flags>
+  struct Benchmark<Short, Flags...>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    static constexpr int arrays = 16;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        using V = std::simd<TT, size_v<T>>;
+        constexpr auto flags = [] {
+          if constexpr ((std::same_as<Flags, PageSafe> or ...))
+            return std::__simd_flag_page_safe;
+          else
+            return std::simd_flag_default;
+        }();
+        Buffer<TT> buf;
+        return {time_mean<20'000>([&] {
+                  const TT* p = buf.data();
+                  TT total = TT();
+                  for (int len = 1; len < 2 * arrays; len += 2)
+                    {
+                      if constexpr (std::is_simd_v<T>)
+                        {
+                          V sum = V();
+                          std::simd_for_each_aligned<V>(std::span<const TT>(p, len),
+                                                        [&](auto chunk) { sum += chunk.load(); },
+                                                        flags);
+                          total += reduce(sum);
+                        }
+                      else
+                        for (int i = 0; i < len; ++i)
+                          total += p[i];
+                      p += len;
+                    }
+                  fake_read(total);
+                }) / arrays};
+      }
+  };
+
+int
+main()
+{
+  bench_all<float>();
+  bench_all<float, Aligned>();
+  bench_all<double>();
+  bench_all<double, Aligned>();
+  bench_all<float, Short>();
+  bench_all<float, Short, PageSafe>();
+  bench_all<double, Short>();
+  bench_all<double, Short, PageSafe>();
+}
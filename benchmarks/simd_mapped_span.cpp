@@ -0,0 +1,129 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_mapped_span.h"
+
+#include <cstdio>
+#include <vector>
+
+struct Read
+{ static constexpr char name[] = "read()"; };
+
+struct Mapped
+{ static constexpr char name[] = "simd_mapped_span"; };
+
+struct Populate
+{ static constexpr char name[] = "populate"; };
+
+// size of the file (64 MiB)
+constexpr std::size_t bytes = std::size_t(64) << 20;
+
+// size of the buffer for read() (L2 resident)
+constexpr std::size_t chunk_bytes = std::size_t(256) << 10;
+
+// the file lives on tmpfs, thus neither variant waits for a disk
+const char* const path = "/dev/shm/simd_mapped_span_bench";
+
+// cycles per step of size_v<T> elements
+template <typename T>
+  double
+  per_step(auto&& fun)
+  { return time_mean<2>(fun) * size_v<T> / (bytes / sizeof(value_type_t<T>)); }
+
+template <typename T>
+  [[gnu::always_inline]] inline void
+  sum_chunk(T& sum, const value_type_t<T>* p, std::size_t n)
+  {
+    if constexpr (std::is_simd_v<T>)
+      for (std::size_t i = 0; i < n; i += T::size())
+        sum += T(p + i, std::simd_flag_aligned);
+    else
+      for (std::size_t i = 0; i < n; ++i)
+        sum += p[i];
+  }
+
+// read() into an L2 sized buffer and reduce it, chunk by chunk
+template <>
+  struct Benchmark<Read>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        std::simd_buffer<TT> buf(chunk_bytes / sizeof(TT));
+        return {per_step<T>([&] {
+                  const int fd = ::open(path, O_RDONLY);
+                  T sum = T();
+                  ssize_t n;
+                  while ((n = ::read(fd, buf.data(), chunk_bytes)) > 0)
+                    sum_chunk(sum, buf.data(), n / sizeof(TT));
+                  ::close(fd);
+                  fake_read(sum);
+                })};
+      }
+  };
+
+// map the file and reduce the mapped range in place
+template <class... Flags>
+  struct Benchmark<Mapped, Flags...>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    static constexpr std::simd_map_advice advice
+      = (std::same_as<Flags, Populate> or ...)
+          ? std::simd_map_advice::sequential | std::simd_map_advice::populate
+          : std::simd_map_advice::sequential;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        return {per_step<T>([&] {
+                  const std::simd_mapped_span<TT, std::simd<TT, size_v<T>>> mapped(path, advice);
+                  T sum = T();
+                  sum_chunk(sum, mapped.data(), mapped.padded_size());
+                  fake_read(sum);
+                })};
+      }
+  };
+
+int
+main()
+{
+  std::FILE* f = std::fopen(path, "wb");
+  if (not f)
+    {
+      std::perror(path);
+      return 1;
+    }
+  // 0x3f3f3f3f and 0x3f3f3f3f3f3f3f3f are normal numbers (no denormal penalties)
+  const std::vector<char> chunk(chunk_bytes, 0x3f);
+  for (std::size_t i = 0; i < bytes; i += chunk_bytes)
+    std::fwrite(chunk.data(), 1, chunk_bytes, f);
+  std::fclose(f);
+
+  bench_all<float, Read>();
+  bench_all<float, Mapped>();
+  bench_all<float, Mapped, Populate>();
+  bench_all<double, Read>();
+  bench_all<double, Mapped>();
+  bench_all<double, Mapped, Populate>();
+  std::remove(path);
+}
@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_allocator.h"
+#include "../simd_executor.h"
+#include "../simd_numa.h"
+
+#include <chrono>
+
+/* Memory bandwidth scaling with and without NUMA placement
+ * ========================================================
+ *
+ * Reduces a 256 MiB array with 1, 2, 4, ... threads up to the number of CPUs and reports the
+ * achieved bandwidth in GB/s:
+ *
+ * - plain: simd_executor(threads), the array is zeroed by the calling thread (thus all its pages
+ *   are on the node of the calling thread).
+ * - numa: simd_executor(simd_numa_topology(), threads), the array is first touched by the workers
+ *   with simd_first_touch (thus every share is on the node of the worker processing it).
+ *
+ * On a single-node machine both rows should match (the numa row only adds pinning). On multi-node
+ * machines the plain row saturates at the bandwidth of one node (plus the interconnect).
+ */
+
+using T = float;
+
+using V = std::simd<T>;
+
+// number of elements (256 MiB)
+constexpr std::size_t n = std::size_t(64) << 20;
+
+// the best bandwidth of a few runs of reduce, in GB/s
+double
+bandwidth(std::simd_executor& exec, const std::simd_buffer<T, V>& data)
+{
+  double best = 0;
+  for (int i = 0; i < 5; ++i)
+    {
+      const auto t0 = std::chrono::steady_clock::now();
+      T sum = std::simd_reduce<V>(exec, data);
+      fake_read(sum);
+      const std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+      best = std::max(best, n * sizeof(T) / dt.count() * 1e-9);
+    }
+  return best;
+}
+
+int
+main()
+{
+  const std::simd_numa_topology topology;
+  std::cout << "NUMA nodes:";
+  for (const std::simd_numa_node& node : topology.nodes())
+    std::cout << " node" << node.id << " (" << node.cpus.size() << " CPUs)";
+  std::cout << "\nreduce over " << (n * sizeof(T) >> 20) << " MiB of float with simd<float, "
+            << V::size() << ">\n"
+            << std::setw(8) << "threads" << std::setw(14) << "plain [GB/s]" << std::setw(14)
+            << "numa [GB/s]" << '\n';
+  const unsigned max_threads = topology.cpus();
+  for (unsigned threads = 1; threads <= max_threads;
+       threads = threads < max_threads and threads * 2 > max_threads ? max_threads : threads * 2)
+    {
+      std::cout << std::setw(8) << threads << std::setprecision(3) << std::fixed;
+      {
+        std::simd_executor exec(threads);
+        const std::simd_buffer<T, V> data(n);
+        std::cout << std::setw(14) << bandwidth(exec, data);
+      }
+      {
+        std::simd_executor exec(topology, threads);
+        auto data = std::simd_buffer<T, V>::for_overwrite(n);
+        std::simd_first_touch<V>(exec, data);
+        std::cout << std::setw(14) << bandwidth(exec, data) << std::endl;
+      }
+      if (threads == max_threads)
+        break;
+    }
+}
@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_pipeline.h"
+
+#include <vector>
+
+// Three element-wise stages over arrays that do not fit into the cache. Unfused, every stage is a
+// pass over memory (reading and writing 3 * 2 * sizeof(T) bytes per value); fused, one pass reads
+// and writes 2 * sizeof(T) bytes per value.
+
+struct Unfused
+{ static constexpr char name[] = "one pass per stage"; };
+
+struct Fused
+{ static constexpr char name[] = "fused"; };
+
+struct Stream
+{ static constexpr char name[] = "simd_stream"; };
+
+// number of elements (64 MiB of float)
+constexpr std::size_t n = 16 << 20;
+
+// cycles per step of size_v<T> elements
+template <typename T>
+  double
+  per_step(auto&& fun)
+  { return time_mean<4>(fun) * size_v<T> / n; }
+
+template <typename TT>
+  struct Arrays
+  {
+    std::vector<TT> in = std::vector<TT>(n, TT(1));
+
+    std::vector<TT> tmp = std::vector<TT>(n);
+
+    std::vector<TT> out = std::vector<TT>(n);
+  };
+
+constexpr auto stage1 = [](auto x) { return x * .5f; };
+
+constexpr auto stage2 = [](auto x) { return x + 1.f; };
+
+constexpr auto stage3 = [](auto x) { return x * x; };
+
+template <class Flag>
+  struct Benchmark<Flag>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        Arrays<TT> a;
+        const std::span<const TT> in = a.in;
+        const std::span<TT> tmp = a.tmp;
+        const std::span<TT> out = a.out;
+        return {per_step<T>([&] {
+                  if constexpr (not std::is_simd_v<T>)
+                    {
+                      if constexpr (std::same_as<Flag, Unfused>)
+                        {
+                          for (std::size_t i = 0; i < n; ++i)
+                            tmp[i] = stage1(in[i]);
+                          asm volatile("" ::: "memory");
+                          for (std::size_t i = 0; i < n; ++i)
+                            tmp[i] = stage2(tmp[i]);
+                          asm volatile("" ::: "memory");
+                          for (std::size_t i = 0; i < n; ++i)
+                            out[i] = stage3(tmp[i]);
+                        }
+                      else
+                        for (std::size_t i = 0; i < n; ++i)
+                          out[i] = stage3(stage2(stage1(in[i])));
+                    }
+                  else if constexpr (std::same_as<Flag, Unfused>)
+                    {
+                      std::simd_transform<T>(in, tmp, stage1);
+                      std::simd_transform<T>(std::span<const TT>(tmp), tmp, stage2);
+                      std::simd_transform<T>(std::span<const TT>(tmp), out, stage3);
+                    }
+                  else if constexpr (std::same_as<Flag, Fused>)
+                    std::simd_transform<T>(in, out, std::simd_pipeline() | stage1 | stage2
+                                                      | stage3);
+                  else
+                    {
+                      std::size_t read = 0, written = 0;
+                      std::simd_stream<T>([&](std::span<TT> block) {
+                        const std::size_t k = std::min(block.size(), n - read);
+                        std::memcpy(block.data(), in.data() + read, k * sizeof(TT));
+                        read += k;
+                        return k;
+                      }, std::simd_pipeline() | stage1 | stage2 | stage3,
+                                          [&](std::span<const TT> results) {
+                        std::memcpy(out.data() + written, results.data(),
+                                    results.size() * sizeof(TT));
+                        written += results.size();
+                      });
+                    }
+                  asm volatile("" ::: "memory");
+                })};
+      }
+  };
+
+int
+main()
+{
+  bench_all<float, Unfused>();
+  bench_all<float, Fused>();
+  bench_all<float, Stream>();
+  bench_all<double, Unfused>();
+  bench_all<double, Fused>();
+  bench_all<double, Stream>();
+}
@@ -0,0 +1,138 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_ring.h"
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Queue throughput: simd_ring versus a mutex-protected queue
+ * ==========================================================
+ *
+ * Half of the threads push batches of simd<float>, the other half pop them (and sum them up). The
+ * table lists the million batches transferred per second:
+ *
+ * - mutex: std::deque<V> protected by a std::mutex, one batch per lock.
+ * - mutex bulk: the same queue, up to 16 batches per lock.
+ * - mpmc: simd_ring<V, mpmc>, up to 16 batches per produce/consume, constructed in place.
+ * - spsc: simd_ring<V, spsc> (2 threads only).
+ *
+ * Threads that find the queue full or empty yield. With more threads than CPUs the numbers mostly
+ * measure the scheduler.
+ */
+
+using V = std::simd<float>;
+
+constexpr std::size_t bulk = 16;
+
+constexpr std::size_t capacity = 1024;
+
+// number of batches per producer
+constexpr std::size_t count = 1 << 18;
+
+class mutex_queue
+{
+  std::mutex mutex;
+  std::deque<V> queue;
+  const std::size_t max_size;
+
+public:
+  explicit
+  mutex_queue(std::size_t capacity)
+  : max_size(capacity)
+  {}
+
+  template <typename F>
+    std::size_t
+    produce(std::size_t n, F&& fn)
+    {
+      std::lock_guard lock(mutex);
+      n = std::min(n, max_size - queue.size());
+      for (std::size_t i = 0; i < n; ++i)
+        fn(queue.emplace_back(), i);
+      return n;
+    }
+
+  template <typename F>
+    std::size_t
+    consume(std::size_t n, F&& fn)
+    {
+      std::lock_guard lock(mutex);
+      n = std::min(n, queue.size());
+      for (std::size_t i = 0; i < n; ++i)
+        {
+          fn(queue.front(), i);
+          queue.pop_front();
+        }
+      return n;
+    }
+};
+
+// million batches per second, with threads / 2 producers and consumers each
+template <typename Queue>
+  double
+  throughput(unsigned threads, std::size_t batches_per_call)
+  {
+    Queue queue(capacity);
+    const unsigned producers = threads / 2;
+    std::atomic<std::size_t> remaining = producers * count;
+    const auto t0 = std::chrono::steady_clock::now();
+    {
+      std::vector<std::jthread> workers;
+      for (unsigned p = 0; p < producers; ++p)
+        workers.emplace_back([&] {
+          for (std::size_t k = 0; k < count;)
+            {
+              const std::size_t n = queue.produce(std::min(batches_per_call, count - k),
+                                                  [&](V& slot, std::size_t i) {
+                                                    slot = V(float(k + i));
+                                                  });
+              if (n == 0)
+                std::this_thread::yield();
+              k += n;
+            }
+        });
+      for (unsigned c = 0; c < threads - producers; ++c)
+        workers.emplace_back([&] {
+          V sum = {};
+          while (remaining.load(std::memory_order_relaxed) > 0)
+            {
+              const std::size_t n
+                = queue.consume(batches_per_call, [&](V& slot, std::size_t) { sum += slot; });
+              if (n == 0)
+                std::this_thread::yield();
+              else
+                remaining -= n;
+            }
+          fake_read(sum);
+        });
+    }
+    const std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+    return producers * count / dt.count() * 1e-6;
+  }
+
+int
+main()
+{
+  std::cout << "simd<float, " << V::size() << "> batches, " << std::thread::hardware_concurrency()
+            << " CPUs, [million batches/s]\n"
+            << std::setw(8) << "threads" << std::setw(12) << "mutex" << std::setw(12)
+            << "mutex bulk" << std::setw(12) << "mpmc" << std::setw(12) << "spsc" << '\n';
+  for (unsigned threads = 2; threads <= 32; threads *= 2)
+    {
+      std::cout << std::setw(8) << threads << std::setprecision(2) << std::fixed << std::setw(12)
+                << throughput<mutex_queue>(threads, 1) << std::setw(12)
+                << throughput<mutex_queue>(threads, bulk) << std::setw(12)
+                << throughput<std::simd_ring<V, std::simd_ring_kind::mpmc>>(threads, bulk);
+      if (threads == 2)
+        std::cout << std::setw(12)
+                  << throughput<std::simd_ring<V, std::simd_ring_kind::spsc>>(threads, bulk);
+      std::cout << std::endl;
+    }
+}
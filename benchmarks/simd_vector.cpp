@@ -0,0 +1,158 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_vector.h"
+
+#include <vector>
+
+template <typename T>
+  struct Particle
+  { T x, y, vx, vy; };
+
+template <typename T>
+  struct std::tuple_size<Particle<T>>
+  : std::integral_constant<std::size_t, 4>
+  {};
+
+template <std::size_t I, typename T>
+  struct std::tuple_element<I, Particle<T>>
+  { using type = T; };
+
+template <std::size_t I, typename T>
+  const T&
+  get(const Particle<T>& p)
+  {
+    if constexpr (I == 0)
+      return p.x;
+    else if constexpr (I == 1)
+      return p.y;
+    else if constexpr (I == 2)
+      return p.vx;
+    else
+      return p.vy;
+  }
+
+struct SoA
+{ static constexpr char name[] = "simd_vector"; };
+
+// number of particles per call
+constexpr int n = 4096;
+
+// cycles per step of size_v<T> particles
+template <typename T>
+  double
+  per_step(auto&& fun)
+  { return time_mean<500>(fun) * size_v<T> / n; }
+
+// x += vx * dt and y += vy * dt over an array of structs; simds are gathered and scattered
+template <>
+  struct Benchmark<>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        std::vector<Particle<TT>> aos(n);
+        for (int i = 0; i < n; ++i)
+          aos[i] = {TT(i), TT(-i), TT(1), TT(.5)};
+        TT dt = TT(.01);
+        fake_modify(dt);
+
+        return {per_step<T>([&] {
+                  for (int i = 0; i < n; i += size_v<T>)
+                    {
+                      if constexpr (std::is_simd_v<T>)
+                        {
+                          const T x([&](int j) { return aos[i + j].x; });
+                          const T y([&](int j) { return aos[i + j].y; });
+                          const T vx([&](int j) { return aos[i + j].vx; });
+                          const T vy([&](int j) { return aos[i + j].vy; });
+                          const T x1 = x + vx * dt;
+                          const T y1 = y + vy * dt;
+                          for (int j = 0; j < T::size(); ++j)
+                            {
+                              aos[i + j].x = x1[j];
+                              aos[i + j].y = y1[j];
+                            }
+                        }
+                      else
+                        {
+                          aos[i].x += aos[i].vx * dt;
+                          aos[i].y += aos[i].vy * dt;
+                        }
+                    }
+                  asm volatile("" ::: "memory");
+                })};
+      }
+  };
+
+// the same with simd_vector: one aligned load/store per member and chunk
+template <>
+  struct Benchmark<SoA>
+  {
+    static constexpr Info<1> info = {"Throughput"};
+
+    template <typename T>
+      static constexpr bool accept
+        = std::floating_point<value_type_t<T>> and not vec_builtin<T>;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<1>
+      run()
+      {
+        using TT = value_type_t<T>;
+        constexpr int N = size_v<T>;
+        std::simd_vector<Particle<TT>, N> soa;
+        for (int i = 0; i < n; ++i)
+          soa.push_back({TT(i), TT(-i), TT(1), TT(.5)});
+        TT dt = TT(.01);
+        fake_modify(dt);
+
+        return {per_step<T>([&] {
+                  if constexpr (std::is_simd_v<T>)
+                    {
+                      for (auto chunk : soa.chunks())
+                        {
+                          chunk.template set<0>(chunk.template get<0>()
+                                                  + chunk.template get<2>() * dt);
+                          chunk.template set<1>(chunk.template get<1>()
+                                                  + chunk.template get<3>() * dt);
+                        }
+                    }
+                  else
+                    {
+                      auto x = soa.template column<0>();
+                      auto y = soa.template column<1>();
+                      auto vx = soa.template column<2>();
+                      auto vy = soa.template column<3>();
+                      for (int i = 0; i < n; ++i)
+                        {
+                          x[i] += vx[i] * dt;
+                          y[i] += vy[i] * dt;
+                        }
+                    }
+                  asm volatile("" ::: "memory");
+                })};
+      }
+  };
+
+int
+main()
+{
+  bench_all<float>();
+  bench_all<float, SoA>();
+  bench_all<double>();
+  bench_all<double, SoA>();
+}
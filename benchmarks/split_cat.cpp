@@ -0,0 +1,88 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "bench.h"
+#include "../simd_split.h"
+
+struct Halves
+{
+  static constexpr char name[] = "halves";
+
+  static constexpr int parts = 2;
+
+  // swap the two halves
+  template <typename T>
+    static T
+    apply(const T& x)
+    {
+      const auto [lo, hi] = std::simd_split<std::resize_simd_t<T::size() / 2, T>>(x);
+      return std::simd_cat(hi, lo);
+    }
+};
+
+struct Quarters
+{
+  static constexpr char name[] = "quarters";
+
+  static constexpr int parts = 4;
+
+  // rotate by one quarter
+  template <typename T>
+    static T
+    apply(const T& x)
+    {
+      const auto [a, b, c, d] = std::simd_split<std::resize_simd_t<T::size() / 4, T>>(x);
+      return std::simd_cat(d, a, b, c);
+    }
+};
+
+// Splitting into equal parts and concatenation of the parts in a different order:
+// `simd_cat(simd_split<V>(x)...)`
+template <class Op>
+  struct Benchmark<Op>
+  {
+    static constexpr Info<2> info = {"Latency", "Throughput"};
+
+    template <typename T>
+      static constexpr bool accept = std::is_simd_v<T> and size_v<T> >= Op::parts;
+
+    template <class T>
+      [[gnu::flatten]]
+      static Times<2>
+      run()
+      {
+        using TT = value_type_t<T>;
+        T one = T() + TT(1);
+        fake_modify(one);
+
+        // the fake_modify in both lambdas cancels out, leaving the cost of split and cat
+        auto process_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = Op::apply(inout) + one;
+        };
+
+        auto fake_one = [&](T& inout) {
+          fake_modify(inout);
+          inout = inout + one;
+        };
+
+        T a[8] = {};
+        return { time_latency(a, process_one, fake_one),
+                 time_throughput(a, process_one, fake_one) };
+      }
+  };
+
+int
+main()
+{
+  bench_all<float, Halves>();
+  bench_all<float, Quarters>();
+  bench_all<double, Halves>();
+  bench_all<double, Quarters>();
+  bench_all<int, Halves>();
+  bench_all<int, Quarters>();
+  bench_all<short, Halves>();
+  bench_all<short, Quarters>();
+}
@@ -0,0 +1,33 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "../simd"
+
+// The instantiations a typical use of simd<T, N> needs, for measuring their compile time (see
+// run.sh). Compile with -D COMPILE_TIME_TYPE=<type> -D COMPILE_TIME_WIDTH=<N>.
+
+using T = COMPILE_TIME_TYPE;
+
+using V = std::simd<T, COMPILE_TIME_WIDTH>;
+
+using M = typename V::mask_type;
+
+using I = std::rebind_simd_t<int, V>;
+
+// loads, stores, arithmetic, compares, selects, conversions, and reductions
+T
+use(const T* in, T* out)
+{
+  V x(in);
+  const V y = x * x + V(T(1)) - x / V([](int j) { return T(j + 1); });
+  const M k = x < y and not (x == y);
+  x = std::simd_select(k, x, y);
+  x.copy_to(out, k);
+  x.copy_to(out + V::size());
+  const I i(x);
+  const V z(i);
+  return std::reduce(x) + std::reduce_min(y) + T(std::reduce_count(k)) + T(std::reduce(i))
+           + T(std::any_of(k)) + z[0];
+}
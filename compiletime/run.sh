@@ -0,0 +1,132 @@
+#!/bin/bash
+## SPDX-License-Identifier: GPL-3.0-or-later
+## Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+##                       Matthias Kretz <m.kretz@gsi.de>
+
+usage() {
+  cat <<EOF
+Usage: $0 [options] [<width>...]
+
+Measures the compile time of instantiate.c++ (the typical uses of simd<T, N>) per width N (default:
+1 to 67, like the tests). The table lists the wall time of the whole compilation, the part of it
+spent on template instantiation, and the memory the compiler allocated. With GCC the numbers come
+from -ftime-report, with clang from -ftime-trace (clang does not report memory).
+
+Widths for which simd<T, N> is not valid are listed as such.
+
+The simd headers are either included textually, or via a pre-compiled header (like the tests, see
+obj/*.hpp in Makefile.common). The PCH is built once, the first row of the table lists the cost of
+that.
+
+Options:
+  -h, --help        This message.
+  -a, --arch <arch> The -march argument (default: skylake).
+  -t, --type <type> The value type (default: float).
+  -m, --mode <mode> How to get the simd headers: include or pch (default: include).
+
+Environment: CXX (default: g++) and CXXFLAGS are used like in the Makefile.
+EOF
+}
+
+dir="$(cd "$(dirname "$0")"; pwd)"
+arch=skylake
+type=float
+mode=include
+widths=()
+while (($# > 0)); do
+  case "$1" in
+    -h|--help)
+      usage
+      exit 0
+      ;;
+    -a|--arch)
+      arch="$2"
+      shift
+      ;;
+    -t|--type)
+      type="$2"
+      shift
+      ;;
+    -m|--mode)
+      mode="$2"
+      shift
+      ;;
+    *)
+      widths=("${widths[@]}" "$1")
+      ;;
+  esac
+  shift
+done
+((${#widths[@]} == 0)) && widths=($(seq 1 67))
+
+CXX="${CXX:-g++}"
+CXXFLAGS="${CXXFLAGS:--std=gnu++23 -O2}"
+clang=false
+$CXX --version | grep -qi clang && clang=true
+
+tmp="$(mktemp -d)"
+trap "rm -rf '$tmp'" EXIT
+
+# Compiles with the given arguments and prints the table row for it, labeled $1
+measure() {
+  local label="$1"
+  shift
+  rm -f "$tmp"/*.json
+  if $clang; then
+    if ! $CXX $CXXFLAGS "$@" -ftime-trace >"$tmp/log" 2>&1; then
+      printf "%6s %12s\n" "$label" "invalid"
+      return 1
+    fi
+    # the durations of the "Total ..." events in µs
+    grep -o '"dur":[0-9]*,"name":"Total [A-Za-z]*"' "$tmp"/*.json | awk -F'[:,"]+' -v l="$label" '
+      { dur[$5] = $3 }
+      END {
+        printf "%6s %12.2f %18.2f %12s\n", l, dur["Total ExecuteCompiler"] / 1e6,
+               (dur["Total InstantiateClass"] + dur["Total InstantiateFunction"]) / 1e6, "-"
+      }'
+  else
+    if ! $CXX $CXXFLAGS "$@" -ftime-report >"$tmp/log" 2>&1; then
+      printf "%6s %12s\n" "$label" "invalid"
+      return 1
+    fi
+    # " <name> : usr (%) sys (%) wall (%) mem (%)", TOTAL without the percentages
+    awk -v l="$label" '
+      function mb(m) {
+        return m ~ /k$/ ? m / 1024 : m ~ /M$/ ? m + 0 : m ~ /G$/ ? m * 1024 : m / 2^20
+      }
+      /^ template instantiation / { inst = $(NF - 5) }
+      /^ TOTAL / { wall = $(NF - 1); mem = mb($NF) }
+      END { printf "%6s %12.2f %18.2f %12.0f\n", l, wall, inst, mem }
+    ' "$tmp/log"
+  fi
+}
+
+echo "$CXX $CXXFLAGS -march=$arch, value type: $type, simd headers via $mode"
+printf "%6s %12s %18s %12s\n" "width" "total [s]" "instantiation [s]" "memory [MB]"
+mode_flags=()
+case "$mode" in
+  include)
+    ;;
+  pch)
+    # the -D COMPILE_TIME_* macros are not used in the headers and thus don't invalidate the PCH
+    echo "#include \"$dir/../simd\"" > "$tmp/simd.hpp"
+    if $clang; then
+      measure PCH -march=$arch -x c++-header -o "$tmp/simd.hpp.pch" "$tmp/simd.hpp" || exit 1
+      mode_flags=(-include-pch "$tmp/simd.hpp.pch")
+    else
+      measure PCH -march=$arch -x c++-header -o "$tmp/simd.hpp.gch" "$tmp/simd.hpp" || exit 1
+      mode_flags=(-Winvalid-pch -include "$tmp/simd.hpp")
+    fi
+    ;;
+  *)
+    usage >&2
+    exit 1
+    ;;
+esac
+
+for w in "${widths[@]}"; do
+  measure $w -march=$arch "${mode_flags[@]}" -D COMPILE_TIME_TYPE="$type" \
+    -D COMPILE_TIME_WIDTH=$w -c -o "$tmp/x.o" "$dir/instantiate.c++" || continue
+done
+
+# vim: tw=0 si sw=2
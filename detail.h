@@ -21,9 +21,9 @@ namespace std::__detail
     _GLIBCXX_SIMD_INTRINSIC constexpr bool
     __is_power2_minus_1(_Tp __x)
     {
-      using _Ip = __make_signed_int_t<_Tp>;
-      _Ip __y = __builtin_bit_cast(_Ip, __x);
-      return __y == -1 or std::__has_single_bit(__x + 1);
+      using _Up = __make_unsigned_int_t<_Tp>;
+      const _Up __y = __builtin_bit_cast(_Up, __x);
+      return __y == _Up(~_Up()) or std::__has_single_bit(_Up(__y + 1));
     }
 
   /**@internal
@@ -45,6 +45,13 @@ namespace std::__detail
 
   inline constexpr _PrivateInit __private_init = _PrivateInit{};
 
+  // the smallest page size of all supported targets (a read that does not cross a multiple of it
+  // cannot fault if any of the bytes it reads is accessible)
+  inline constexpr size_t __min_page_size = 4096;
+
+  // the cache line size assumed for loop-level prefetching (one prefetch per line)
+  inline constexpr size_t __cache_line_size = 64;
+
   template <integral _Tp, typename _Fp>
     _GLIBCXX_SIMD_INTRINSIC static void
     _S_bit_iteration(_Tp __mask, _Fp&& __f)
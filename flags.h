@@ -34,7 +34,10 @@ namespace std::__detail
     template <typename _Tp, typename _Up>
       _GLIBCXX_SIMD_INTRINSIC static constexpr _Up*
       _S_adjust_pointer(_Up* __ptr)
-      { return static_cast<_Up*>(__builtin_assume_aligned(__ptr, simd_alignment_v<_Tp, _Up>)); }
+      {
+        return static_cast<_Up*>(
+                 __builtin_assume_aligned(__ptr, simd_alignment_v<_Tp, remove_const_t<_Up>>));
+      }
   };
 
   template <std::size_t _Np>
@@ -53,6 +56,11 @@ namespace std::__detail
   : _LoadStoreTag
   {};
 
+  // partial loads may read a full vector if that does not cross a page boundary
+  struct _PageSafe
+  : _LoadStoreTag
+  {};
+
   template <int _L1, int _L2 /*, exclusive vs. shared*/>
     struct _Prefetch
     : _LoadStoreTag
@@ -79,6 +87,14 @@ namespace std::__detail
         }
     };
 
+  // Loop-level prefetching for simd_for_each_aligned: one prefetch per cache line, _Distance bytes
+  // (rounded up to whole cache lines) ahead of the current chunk. _Distance == 0 selects a distance
+  // from the size of the chunks (see __prefetch_distance in simd_loop.h).
+  template <size_t _Distance>
+    struct _PrefetchStream
+    : _LoadStoreTag
+    {};
+
   template <typename _Tp>
     concept __loadstore_tag = std::is_base_of_v<_LoadStoreTag, _Tp>;
 } // namespace __detail
@@ -208,9 +224,15 @@ namespace std
 
   inline constexpr std::simd_flags<std::__detail::_Streaming> __simd_flag_streaming;
 
+  inline constexpr std::simd_flags<std::__detail::_PageSafe> __simd_flag_page_safe;
+
   template <int _L1, int _L2>
     inline constexpr std::simd_flags<std::__detail::_Prefetch<_L1, _L2>> __simd_flag_prefetch;
 
+  template <size_t _Distance = 0>
+    inline constexpr std::simd_flags<std::__detail::_PrefetchStream<_Distance>>
+      __simd_flag_prefetch_stream;
+
   [[deprecated("use simd_flag_default")]]
   inline constexpr auto element_aligned = simd_flag_default;
 
@@ -168,13 +168,16 @@ namespace std
             return __r;
         }
 
-      else if constexpr (requires {_Abi::_MaskImpl::_S_popcount(__k);})
+      // not chained to the branches above: the reduce fallback must not be instantiated if it is
+      // unreachable (for _AbiCombine it is costly)
+      if constexpr (requires {_Abi::_MaskImpl::_S_popcount(__k);})
         return _Abi::_MaskImpl::_S_popcount(__k);
 
       else
-        static_assert(-__size >= __finite_min_v<__detail::__mask_integer_from<_Bs>>);
-
-      return -reduce(-__k);
+        {
+          static_assert(-__size >= __finite_min_v<__detail::__mask_integer_from<_Bs>>);
+          return -reduce(-__k);
+        }
     }
 
   /**
@@ -136,6 +136,52 @@ namespace std
                  }
              });
     }
+
+  /**
+   * Returns a simd with the elements `__v[__idx[i]]` (runtime indexes).
+   *
+   * Precondition: 0 <= __idx[i] < __v.size()
+   */
+  template <__detail::__simd_type _Vp, __detail::__simd_type _Ip>
+    requires integral<typename _Ip::value_type>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr resize_simd_t<_Ip::size(), _Vp>
+    simd_permute(const _Vp& __v, const _Ip& __idx) noexcept
+    {
+      using _Tp = typename _Vp::value_type;
+      using _Rp = resize_simd_t<_Ip::size(), _Vp>;
+      if (not __builtin_is_constant_evaluated()
+            and sizeof(_Tp) == sizeof(typename _Ip::value_type))
+        {
+          using _IV = remove_cvref_t<decltype(__data(__idx))>;
+          using _TV = remove_cvref_t<decltype(__data(declval<const _Rp&>()))>;
+          if constexpr (__detail::__vec_builtin<_TV> and __detail::__vec_builtin<_IV>
+                          and sizeof(_TV) == sizeof(_IV))
+            {
+              // a table smaller than the index vector is repeated to fill a register, a table
+              // of twice the size is split into two registers; both then compile to variable
+              // shuffles (e.g. vpermps, vpermilps, vpermt2ps, pshufb)
+              if constexpr (_Ip::size() % _Vp::size() == 0)
+                {
+                  const _Rp __tab = simd_permute<_Ip::size()>(__v, [](unsigned __i) {
+                                      return __i % _Vp::size();
+                                    });
+                  return {__detail::__private_init,
+                          __builtin_shuffle(__data(__tab), __data(__idx))};
+                }
+              else if constexpr (_Vp::size() == 2 * _Ip::size()
+                                   and __detail::__width_of<_TV> == _Ip::size())
+                {
+                  const _Rp __lo = simd_permute<_Ip::size()>(__v, [](int __i) { return __i; });
+                  const _Rp __hi = simd_permute<_Ip::size()>(__v, [](int __i) {
+                                     return __i + int(_Ip::size());
+                                   });
+                  return {__detail::__private_init,
+                          __builtin_shuffle(__data(__lo), __data(__hi), __data(__idx))};
+                }
+            }
+        }
+      return _Rp([&](int __i) { return __v[__idx[__i]]; });
+    }
 }
 
 #endif  // PROTOTYPE_PERMUTE_H_
@@ -138,7 +138,7 @@ namespace std
         basic_simd(_It __first, const mask_type& __k, simd_flags<_Flags...> __flags = {})
         : _M_data(_Impl::_S_masked_load(_MemberType(), __data(__k),
                                         __flags.template _S_adjust_pointer<basic_simd>(
-                                          std::to_address(__first))))
+                                          std::to_address(__first)), __flags))
         {}
 
       ////////////////////////////////////////////////////////////////////////////////////////////
@@ -241,7 +241,7 @@ namespace std
         {
           _M_data = _Impl::_S_masked_load(_M_data, __data(__k),
                                           __flags.template _S_adjust_pointer<basic_simd>(
-                                            std::to_address(__first)));
+                                            std::to_address(__first)), __flags);
         }
 
       template <std::contiguous_iterator _It, typename... _Flags>
@@ -387,14 +387,13 @@ namespace std
           _S_load(const _Up* __mem, _TypeTag<_Tp> __tag) noexcept
           { return {_Impl0::_S_load(__mem + _Is * _S_chunk_size, __tag)...}; }
 
-        template <typename _Tp, typename _Up>
+        template <typename _Tp, typename _Up, typename... _Fs>
           static constexpr inline _Tp
           _S_masked_load(_Tp const& __merge, _MaskMember<_Tp> const& __k,
-                         const _Up* __mem) noexcept
+                         const _Up* __mem, simd_flags<_Fs...> __flags = {}) noexcept
           {
-            _SimdMember<_Tp> __ret = __merge;
-            (_Impl0::_S_masked_load(__ret[_Is], __k[_Is], __mem + _Is * _S_chunk_size), ...);
-            return __ret;
+            return {_Impl0::_S_masked_load(__merge[_Is], __k[_Is], __mem + _Is * _S_chunk_size,
+                                           __flags)...};
           }
 
         template <__vec_builtin _TV, typename _Up>
@@ -477,6 +476,79 @@ namespace std
           _S_bit_shift_right(_Tp const& __x, int __y) noexcept
           { return {_Impl0::_S_bit_shift_right(__x[_Is], __y)...}; }
 
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_add_sat(_Tp const& __x, _Tp const& __y) noexcept
+          { return {_Impl0::_S_add_sat(__x[_Is], __y[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_sub_sat(_Tp const& __x, _Tp const& __y) noexcept
+          { return {_Impl0::_S_sub_sat(__x[_Is], __y[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_avg(_Tp const& __x, _Tp const& __y) noexcept
+          { return {_Impl0::_S_avg(__x[_Is], __y[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_abs_diff(_Tp const& __x, _Tp const& __y) noexcept
+          { return {_Impl0::_S_abs_diff(__x[_Is], __y[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_mulhi(_Tp const& __x, _Tp const& __y) noexcept
+          { return {_Impl0::_S_mulhi(__x[_Is], __y[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_addsub(_Tp const& __x, _Tp const& __y) noexcept
+          { return {_Impl0::_S_addsub(__x[_Is], __y[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_fmaddsub(_Tp const& __x, _Tp const& __y, _Tp const& __z) noexcept
+          { return {_Impl0::_S_fmaddsub(__x[_Is], __y[_Is], __z[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_popcount(_Tp const& __x) noexcept
+          { return {_Impl0::_S_popcount(__x[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_countl_zero(_Tp const& __x) noexcept
+          { return {_Impl0::_S_countl_zero(__x[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_countr_zero(_Tp const& __x) noexcept
+          { return {_Impl0::_S_countr_zero(__x[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_byteswap(_Tp const& __x) noexcept
+          { return {_Impl0::_S_byteswap(__x[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_bit_reverse(_Tp const& __x) noexcept
+          { return {_Impl0::_S_bit_reverse(__x[_Is])...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+          _S_rotl(_Tp const& __x, int __s) noexcept
+          { return {_Impl0::_S_rotl(__x[_Is], __s)...}; }
+
+        template <typename _Tp>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr auto
+          _S_sad(_Tp const& __x, _Tp const& __y) noexcept
+          {
+            using _Rp = decltype(_Impl0::_S_sad(__x[0], __y[0]));
+            return static_cast<_Rp>((_Impl0::_S_sad(__x[_Is], __y[_Is]) + ...));
+          }
+
         template <typename _Tp>
           _GLIBCXX_SIMD_INTRINSIC static constexpr _MaskMember<_Tp>
           _S_equal_to(_Tp const& __x, _Tp const& __y) noexcept
@@ -585,27 +657,32 @@ namespace std
           _S_reduce(basic_simd<_Tp, abi_type> __xx, const _BinaryOperation& __binary_op)
           {
             auto& __x = __data(__xx); // the array was copied by the caller - we're not changing it
-            (((_Is % 2) == 1 ? (__x[_Is - 1] = __binary_op(__x[_Is - 1], __x[_Is])) : __x[0]), ...);
+            using _V0 = basic_simd<_Tp, _Abi0>;
+            // __binary_op is only required to be callable with basic_simd, not with the members
+            auto __op = [&](const auto& __a, const auto& __b) {
+              return __data(__binary_op(_V0(__private_init, __a), _V0(__private_init, __b)));
+            };
+            (((_Is % 2) == 1 ? (__x[_Is - 1] = __op(__x[_Is - 1], __x[_Is])) : __x[0]), ...);
             if constexpr (_Np > 2)
-              (((_Is % 4) == 2 ? (__x[_Is - 2] = __binary_op(__x[_Is - 2], __x[_Is])) : __x[0]),
+              (((_Is % 4) == 2 ? (__x[_Is - 2] = __op(__x[_Is - 2], __x[_Is])) : __x[0]),
                ...);
             if constexpr (_Np > 4)
-              (((_Is % 8) == 4 ? (__x[_Is - 4] = __binary_op(__x[_Is - 4], __x[_Is])) : __x[0]),
+              (((_Is % 8) == 4 ? (__x[_Is - 4] = __op(__x[_Is - 4], __x[_Is])) : __x[0]),
                ...);
             if constexpr (_Np > 8)
-              (((_Is % 16) == 8 ? (__x[_Is - 8] = __binary_op(__x[_Is - 8], __x[_Is])) : __x[0]),
+              (((_Is % 16) == 8 ? (__x[_Is - 8] = __op(__x[_Is - 8], __x[_Is])) : __x[0]),
                ...);
             if constexpr (_Np > 16)
-              (((_Is % 32) == 16 ? (__x[_Is - 16] = __binary_op(__x[_Is - 16], __x[_Is])) : __x[0]),
+              (((_Is % 32) == 16 ? (__x[_Is - 16] = __op(__x[_Is - 16], __x[_Is])) : __x[0]),
                ...);
             if constexpr (_Np > 32)
-              (((_Is % 64) == 32 ? (__x[_Is - 32] = __binary_op(__x[_Is - 32], __x[_Is])) : __x[0]),
+              (((_Is % 64) == 32 ? (__x[_Is - 32] = __op(__x[_Is - 32], __x[_Is])) : __x[0]),
                ...);
             if constexpr (_Np > 64)
-              (((_Is % 128) == 64 ? (__x[_Is - 64] = __binary_op(__x[_Is - 64], __x[_Is]))
+              (((_Is % 128) == 64 ? (__x[_Is - 64] = __op(__x[_Is - 64], __x[_Is]))
                                   : __x[0]), ...);
             static_assert(_Np <= 128);
-            return std::reduce(basic_simd<_Tp, _Abi0>(__private_init, __x[0]), __binary_op);
+            return std::reduce(_V0(__private_init, __x[0]), __binary_op);
           }
       };
 
@@ -789,7 +866,11 @@ namespace std
             else
               return {[&]<size_t... _Js>(vir::constexpr_value<int> auto __i,
                                          std::index_sequence<_Js...>) {
-                return _MaskMember0<_Tp>{ -__gen(__ic<__i * _S_chunk_size + _Js>)... };
+                using _M0 = _MaskMember0<_Tp>;
+                if constexpr (is_integral_v<_M0>) // bitmask
+                  return _M0(((uint64_t(__gen(__ic<__i * _S_chunk_size + _Js>)) << _Js) | ...));
+                else
+                  return _M0{__value_type_of<_M0>(-__gen(__ic<__i * _S_chunk_size + _Js>))...};
               }(vir::cw<_Is>, std::make_index_sequence<_S_chunk_size>())...};
           }
 
@@ -966,6 +1047,17 @@ namespace std
             return *this;
           }
 
+        template <vir::constexpr_value<int> _Cv = decltype(0_cw)>
+          _GLIBCXX_SIMD_INTRINSIC constexpr _SimdTuple&
+          _M_forall(const _SimdTuple& __a, const _SimdTuple& __b, auto&& __fun,
+                    _Cv __total_offset = {})
+          {
+            __fun(_SimdTupleMeta<_Tp, _A0, __total_offset>(), _M_x, __a._M_x, __b._M_x);
+            if constexpr (_S_recurse)
+              _M_tail._M_forall(__a._M_tail, __b._M_tail, __fun, __total_offset + _S_size);
+            return *this;
+          }
+
         template <vir::constexpr_value<int> _Cv = decltype(0_cw)>
           _GLIBCXX_SIMD_INTRINSIC constexpr const _SimdTuple&
           _M_forall(auto&& __fun, _Cv __total_offset = {}) const
@@ -1014,6 +1106,10 @@ namespace std
         template <typename _Tp>
           using _TypeTag = _Tp*;
 
+        // _S_reduce only calls std::reduce and binary operations on the native chunks, which all
+        // work in constant expressions (see std::reduce)
+        static constexpr bool _S_reduce_is_constexpr = true;
+
         template <typename _Tp>
           _GLIBCXX_SIMD_INTRINSIC static constexpr _SimdMember<_Tp>
           _S_broadcast(_Tp __x) noexcept
@@ -1047,10 +1143,11 @@ namespace std
                    });
           }
 
-        template <typename _Tp, typename... _As, typename _Up>
+        template <typename _Tp, typename... _As, typename _Up, typename... _Fs>
           _GLIBCXX_SIMD_INTRINSIC static _SimdTuple<_Tp, _As...>
           _S_masked_load(const _SimdTuple<_Tp, _As...>& __old,
-                         const _MaskMember __bits, const _Up* __mem)
+                         const _MaskMember __bits, const _Up* __mem,
+                         simd_flags<_Fs...> __flags = {})
           {
             auto __merge = __old;
             __merge._M_forall([&] [[__gnu__::__always_inline__]] (auto __meta, auto& __chunk) {
@@ -1062,7 +1159,7 @@ namespace std
                 // the pointer arithmetic is UB.
 #pragma GCC diagnostic ignored "-Warray-bounds"
                 __chunk = __meta._S_masked_load(__chunk, __meta._S_make_mask(__bits),
-                                                __mem + __meta._S_offset);
+                                                __mem + __meta._S_offset, __flags);
 #pragma GCC diagnostic pop
             });
             return __merge;
@@ -1248,9 +1345,27 @@ namespace std
         _GLIBCXX_SIMD_FIXED_OP(_S_bit_xor)
         _GLIBCXX_SIMD_FIXED_OP(_S_bit_shift_left)
         _GLIBCXX_SIMD_FIXED_OP(_S_bit_shift_right)
+        _GLIBCXX_SIMD_FIXED_OP(_S_add_sat)
+        _GLIBCXX_SIMD_FIXED_OP(_S_sub_sat)
+        _GLIBCXX_SIMD_FIXED_OP(_S_avg)
+        _GLIBCXX_SIMD_FIXED_OP(_S_abs_diff)
+        _GLIBCXX_SIMD_FIXED_OP(_S_mulhi)
+        _GLIBCXX_SIMD_FIXED_OP(_S_addsub)
 
 #undef _GLIBCXX_SIMD_FIXED_OP
 
+        template <typename _Tp, typename... _As>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr __sad_result_t<_Tp>
+          _S_sad(_SimdTuple<_Tp, _As...> __x, const _SimdTuple<_Tp, _As...>& __y)
+          {
+            __sad_result_t<_Tp> __r = 0;
+            __x._M_forall(__y, [&__r] [[__gnu__::__always_inline__]]
+                          (auto __meta, auto& __xx, auto __yy) {
+                            __r += __meta._S_sad(__xx, __yy);
+                          });
+            return __r;
+          }
+
         template <typename _Tp, typename... _As>
           _GLIBCXX_SIMD_INTRINSIC static constexpr _SimdTuple<_Tp, _As...>
           _S_bit_shift_left(_SimdTuple<_Tp, _As...> __x, int __y)
@@ -1269,6 +1384,46 @@ namespace std
                    });
           }
 
+        template <typename _Tp, typename... _As>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _SimdTuple<_Tp, _As...>
+          _S_rotl(_SimdTuple<_Tp, _As...> __x, int __s)
+          {
+            return __x._M_forall([__s] [[__gnu__::__always_inline__]] (auto __impl, auto& __xx) {
+                     __xx = __impl._S_rotl(__xx, __s);
+                   });
+          }
+
+#define _GLIBCXX_SIMD_FIXED_UNARY_OP(name_)                                                       \
+        template <typename _Tp, typename... _As>                                                  \
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _SimdTuple<_Tp, _As...>                        \
+          name_(_SimdTuple<_Tp, _As...> __x)                                                      \
+          {                                                                                       \
+            return __x._M_forall([] [[__gnu__::__always_inline__]] (auto __meta, auto& __xx) {    \
+                     __xx = __meta.name_(__xx);                                                   \
+                   });                                                                            \
+          }
+
+        _GLIBCXX_SIMD_FIXED_UNARY_OP(_S_popcount)
+        _GLIBCXX_SIMD_FIXED_UNARY_OP(_S_countl_zero)
+        _GLIBCXX_SIMD_FIXED_UNARY_OP(_S_countr_zero)
+        _GLIBCXX_SIMD_FIXED_UNARY_OP(_S_byteswap)
+        _GLIBCXX_SIMD_FIXED_UNARY_OP(_S_bit_reverse)
+
+#undef _GLIBCXX_SIMD_FIXED_UNARY_OP
+
+        // all chunks of a tuple with an even total size have an even size, so the even/odd
+        // pattern is preserved per chunk; each chunk uses its own (fused) _S_fmaddsub
+        template <typename _Tp, typename... _As>
+          _GLIBCXX_SIMD_INTRINSIC static constexpr _SimdTuple<_Tp, _As...>
+          _S_fmaddsub(_SimdTuple<_Tp, _As...> __x, const _SimdTuple<_Tp, _As...>& __y,
+                      const _SimdTuple<_Tp, _As...>& __z)
+          {
+            return __x._M_forall(__y, __z, [] [[__gnu__::__always_inline__]]
+                   (auto __meta, auto& __xx, auto __yy, auto __zz) {
+                     __xx = __meta._S_fmaddsub(__xx, __yy, __zz);
+                   });
+          }
+
 #if 0
 #define _GLIBCXX_SIMD_APPLY_ON_TUPLE(_RetTp, __name)                                               \
         template <typename _Tp, typename... _As, typename... _More>                                \
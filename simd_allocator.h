@@ -0,0 +1,283 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_ALLOCATOR_H_
+#define PROTOTYPE_SIMD_ALLOCATOR_H_
+
+#include "simd.h"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <span>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+
+/* Memory for aligned simd loads and stores
+ * ========================================
+ *
+ * simd_allocator<T, V> allocates memory aligned to simd_alignment_v<V, T> and rounds every
+ * allocation up to a multiple of V::size() elements. The padding after the requested n elements is
+ * zero-initialized. Thus, e.g. `std::vector<float, simd_allocator<float>>` can be loaded and stored
+ * with full-width loads and stores at every multiple of V::size() up to and including the last
+ * partial chunk, without a masked epilogue. These accesses are aligned (simd_flag_aligned) if
+ * V::size() * sizeof(T) is a multiple of the alignment, which holds for all power-of-2 widths.
+ * (Note that std::vector itself does not initialize [size(), capacity()).)
+ *
+ * Allocations of at least __simd_huge_page_size bytes are aligned to the huge page size and, where
+ * madvise is available, marked with MADV_HUGEPAGE to request transparent huge pages.
+ *
+ * simd_buffer<T, V> is a fixed-size, zero-initialized buffer using simd_allocator.
+ * simd_buffer<T, V>::for_overwrite(n) leaves the elements uninitialized.
+ */
+
+namespace std
+{
+  namespace __detail
+  {
+    inline constexpr size_t __simd_huge_page_size = size_t(2) << 20;
+
+    template <typename _Tp, typename _Vp>
+      inline constexpr size_t __simd_allocation_alignment
+        = std::max(simd_alignment_v<_Vp>, alignof(_Tp));
+  }
+
+  template <typename _Tp, __detail::__simd_type _Vp = simd<_Tp>>
+    class simd_allocator
+    {
+      static constexpr size_t _S_width = _Vp::size();
+
+      static constexpr size_t _S_alignment = __detail::__simd_allocation_alignment<_Tp, _Vp>;
+
+      static constexpr size_t
+      _S_padded_size(size_t __n) noexcept
+      { return (__n + _S_width - 1) / _S_width * _S_width; }
+
+      static constexpr bool
+      _S_huge(size_t __bytes) noexcept
+      { return __bytes >= __detail::__simd_huge_page_size; }
+
+      static constexpr size_t
+      _S_bytes(size_t __n) noexcept
+      {
+        const size_t __bytes = _S_padded_size(__n) * sizeof(_Tp);
+        if (_S_huge(__bytes))
+          return (__bytes + __detail::__simd_huge_page_size - 1)
+                   / __detail::__simd_huge_page_size * __detail::__simd_huge_page_size;
+        else
+          return __bytes;
+      }
+
+      static constexpr align_val_t
+      _S_align_val(size_t __bytes) noexcept
+      { return align_val_t(_S_huge(__bytes) ? __detail::__simd_huge_page_size : _S_alignment); }
+
+    public:
+      using value_type = _Tp;
+
+      using size_type = size_t;
+
+      using difference_type = ptrdiff_t;
+
+      using propagate_on_container_move_assignment = true_type;
+
+      using is_always_equal = true_type;
+
+      /// The alignment of every allocation.
+      static constexpr size_t alignment = _S_alignment;
+
+      /// Every allocation is a multiple of simd_size elements.
+      static constexpr auto simd_size = __detail::__ic<_Vp::size()>;
+
+      constexpr simd_allocator() noexcept = default;
+
+      template <typename _Up>
+        constexpr
+        simd_allocator(const simd_allocator<_Up, _Vp>&) noexcept
+        {}
+
+      /// The number of elements actually allocated by allocate(@p __n).
+      static constexpr size_t
+      padded_size(size_t __n) noexcept
+      { return _S_padded_size(__n); }
+
+      [[nodiscard]] _Tp*
+      allocate(size_t __n)
+      {
+        // _S_bytes must not overflow when rounding up to a multiple of the huge page size
+        if (__n > (size_t(-1) - __detail::__simd_huge_page_size) / sizeof(_Tp) - _S_width)
+          __throw_bad_array_new_length();
+        const size_t __bytes = _S_bytes(__n);
+        _Tp* __p = static_cast<_Tp*>(::operator new(__bytes, _S_align_val(__bytes)));
+#if defined MADV_HUGEPAGE
+        if (_S_huge(__bytes))
+          ::madvise(__p, __bytes, MADV_HUGEPAGE);
+#endif
+        // only the padding up to the multiple of _S_width, the rest of a huge page allocation is
+        // never accessed (and not faulted in)
+        std::memset(static_cast<void*>(__p + __n), 0, (_S_padded_size(__n) - __n) * sizeof(_Tp));
+        return __p;
+      }
+
+      void
+      deallocate(_Tp* __p, size_t __n) noexcept
+      {
+        const size_t __bytes = _S_bytes(__n);
+        ::operator delete(__p, __bytes, _S_align_val(__bytes));
+      }
+
+      template <typename _Up>
+        friend constexpr bool
+        operator==(const simd_allocator&, const simd_allocator<_Up, _Vp>&) noexcept
+        { return true; }
+    };
+
+  template <__detail::__vectorizable _Tp, __detail::__simd_type _Vp = simd<_Tp>>
+    class simd_buffer
+    {
+      using _Alloc = simd_allocator<_Tp, _Vp>;
+
+      _Tp* _M_data = nullptr;
+
+      size_t _M_size = 0;
+
+    public:
+      using value_type = _Tp;
+
+      using size_type = size_t;
+
+      using allocator_type = _Alloc;
+
+      using iterator = _Tp*;
+
+      using const_iterator = const _Tp*;
+
+      static constexpr auto simd_size = _Alloc::simd_size;
+
+      /// The alignment of data().
+      static constexpr size_t alignment = _Alloc::alignment;
+
+      simd_buffer() = default;
+
+      /// @p __n zero-initialized elements.
+      explicit
+      simd_buffer(size_t __n)
+      : _M_data(_Alloc().allocate(__n)), _M_size(__n)
+      { std::memset(static_cast<void*>(_M_data), 0, __n * sizeof(_Tp)); }
+
+      simd_buffer(size_t __n, const _Tp& __value)
+      : _M_data(_Alloc().allocate(__n)), _M_size(__n)
+      { std::fill_n(_M_data, __n, __value); }
+
+      /// @p __n elements with indeterminate values (the padding is zero). The pages of large
+      /// buffers are not touched, e.g. for a NUMA first-touch policy (see simd_first_touch).
+      static simd_buffer
+      for_overwrite(size_t __n)
+      {
+        simd_buffer __r;
+        __r._M_data = _Alloc().allocate(__n);
+        __r._M_size = __n;
+        return __r;
+      }
+
+      simd_buffer(initializer_list<_Tp> __init)
+      : _M_data(_Alloc().allocate(__init.size())), _M_size(__init.size())
+      { std::copy(__init.begin(), __init.end(), _M_data); }
+
+      simd_buffer(const simd_buffer& __other)
+      : _M_data(__other._M_data ? _Alloc().allocate(__other._M_size) : nullptr),
+        _M_size(__other._M_size)
+      {
+        if (_M_size > 0)
+          std::memcpy(_M_data, __other._M_data, _M_size * sizeof(_Tp));
+      }
+
+      simd_buffer(simd_buffer&& __other) noexcept
+      : _M_data(std::exchange(__other._M_data, nullptr)),
+        _M_size(std::exchange(__other._M_size, 0))
+      {}
+
+      simd_buffer&
+      operator=(simd_buffer __other) noexcept
+      {
+        std::swap(_M_data, __other._M_data);
+        std::swap(_M_size, __other._M_size);
+        return *this;
+      }
+
+      ~simd_buffer()
+      {
+        if (_M_data)
+          _Alloc().deallocate(_M_data, _M_size);
+      }
+
+      size_t
+      size() const noexcept
+      { return _M_size; }
+
+      /// size() rounded up to a multiple of simd_size; the elements past size() are zero.
+      size_t
+      padded_size() const noexcept
+      { return _Alloc::padded_size(_M_size); }
+
+      bool
+      empty() const noexcept
+      { return _M_size == 0; }
+
+      _Tp*
+      data() noexcept
+      { return _M_data; }
+
+      const _Tp*
+      data() const noexcept
+      { return _M_data; }
+
+      _Tp&
+      operator[](size_t __i) noexcept
+      { return _M_data[__i]; }
+
+      const _Tp&
+      operator[](size_t __i) const noexcept
+      { return _M_data[__i]; }
+
+      iterator
+      begin() noexcept
+      { return _M_data; }
+
+      const_iterator
+      begin() const noexcept
+      { return _M_data; }
+
+      iterator
+      end() noexcept
+      { return _M_data + _M_size; }
+
+      const_iterator
+      end() const noexcept
+      { return _M_data + _M_size; }
+
+      operator span<_Tp>() noexcept
+      { return {_M_data, _M_size}; }
+
+      operator span<const _Tp>() const noexcept
+      { return {_M_data, _M_size}; }
+
+      /// The buffer including its padding, for full-width loads and stores of the last chunk.
+      /// Stores to the padding must write zeros to keep the zero padding invariant.
+      span<_Tp>
+      padded() noexcept
+      { return {_M_data, padded_size()}; }
+
+      span<const _Tp>
+      padded() const noexcept
+      { return {_M_data, padded_size()}; }
+    };
+}
+
+#endif  // PROTOTYPE_SIMD_ALLOCATOR_H_
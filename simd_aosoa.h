@@ -0,0 +1,145 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_AOSOA_H_
+#define PROTOTYPE_SIMD_AOSOA_H_
+
+#include "simd_vector.h"
+
+/* An array-of-structs-of-simd container
+ * =====================================
+ *
+ * simd_aosoa<S, N> stores blocks of N elements. Each block holds the N values of the first member
+ * of S, followed by the N values of the second member, etc. Thus, a chunk of N elements is a
+ * single contiguous block of memory (one TLB entry and one prefetch stream) while every member is
+ * still loaded with a single aligned load without shuffles.
+ *
+ * The members of S are found via the tuple protocol, as for simd_vector. The interface is the
+ * same as simd_vector's (including the std::pmr::memory_resource support), except that there are
+ * no contiguous columns: both share __detail::_SimdContainer and differ only in the storage.
+ * Elements past the end of the last block are always zero.
+ */
+
+namespace std
+{
+  namespace __detail
+  {
+    // The storage of simd_aosoa: one allocation of blocks of _Np elements, each block holding the
+    // _Np values of every member in turn, every member aligned to its simd_alignment_v.
+    template <typename _Struct, _SimdSizeType _Np>
+      struct _SimdAosoaStorage
+      {
+        static constexpr size_t _S_members = tuple_size_v<_Struct>;
+
+        using _Seq = make_index_sequence<_S_members>;
+
+        template <size_t _Ip>
+          using _Member = __struct_member_t<_Struct, _Ip>;
+
+        template <size_t _Ip>
+          static constexpr size_t _S_alignment = simd_alignment_v<simd<_Member<_Ip>, _Np>>;
+
+        static constexpr size_t _S_block_alignment = [] {
+          return [&]<size_t... _Is>(index_sequence<_Is...>) {
+            return std::max({_S_alignment<_Is>...});
+          }(_Seq());
+        }();
+
+        // byte offset of member _Ip inside a block and the size of a block (in bytes)
+        static constexpr auto _S_layout = [] {
+          array<size_t, _S_members + 1> __r = {};
+          size_t __offset = 0;
+          [&]<size_t... _Is>(index_sequence<_Is...>) {
+            (([&] {
+               __offset = (__offset + _S_alignment<_Is> - 1) / _S_alignment<_Is>
+                            * _S_alignment<_Is>;
+               __r[_Is] = __offset;
+               __offset += _Np * sizeof(_Member<_Is>);
+             }()), ...);
+          }(_Seq());
+          __r[_S_members] = (__offset + _S_block_alignment - 1) / _S_block_alignment
+                              * _S_block_alignment;
+          return __r;
+        }();
+
+        static constexpr size_t _S_block_bytes = _S_layout[_S_members];
+
+        // every member of every block is aligned to its simd_alignment_v
+        template <size_t _Ip>
+          static constexpr bool _S_chunks_aligned = true;
+
+        byte* _M_data = nullptr;
+
+        static constexpr size_t
+        _S_bytes(size_t __n) noexcept
+        { return (__n + _Np - 1) / _Np * _S_block_bytes; }
+
+        template <size_t _Ip>
+          _Member<_Ip>*
+          _M_member_ptr(size_t __i) const noexcept
+          {
+            return reinterpret_cast<_Member<_Ip>*>(_M_data + __i / _Np * _S_block_bytes
+                                                     + _S_layout[_Ip])
+                     + __i % _Np;
+          }
+
+        void
+        _M_reallocate(pmr::memory_resource* __r, size_t __size, size_t __capacity,
+                      size_t __new_capacity)
+        {
+          const size_t __bytes = _S_bytes(__new_capacity);
+          const size_t __used = _S_bytes(__size);
+          byte* __data = static_cast<byte*>(__r->allocate(__bytes, _S_block_alignment));
+          if (__used > 0)
+            std::memcpy(__data, _M_data, __used);
+          std::memset(__data + __used, 0, __bytes - __used);
+          _M_free(__r, __capacity);
+          _M_data = __data;
+        }
+
+        void
+        _M_free(pmr::memory_resource* __r, size_t __capacity) noexcept
+        {
+          if (_M_data)
+            __r->deallocate(_M_data, _S_bytes(__capacity), _S_block_alignment);
+        }
+
+        // copies the first __size elements (whole blocks) into storage of sufficient capacity
+        void
+        _M_copy(const _SimdAosoaStorage& __other, size_t __size) noexcept
+        {
+          if (__size > 0)
+            std::memcpy(_M_data, __other._M_data, _S_bytes(__size));
+        }
+
+        void
+        _M_zero(size_t __first, size_t __last) noexcept
+        {
+          while (__first < __last)
+            {
+              const size_t __n = std::min(__last, __first / _Np * _Np + _Np) - __first;
+              [&]<size_t... _Is>(index_sequence<_Is...>) {
+                (std::memset(_M_member_ptr<_Is>(__first), 0, __n * sizeof(_Member<_Is>)), ...);
+              }(_Seq());
+              __first += __n;
+            }
+        }
+      };
+  }
+
+  template <__detail::__simd_reflectable _Struct,
+            __detail::_SimdSizeType _Np = simd_size_v<remove_cvref_t<tuple_element_t<0, _Struct>>>>
+    class simd_aosoa
+    : public __detail::_SimdContainer<_Struct, _Np, __detail::_SimdAosoaStorage<_Struct, _Np>>
+    {
+      using _Base
+        = __detail::_SimdContainer<_Struct, _Np, __detail::_SimdAosoaStorage<_Struct, _Np>>;
+
+    public:
+      using _Base::_Base;
+    };
+}
+
+#endif  // PROTOTYPE_SIMD_AOSOA_H_
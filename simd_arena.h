@@ -0,0 +1,255 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_ARENA_H_
+#define PROTOTYPE_SIMD_ARENA_H_
+
+#include "simd.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+
+/* A bump allocator for short-lived simd scratch memory
+ * ====================================================
+ *
+ * simd_arena hands out aligned spans from a list of blocks by bumping a pointer. Nothing is freed
+ * individually; reset() makes all memory available again (e.g. once per batch) while keeping the
+ * blocks, so that after warm-up no call reaches operator new. Since reset() does not call
+ * destructors, only trivially destructible types can be allocated.
+ *
+ * simd_arena_resource adapts a simd_arena to std::pmr::memory_resource, e.g. for pmr containers
+ * or simd_vector.
+ *
+ * this_thread_simd_arena() returns a thread_local arena, which kernels can use without
+ * synchronization.
+ */
+
+namespace std
+{
+  namespace __detail
+  {
+    // the default simd type for simd_arena::allocate<_Tp>
+    template <typename _Tp>
+      struct __arena_simd
+      { using type = void; };
+
+    template <__vectorizable _Tp>
+      struct __arena_simd<_Tp>
+      { using type = simd<_Tp>; };
+  }
+
+  class simd_arena
+  {
+    struct _Block
+    {
+      _Block* _M_next;
+
+      size_t _M_bytes;
+    };
+
+    // the alignment of the blocks and the offset of the first usable byte in a block
+    static constexpr size_t _S_block_alignment = 64;
+
+    static constexpr size_t _S_header = _S_block_alignment;
+
+    _Block* _M_first = nullptr;
+
+    _Block* _M_current = nullptr;
+
+    byte* _M_ptr = nullptr;
+
+    byte* _M_end = nullptr;
+
+    size_t _M_next_bytes;
+
+    static byte*
+    _S_begin(_Block* __b) noexcept
+    { return reinterpret_cast<byte*>(__b) + _S_header; }
+
+    static byte*
+    _S_end(_Block* __b) noexcept
+    { return _S_begin(__b) + __b->_M_bytes; }
+
+    void
+    _M_enter(_Block* __b) noexcept
+    {
+      _M_current = __b;
+      _M_ptr = _S_begin(__b);
+      _M_end = _S_end(__b);
+    }
+
+    // the largest block size: _S_header + size must not exceed PTRDIFF_MAX (also leaving room for
+    // the rounding to the alignment in operator new)
+    static constexpr size_t _S_max_bytes = size_t(-1) / 2 - _S_header;
+
+    // Moves on to the next block that can hold __bytes with __alignment, allocating it if needed.
+    [[gnu::noinline, gnu::cold]] void*
+    _M_allocate_slow(size_t __bytes, size_t __alignment)
+    {
+      const size_t __extra = __alignment > _S_block_alignment ? __alignment : 0;
+      if (__bytes > _S_max_bytes - __extra)
+        __throw_bad_alloc();
+      const size_t __needed = __bytes + __extra;
+      _Block* __prev = _M_current;
+      while (__prev and __prev->_M_next and __prev->_M_next->_M_bytes < __needed)
+        __prev = __prev->_M_next;
+      if (__prev and __prev->_M_next)
+        _M_enter(__prev->_M_next);
+      else
+        {
+          const size_t __n = std::max(__needed, std::min(_M_next_bytes, _S_max_bytes));
+          _M_next_bytes = __n <= _S_max_bytes / 2 ? 2 * __n : _S_max_bytes;
+          _Block* __b = static_cast<_Block*>(::operator new(_S_header + __n,
+                                                            align_val_t(_S_block_alignment)));
+          __b->_M_bytes = __n;
+          __b->_M_next = nullptr;
+          if (__prev)
+            __prev->_M_next = __b;
+          else
+            _M_first = __b;
+          _M_enter(__b);
+        }
+      return allocate_bytes(__bytes, __alignment);
+    }
+
+  public:
+    /// The first block holds @p __initial_bytes; every following block is twice as large.
+    explicit
+    simd_arena(size_t __initial_bytes = size_t(64) << 10) noexcept
+    : _M_next_bytes(__initial_bytes)
+    {}
+
+    simd_arena(const simd_arena&) = delete;
+
+    simd_arena&
+    operator=(const simd_arena&) = delete;
+
+    ~simd_arena()
+    {
+      for (_Block* __b = _M_first; __b;)
+        {
+          _Block* __next = __b->_M_next;
+          ::operator delete(__b, _S_header + __b->_M_bytes, align_val_t(_S_block_alignment));
+          __b = __next;
+        }
+    }
+
+    /// Returns @p __bytes of uninitialized memory aligned to @p __alignment (a power of 2).
+    /// Throws bad_alloc if no block can hold @p __bytes.
+    [[nodiscard]] _GLIBCXX_SIMD_ALWAYS_INLINE void*
+    allocate_bytes(size_t __bytes, size_t __alignment = alignof(max_align_t))
+    {
+      const uintptr_t __p = reinterpret_cast<uintptr_t>(_M_ptr);
+      const uintptr_t __aligned = (__p + __alignment - 1) & ~uintptr_t(__alignment - 1);
+      const uintptr_t __end = reinterpret_cast<uintptr_t>(_M_end);
+      if (_M_ptr and __aligned <= __end and __bytes <= __end - __aligned) [[likely]]
+        {
+          _M_ptr = reinterpret_cast<byte*>(__aligned + __bytes);
+          return reinterpret_cast<void*>(__aligned);
+        }
+      return _M_allocate_slow(__bytes, __alignment);
+    }
+
+    /**
+     * Returns a span of @p __n default-initialized objects of type _Tp.
+     *
+     * If _Tp is a vectorizable type, the span is aligned to simd_alignment_v<_Vp> and followed by
+     * zeros up to the next multiple of _Vp::size() elements. Thus, it can be loaded and stored with
+     * full-width loads and stores of _Vp, as memory from simd_allocator.
+     *
+     * Throws bad_array_new_length if the size in bytes is not representable in size_t.
+     */
+    template <typename _Tp, typename _Vp = typename __detail::__arena_simd<_Tp>::type>
+      requires is_trivially_destructible_v<_Tp>
+      [[nodiscard]] span<_Tp>
+      allocate(size_t __n)
+      {
+        if constexpr (is_void_v<_Vp>)
+          {
+            if (__n > size_t(-1) / sizeof(_Tp))
+              __throw_bad_array_new_length();
+            _Tp* __p = static_cast<_Tp*>(allocate_bytes(__n * sizeof(_Tp), alignof(_Tp)));
+            std::uninitialized_default_construct_n(__p, __n);
+            return {__p, __n};
+          }
+        else
+          {
+            constexpr size_t __w = _Vp::size();
+            if (__n > size_t(-1) / sizeof(_Tp) - __w)
+              __throw_bad_array_new_length();
+            const size_t __padded = (__n + __w - 1) / __w * __w;
+            _Tp* __p = static_cast<_Tp*>(
+                         allocate_bytes(__padded * sizeof(_Tp),
+                                        std::max(simd_alignment_v<_Vp>, alignof(_Tp))));
+            std::memset(static_cast<void*>(__p + __n), 0, (__padded - __n) * sizeof(_Tp));
+            return {__p, __n};
+          }
+      }
+
+    /// Makes all memory available again, keeping the blocks. Invalidates all previous allocations.
+    void
+    reset() noexcept
+    {
+      if (_M_first)
+        _M_enter(_M_first);
+    }
+
+    /// The sum of the sizes of all blocks.
+    size_t
+    capacity() const noexcept
+    {
+      size_t __r = 0;
+      for (const _Block* __b = _M_first; __b; __b = __b->_M_next)
+        __r += __b->_M_bytes;
+      return __r;
+    }
+  };
+
+  /// A memory_resource allocating from a simd_arena. deallocate is a no-op.
+  class simd_arena_resource : public pmr::memory_resource
+  {
+    simd_arena* _M_arena;
+
+  public:
+    explicit
+    simd_arena_resource(simd_arena& __arena) noexcept
+    : _M_arena(&__arena)
+    {}
+
+    simd_arena&
+    arena() const noexcept
+    { return *_M_arena; }
+
+  private:
+    void*
+    do_allocate(size_t __bytes, size_t __alignment) override
+    { return _M_arena->allocate_bytes(__bytes, __alignment); }
+
+    void
+    do_deallocate(void*, size_t, size_t) noexcept override
+    {}
+
+    bool
+    do_is_equal(const pmr::memory_resource& __other) const noexcept override
+    {
+      const simd_arena_resource* __r = dynamic_cast<const simd_arena_resource*>(&__other);
+      return __r and __r->_M_arena == _M_arena;
+    }
+  };
+
+  /// An arena per thread.
+  inline simd_arena&
+  this_thread_simd_arena() noexcept
+  {
+    static thread_local simd_arena __arena;
+    return __arena;
+  }
+}
+
+#endif  // PROTOTYPE_SIMD_ARENA_H_
@@ -0,0 +1,161 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_BIT_H_
+#define PROTOTYPE_SIMD_BIT_H_
+
+#include "simd.h"
+
+// Element-wise <bit> functions for integer simds (cf. P2933). Counts are returned as simd of the
+// signed integer type of equal size. bit_reverse is an extension.
+
+namespace std
+{
+  namespace __detail
+  {
+    template <typename _Tp, typename _Abi>
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<make_signed_t<_Tp>, _Abi>
+      __as_signed_count(const basic_simd<_Tp, _Abi>& __x)
+      {
+        using _Rp = basic_simd<make_signed_t<_Tp>, _Abi>;
+        if constexpr (is_signed_v<_Tp>)
+          return __x;
+        else
+          {
+            // signed and unsigned integers of equal size have equal storage layout
+            static_assert(sizeof(_Rp) == sizeof(__x));
+            return __builtin_bit_cast(_Rp, __x);
+          }
+      }
+  }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    requires is_unsigned_v<_Tp>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<make_signed_t<_Tp>, _Abi>
+    popcount(const basic_simd<_Tp, _Abi>& __x) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      return __detail::__as_signed_count(
+               basic_simd<_Tp, _Abi>(__detail::__private_init, _Impl::_S_popcount(__data(__x))));
+    }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    requires is_unsigned_v<_Tp>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<make_signed_t<_Tp>, _Abi>
+    countl_zero(const basic_simd<_Tp, _Abi>& __x) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      return __detail::__as_signed_count(
+               basic_simd<_Tp, _Abi>(__detail::__private_init, _Impl::_S_countl_zero(__data(__x))));
+    }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    requires is_unsigned_v<_Tp>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<make_signed_t<_Tp>, _Abi>
+    countl_one(const basic_simd<_Tp, _Abi>& __x) noexcept
+    { return countl_zero(~__x); }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    requires is_unsigned_v<_Tp>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<make_signed_t<_Tp>, _Abi>
+    countr_zero(const basic_simd<_Tp, _Abi>& __x) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      return __detail::__as_signed_count(
+               basic_simd<_Tp, _Abi>(__detail::__private_init, _Impl::_S_countr_zero(__data(__x))));
+    }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    requires is_unsigned_v<_Tp>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<make_signed_t<_Tp>, _Abi>
+    countr_one(const basic_simd<_Tp, _Abi>& __x) noexcept
+    { return countr_zero(~__x); }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    requires is_unsigned_v<_Tp>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<make_signed_t<_Tp>, _Abi>
+    bit_width(const basic_simd<_Tp, _Abi>& __x) noexcept
+    {
+      using _Rp = basic_simd<make_signed_t<_Tp>, _Abi>;
+      return _Rp(make_signed_t<_Tp>(sizeof(_Tp) * __CHAR_BIT__)) - countl_zero(__x);
+    }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    requires is_unsigned_v<_Tp>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr typename basic_simd<_Tp, _Abi>::mask_type
+    has_single_bit(const basic_simd<_Tp, _Abi>& __x) noexcept
+    { return __x != _Tp() and (__x & (__x - _Tp(1))) == _Tp(); }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+    byteswap(const basic_simd<_Tp, _Abi>& __x) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      return {__detail::__private_init, _Impl::_S_byteswap(__data(__x))};
+    }
+
+  /**
+   * Reverses the order of the bits in every element.
+   */
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    requires is_unsigned_v<_Tp>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+    bit_reverse(const basic_simd<_Tp, _Abi>& __x) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      return {__detail::__private_init, _Impl::_S_bit_reverse(__data(__x))};
+    }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    requires is_unsigned_v<_Tp>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+    rotl(const basic_simd<_Tp, _Abi>& __x, int __s) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      return {__detail::__private_init, _Impl::_S_rotl(__data(__x), __s)};
+    }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    requires is_unsigned_v<_Tp>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+    rotr(const basic_simd<_Tp, _Abi>& __x, int __s) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      // rotr(x, s) == rotl(x, -s); reduce s modulo the (power-of-2) number of bits first, since
+      // -s overflows for INT_MIN
+      constexpr unsigned __bits = sizeof(_Tp) * __CHAR_BIT__;
+      const int __r = int(unsigned(__s) % __bits);
+      return {__detail::__private_init, _Impl::_S_rotl(__data(__x), -__r)};
+    }
+
+  /**
+   * Rotates every element of @p __x by the corresponding element of @p __s.
+   */
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi,
+            __detail::__signed_or_unsigned_integer _Up>
+    requires is_unsigned_v<_Tp> and (sizeof(_Up) == sizeof(_Tp))
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+    rotl(const basic_simd<_Tp, _Abi>& __x, const basic_simd<_Up, _Abi>& __s) noexcept
+    {
+      using _V = basic_simd<_Tp, _Abi>;
+      constexpr _Tp __mask = sizeof(_Tp) * __CHAR_BIT__ - 1;
+      const _V __su = __builtin_bit_cast(_V, __s);
+      return (__x << (__su & __mask)) | (__x >> (-__su & __mask));
+    }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi,
+            __detail::__signed_or_unsigned_integer _Up>
+    requires is_unsigned_v<_Tp> and (sizeof(_Up) == sizeof(_Tp))
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+    rotr(const basic_simd<_Tp, _Abi>& __x, const basic_simd<_Up, _Abi>& __s) noexcept
+    {
+      using _V = basic_simd<_Tp, _Abi>;
+      constexpr _Tp __mask = sizeof(_Tp) * __CHAR_BIT__ - 1;
+      const _V __su = __builtin_bit_cast(_V, __s);
+      return (__x >> (__su & __mask)) | (__x << (-__su & __mask));
+    }
+}
+
+#endif  // PROTOTYPE_SIMD_BIT_H_
@@ -272,14 +272,15 @@ namespace std::__detail
             }
         }
 
-      template <__vec_builtin _TV, typename _Up>
+      template <__vec_builtin _TV, typename _Up, typename... _Fs>
         static constexpr inline _TV
-        _S_masked_load(_TV __merge, _MaskMember<_TV> __k, const _Up* __mem)
+        _S_masked_load(_TV __merge, _MaskMember<_TV> __k, const _Up* __mem,
+                       simd_flags<_Fs...> = {})
         {
           _S_bit_iteration(
             _SuperImpl::_S_to_bits(__k),
             [&] [[__gnu__::__always_inline__]] (auto __i) {
-              __merge._M_set(__i, static_cast<__value_type_of<_TV>>(__mem[__i]));
+              __merge[__i] = static_cast<__value_type_of<_TV>>(__mem[__i]);
             });
           return __merge;
         }
@@ -451,6 +452,201 @@ namespace std::__detail
         _S_minmax(_TV __x, _TV __y)
         { return {__x < __y ? __x : __y, __x < __y ? __y : __x}; }
 
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_add_sat(_TV __x, _TV __y)
+        {
+          using _Tp = __value_type_of<_TV>;
+          using _UV = __vec_builtin_type_bytes<__make_unsigned_int_t<_Tp>, sizeof(_TV)>;
+          const _TV __r = reinterpret_cast<_TV>(reinterpret_cast<_UV>(__x)
+                                                  + reinterpret_cast<_UV>(__y));
+          if constexpr (is_unsigned_v<_Tp>)
+            return __r | reinterpret_cast<_TV>(__r < __x);
+          else
+            {
+              // overflow iff __x and __y have equal sign and __r has the opposite sign
+              const _TV __sat = (__x >> (sizeof(_Tp) * __CHAR_BIT__ - 1)) ^ __finite_max_v<_Tp>;
+              return ((__x ^ __r) & (__y ^ __r)) < 0 ? __sat : __r;
+            }
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_sub_sat(_TV __x, _TV __y)
+        {
+          using _Tp = __value_type_of<_TV>;
+          using _UV = __vec_builtin_type_bytes<__make_unsigned_int_t<_Tp>, sizeof(_TV)>;
+          const _TV __r = reinterpret_cast<_TV>(reinterpret_cast<_UV>(__x)
+                                                  - reinterpret_cast<_UV>(__y));
+          if constexpr (is_unsigned_v<_Tp>)
+            return __vec_and(__r, reinterpret_cast<_TV>(__r <= __x));
+          else
+            {
+              // overflow iff __x and __y have different sign and __r has the sign of __y
+              const _TV __sat = (__x >> (sizeof(_Tp) * __CHAR_BIT__ - 1)) ^ __finite_max_v<_Tp>;
+              return ((__x ^ __y) & (__x ^ __r)) < 0 ? __sat : __r;
+            }
+        }
+
+      // (__x + __y + 1) >> 1 without overflow
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_avg(_TV __x, _TV __y)
+        { return __vec_or(__x, __y) - (__vec_xor(__x, __y) >> 1); }
+
+      // |__x - __y| as the unsigned integer of equal size, stored in _TV
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_abs_diff(_TV __x, _TV __y)
+        {
+          using _UV = __vec_builtin_type_bytes<__make_unsigned_int_t<__value_type_of<_TV>>,
+                                               sizeof(_TV)>;
+          return reinterpret_cast<_TV>(reinterpret_cast<_UV>(_SuperImpl::_S_max(__x, __y))
+                                         - reinterpret_cast<_UV>(_SuperImpl::_S_min(__x, __y)));
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr __sad_result_t<__value_type_of<_TV>>
+        _S_sad(_TV __x, _TV __y)
+        {
+          using _Tp = __value_type_of<_TV>;
+          using _Rp = __sad_result_t<_Tp>;
+          using _Up = __make_unsigned_int_t<_Tp>;
+          const _TV __d = _SuperImpl::_S_abs_diff(__x, __y);
+          return _GLIBCXX_SIMD_INT_PACK(_S_size, _Is, {
+                   return static_cast<_Rp>((_Rp(_Up(__d[_Is])) + ...));
+                 });
+        }
+
+      // upper half of the double-width product __x * __y
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_mulhi(_TV __x, _TV __y)
+        {
+          using _Tp = __value_type_of<_TV>;
+          constexpr int __bits = sizeof(_Tp) * __CHAR_BIT__;
+          if constexpr (sizeof(_Tp) < 8)
+            {
+              using _Up = typename __make_unsigned_int<2 * sizeof(_Tp)>::type;
+              using _Wp = conditional_t<is_signed_v<_Tp>, make_signed_t<_Up>, _Up>;
+              using _WV = __vec_builtin_type<_Wp, __width_of<_TV>>;
+              return __builtin_convertvector((__builtin_convertvector(__x, _WV)
+                                                * __builtin_convertvector(__y, _WV)) >> __bits,
+                                             _TV);
+            }
+          else
+            {
+              using _Wp = conditional_t<is_signed_v<_Tp>, __int128, unsigned __int128>;
+              return _GLIBCXX_SIMD_VEC_GEN(_TV, __width_of<_TV>, _Is, {
+                       _Tp((_Wp(__x[_Is]) * __y[_Is]) >> __bits)...
+                     });
+            }
+        }
+
+      // element-wise <bit> functions, the counts are returned as _TV
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_popcount(_TV __x)
+        {
+          using _Up = __make_unsigned_int_t<__value_type_of<_TV>>;
+          using _UV = __vec_builtin_type_bytes<_Up, sizeof(_TV)>;
+          constexpr _Up __m1 = _Up(~_Up()) / 3;
+          constexpr _Up __m2 = _Up(~_Up()) / 5;
+          constexpr _Up __m4 = _Up(~_Up()) / 17;
+          _UV __v = reinterpret_cast<_UV>(__x);
+          __v -= (__v >> 1) & __m1;
+          __v = (__v & __m2) + ((__v >> 2) & __m2);
+          __v = (__v + (__v >> 4)) & __m4;
+          if constexpr (sizeof(_Up) > 1)
+            // sum up the bytes in the most significant byte
+            __v = (__v * _Up(_Up(~_Up()) / 255)) >> ((sizeof(_Up) - 1) * __CHAR_BIT__);
+          return reinterpret_cast<_TV>(__v);
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_countl_zero(_TV __x)
+        {
+          using _Up = __make_unsigned_int_t<__value_type_of<_TV>>;
+          using _UV = __vec_builtin_type_bytes<_Up, sizeof(_TV)>;
+          // set all bits below the highest set bit, the zeros are the leading zeros
+          _UV __v = reinterpret_cast<_UV>(__x);
+          for (int __s = 1; __s < int(sizeof(_Up) * __CHAR_BIT__); __s *= 2)
+            __v |= __v >> __s;
+          return _SuperImpl::_S_popcount(reinterpret_cast<_TV>(~__v));
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_countr_zero(_TV __x)
+        {
+          using _UV = __vec_builtin_type_bytes<__make_unsigned_int_t<__value_type_of<_TV>>,
+                                               sizeof(_TV)>;
+          const _UV __v = reinterpret_cast<_UV>(__x);
+          return _SuperImpl::_S_popcount(reinterpret_cast<_TV>(~__v & (__v - 1)));
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_byteswap(_TV __x)
+        {
+          constexpr int __n = sizeof(__value_type_of<_TV>);
+          if constexpr (__n == 1)
+            return __x;
+          else
+            {
+              using _BV = __vec_builtin_type_bytes<unsigned char, sizeof(_TV)>;
+              const _BV __b = reinterpret_cast<_BV>(__x);
+              return reinterpret_cast<_TV>(_GLIBCXX_SIMD_INT_PACK(sizeof(_TV), _Is, {
+                       return __builtin_shufflevector(__b, __b,
+                                                      (_Is - _Is % __n + __n - 1 - _Is % __n)...);
+                     }));
+            }
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_bit_reverse(_TV __x)
+        {
+          using _Up = __make_unsigned_int_t<__value_type_of<_TV>>;
+          using _UV = __vec_builtin_type_bytes<_Up, sizeof(_TV)>;
+          constexpr _Up __m1 = _Up(~_Up()) / 3;
+          constexpr _Up __m2 = _Up(~_Up()) / 5;
+          constexpr _Up __m4 = _Up(~_Up()) / 17;
+          _UV __v = reinterpret_cast<_UV>(_SuperImpl::_S_byteswap(__x));
+          __v = ((__v >> 1) & __m1) | ((__v & __m1) << 1);
+          __v = ((__v >> 2) & __m2) | ((__v & __m2) << 2);
+          __v = ((__v >> 4) & __m4) | ((__v & __m4) << 4);
+          return reinterpret_cast<_TV>(__v);
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_rotl(_TV __x, int __s)
+        {
+          using _Up = __make_unsigned_int_t<__value_type_of<_TV>>;
+          using _UV = __vec_builtin_type_bytes<_Up, sizeof(_TV)>;
+          constexpr int __bits = sizeof(_Up) * __CHAR_BIT__;
+          const _UV __v = reinterpret_cast<_UV>(__x);
+          // unsigned, since -__s overflows for INT_MIN
+          const unsigned __u = __s;
+          return reinterpret_cast<_TV>(
+                   __vec_or(_SuperImpl::_S_bit_shift_left(__v, int(__u & (__bits - 1))),
+                            _SuperImpl::_S_bit_shift_right(__v, int(-__u & (__bits - 1)))));
+        }
+
       // frexp, modf and copysign implemented in simd_math.h
 #define _GLIBCXX_SIMD_MATH_FALLBACK(__name)                                                        \
       template <__vec_builtin _TV, __vec_builtin... _More>                                         \
@@ -635,6 +831,27 @@ namespace std::__detail
         _S_plus_minus(_TV __x, _UV __y)
         { return __builtin_assoc_barrier(__x + __y) - __y; }
 
+      // x - y in even and x + y in odd elements (interleaved complex arithmetic)
+      template <__vec_builtin _TV>
+        requires floating_point<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_addsub(_TV __x, _TV __y)
+        {
+          constexpr int __n = __width_of<_TV>;
+          const _TV __sub = __x - __y;
+          const _TV __add = __x + __y;
+          return _GLIBCXX_SIMD_INT_PACK(__n, _Is, {
+                   return __builtin_shufflevector(__sub, __add, (_Is + (_Is & 1) * __n)...);
+                 });
+        }
+
+      // x * y - z in even and x * y + z in odd elements
+      template <__vec_builtin _TV>
+        requires floating_point<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_fmaddsub(_TV __x, _TV __y, _TV __z)
+        { return _SuperImpl::_S_addsub(__x * __y, __z); }
+
       template <__vec_builtin _TV>
         _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
         _S_nearbyint(const _TV __x)
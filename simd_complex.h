@@ -0,0 +1,379 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_COMPLEX_H_
+#define PROTOTYPE_SIMD_COMPLEX_H_
+
+#include "simd.h"
+#include "permute.h"
+
+#include <complex>
+
+// A simd of std::complex<float|double> values. The interleaved layout stores (re, im) pairs next
+// to each other, exactly like an array of std::complex, and multiplies via fmaddsub/addsub. The
+// split layout stores all real parts and all imaginary parts in separate simds, which makes
+// arithmetic cheaper but loads and stores more expensive.
+//
+// Multiplication and division use the textbook formulas, i.e. they behave like
+// -fcx-limited-range (no recovery of infinities from NaN results, no scaling in division).
+
+namespace std
+{
+  namespace __detail
+  {
+    // x - y in even and x + y in odd elements
+    template <typename _Tp, typename _Abi>
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+      __addsub(const basic_simd<_Tp, _Abi>& __x, const basic_simd<_Tp, _Abi>& __y)
+      {
+        using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+        return {__private_init, _Impl::_S_addsub(__data(__x), __data(__y))};
+      }
+
+    // x * y - z in even and x * y + z in odd elements
+    template <typename _Tp, typename _Abi>
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+      __fmaddsub(const basic_simd<_Tp, _Abi>& __x, const basic_simd<_Tp, _Abi>& __y,
+                 const basic_simd<_Tp, _Abi>& __z)
+      {
+        using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+        return {__private_init, _Impl::_S_fmaddsub(__data(__x), __data(__y), __data(__z))};
+      }
+  }
+
+  enum class simd_complex_layout
+  {
+    interleaved,
+    split
+  };
+
+  template <__detail::__simd_type _Vp,
+            simd_complex_layout _Layout = simd_complex_layout::interleaved>
+    requires floating_point<typename _Vp::value_type>
+      and (_Layout == simd_complex_layout::split
+             or destructible<resize_simd_t<2 * _Vp::size(), _Vp>>)
+    class simd_complex
+    {
+      using _Tp = typename _Vp::value_type;
+
+      using _Interleaved = resize_simd_t<2 * _Vp::size(), _Vp>;
+
+      static constexpr bool _S_split = _Layout == simd_complex_layout::split;
+
+      struct _Split
+      {
+        _Vp _M_re;
+        _Vp _M_im;
+      };
+
+      conditional_t<_S_split, _Split, _Interleaved> _M_data;
+
+      template <__detail::__simd_type _Vp2, simd_complex_layout _L2>
+        requires floating_point<typename _Vp2::value_type>
+          and (_L2 == simd_complex_layout::split
+                 or destructible<resize_simd_t<2 * _Vp2::size(), _Vp2>>)
+        friend class simd_complex;
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr
+      simd_complex(__detail::_PrivateInit, const _Interleaved& __x) requires (not _S_split)
+      : _M_data(__x)
+      {}
+
+      // (re0, re0, re1, re1, ...)
+      _GLIBCXX_SIMD_ALWAYS_INLINE static constexpr _Interleaved
+      _S_dup_real(const _Interleaved& __x)
+      { return simd_permute(__x, simd_permutations::duplicate_even); }
+
+      // (im0, im0, im1, im1, ...)
+      _GLIBCXX_SIMD_ALWAYS_INLINE static constexpr _Interleaved
+      _S_dup_imag(const _Interleaved& __x)
+      { return simd_permute(__x, simd_permutations::duplicate_odd); }
+
+      // (im0, re0, im1, re1, ...)
+      _GLIBCXX_SIMD_ALWAYS_INLINE static constexpr _Interleaved
+      _S_swap(const _Interleaved& __x)
+      { return simd_permute(__x, simd_permutations::swap_neighbors<1>); }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE static constexpr _Interleaved
+      _S_interleave(const _Vp& __re, const _Vp& __im)
+      {
+        return _Interleaved([&](auto __i) -> _Tp {
+                 if constexpr (__i % 2 == 0)
+                   return __re[__i / 2];
+                 else
+                   return __im[__i / 2];
+               });
+      }
+
+    public:
+      using value_type = complex<_Tp>;
+
+      using real_type = _Vp;
+
+      using mask_type = typename _Vp::mask_type;
+
+      static constexpr auto size = _Vp::size;
+
+      static constexpr simd_complex_layout layout = _Layout;
+
+      constexpr
+      simd_complex() = default;
+
+      // broadcast
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr
+      simd_complex(const value_type& __x) noexcept
+      {
+        if constexpr (_S_split)
+          _M_data = {__x.real(), __x.imag()};
+        else
+          _M_data = _Interleaved([&](int __i) { return __i & 1 ? __x.imag() : __x.real(); });
+      }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr
+      simd_complex(const _Vp& __re, const _Vp& __im = _Vp()) noexcept
+      {
+        if constexpr (_S_split)
+          _M_data = {__re, __im};
+        else
+          _M_data = _S_interleave(__re, __im);
+      }
+
+      // layout conversion
+      template <simd_complex_layout _L2>
+        requires (_L2 != _Layout)
+        _GLIBCXX_SIMD_ALWAYS_INLINE constexpr explicit
+        simd_complex(const simd_complex<_Vp, _L2>& __x) noexcept
+        : simd_complex(__x.real(), __x.imag())
+        {}
+
+      // load from an array of std::complex<T>
+      template <contiguous_iterator _It, typename... _Flags>
+        requires same_as<iter_value_t<_It>, value_type>
+        _GLIBCXX_SIMD_ALWAYS_INLINE constexpr explicit
+        simd_complex(_It __first, simd_flags<_Flags...> __flags = {})
+        { copy_from(__first, __flags); }
+
+      template <contiguous_iterator _It, typename... _Flags>
+        requires same_as<iter_value_t<_It>, value_type>
+        _GLIBCXX_SIMD_ALWAYS_INLINE constexpr void
+        copy_from(_It __first, simd_flags<_Flags...> __flags = {})
+        {
+          _Interleaved __x;
+          if consteval
+            {
+              __x = _Interleaved([&](int __i) {
+                      const value_type& __c = __first[__i / 2];
+                      return __i & 1 ? __c.imag() : __c.real();
+                    });
+            }
+          else
+            {
+              // [complex.numbers.general]: complex<T> is array-compatible with T[2]
+              __x = _Interleaved(reinterpret_cast<const _Tp*>(std::to_address(__first)),
+                                 __flags);
+            }
+          if constexpr (_S_split)
+            _M_data = {simd_permute<size()>(__x, [](unsigned __i) { return 2 * __i; }),
+                       simd_permute<size()>(__x, [](unsigned __i) { return 2 * __i + 1; })};
+          else
+            _M_data = __x;
+        }
+
+      template <contiguous_iterator _It, typename... _Flags>
+        requires same_as<iter_value_t<_It>, value_type> and output_iterator<_It, value_type>
+        _GLIBCXX_SIMD_ALWAYS_INLINE constexpr void
+        copy_to(_It __first, simd_flags<_Flags...> __flags = {}) const
+        {
+          _Interleaved __x;
+          if constexpr (_S_split)
+            __x = _S_interleave(_M_data._M_re, _M_data._M_im);
+          else
+            __x = _M_data;
+          if consteval
+            {
+              for (int __i = 0; __i < size(); ++__i)
+                __first[__i] = value_type(__x[2 * __i], __x[2 * __i + 1]);
+            }
+          else
+            {
+              __x.copy_to(reinterpret_cast<_Tp*>(std::to_address(__first)), __flags);
+            }
+        }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr value_type
+      operator[](__detail::_SimdSizeType __i) const
+      {
+        if constexpr (_S_split)
+          return {_M_data._M_re[__i], _M_data._M_im[__i]};
+        else
+          return {_M_data[2 * __i], _M_data[2 * __i + 1]};
+      }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr _Vp
+      real() const noexcept
+      {
+        if constexpr (_S_split)
+          return _M_data._M_re;
+        else
+          return simd_permute<size()>(_M_data, [](unsigned __i) { return 2 * __i; });
+      }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr _Vp
+      imag() const noexcept
+      {
+        if constexpr (_S_split)
+          return _M_data._M_im;
+        else
+          return simd_permute<size()>(_M_data, [](unsigned __i) { return 2 * __i + 1; });
+      }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr simd_complex
+      operator+() const noexcept
+      { return *this; }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr simd_complex
+      operator-() const noexcept
+      {
+        simd_complex __r = *this;
+        if constexpr (_S_split)
+          __r._M_data = {-_M_data._M_re, -_M_data._M_im};
+        else
+          __r._M_data = -_M_data;
+        return __r;
+      }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE friend constexpr simd_complex
+      operator+(simd_complex __x, const simd_complex& __y) noexcept
+      {
+        if constexpr (_S_split)
+          __x._M_data = {__x._M_data._M_re + __y._M_data._M_re,
+                         __x._M_data._M_im + __y._M_data._M_im};
+        else
+          __x._M_data += __y._M_data;
+        return __x;
+      }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE friend constexpr simd_complex
+      operator-(simd_complex __x, const simd_complex& __y) noexcept
+      {
+        if constexpr (_S_split)
+          __x._M_data = {__x._M_data._M_re - __y._M_data._M_re,
+                         __x._M_data._M_im - __y._M_data._M_im};
+        else
+          __x._M_data -= __y._M_data;
+        return __x;
+      }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE friend constexpr simd_complex
+      operator*(simd_complex __x, const simd_complex& __y) noexcept
+      {
+        if constexpr (_S_split)
+          {
+            const auto& [__a, __b] = __x._M_data;
+            const auto& [__c, __d] = __y._M_data;
+            __x._M_data = {__a * __c - __b * __d, __a * __d + __b * __c};
+          }
+        else
+          __x._M_data = __detail::__fmaddsub(__x._M_data, _S_dup_real(__y._M_data),
+                                             _S_swap(__x._M_data) * _S_dup_imag(__y._M_data));
+        return __x;
+      }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE friend constexpr simd_complex
+      operator/(simd_complex __x, const simd_complex& __y) noexcept
+      {
+        if constexpr (_S_split)
+          {
+            const auto& [__a, __b] = __x._M_data;
+            const auto& [__c, __d] = __y._M_data;
+            const _Vp __n = __c * __c + __d * __d;
+            __x._M_data = {(__a * __c + __b * __d) / __n, (__b * __c - __a * __d) / __n};
+          }
+        else
+          {
+            const _Interleaved __sq = __y._M_data * __y._M_data;
+            // x * conj(y) / norm(y)
+            __x._M_data = __detail::__fmaddsub(__x._M_data, _S_dup_real(__y._M_data),
+                                               -(_S_swap(__x._M_data) * _S_dup_imag(__y._M_data)))
+                            / (__sq + _S_swap(__sq));
+          }
+        return __x;
+      }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr simd_complex&
+      operator+=(const simd_complex& __x) noexcept
+      { return *this = *this + __x; }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr simd_complex&
+      operator-=(const simd_complex& __x) noexcept
+      { return *this = *this - __x; }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr simd_complex&
+      operator*=(const simd_complex& __x) noexcept
+      { return *this = *this * __x; }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr simd_complex&
+      operator/=(const simd_complex& __x) noexcept
+      { return *this = *this / __x; }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE friend constexpr _Vp
+      real(const simd_complex& __x) noexcept
+      { return __x.real(); }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE friend constexpr _Vp
+      imag(const simd_complex& __x) noexcept
+      { return __x.imag(); }
+
+      _GLIBCXX_SIMD_ALWAYS_INLINE friend constexpr simd_complex
+      conj(simd_complex __x) noexcept
+      {
+        if constexpr (_S_split)
+          __x._M_data._M_im = -__x._M_data._M_im;
+        else
+          __x._M_data *= _Interleaved([](int __i) { return __i & 1 ? _Tp(-1) : _Tp(1); });
+        return __x;
+      }
+
+      /**
+       * Returns re² + im² for every element.
+       */
+      _GLIBCXX_SIMD_ALWAYS_INLINE friend constexpr _Vp
+      norm(const simd_complex& __x) noexcept
+      {
+        if constexpr (_S_split)
+          return __x._M_data._M_re * __x._M_data._M_re + __x._M_data._M_im * __x._M_data._M_im;
+        else
+          {
+            const _Interleaved __sq = __x._M_data * __x._M_data;
+            return simd_complex(__detail::__private_init, __sq + _S_swap(__sq)).real();
+          }
+      }
+
+      /**
+       * Returns x * y + z for every element.
+       */
+      _GLIBCXX_SIMD_ALWAYS_INLINE friend constexpr simd_complex
+      fma(const simd_complex& __x, const simd_complex& __y, simd_complex __z) noexcept
+      {
+        if constexpr (_S_split)
+          {
+            const auto& [__a, __b] = __x._M_data;
+            const auto& [__c, __d] = __y._M_data;
+            const auto& [__e, __f] = __z._M_data;
+            __z._M_data = {__a * __c - __b * __d + __e, __a * __d + __b * __c + __f};
+          }
+        else
+          {
+            // even: a.re * b.re - (a.im * b.im - c.re), odd: a.im * b.re + (a.re * b.im + c.im)
+            const _Interleaved __t = __detail::__fmaddsub(_S_swap(__x._M_data),
+                                                          _S_dup_imag(__y._M_data), __z._M_data);
+            __z._M_data = __detail::__fmaddsub(__x._M_data, _S_dup_real(__y._M_data), __t);
+          }
+        return __z;
+      }
+    };
+}
+
+#endif  // PROTOTYPE_SIMD_COMPLEX_H_
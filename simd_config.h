@@ -283,6 +283,31 @@
   _GLIBCXX_SIMD_LIST_ARITHMETICS(__macro) static_assert(true)
 #endif
 
+// Loads flagged with __simd_flag_page_safe may read past the end of the range, as long as the read
+// does not cross a page boundary. Address/memory/thread sanitizers report these reads, thus the
+// overread is disabled for sanitizer builds. Define to 0 to disable it (e.g. for valgrind).
+#ifndef _GLIBCXX_SIMD_PAGE_SAFE_OVERREAD
+#if defined __SANITIZE_ADDRESS__ or defined __SANITIZE_THREAD__
+#define _GLIBCXX_SIMD_PAGE_SAFE_OVERREAD 0
+#elif defined __has_feature
+#if __has_feature(address_sanitizer) or __has_feature(memory_sanitizer) \
+  or __has_feature(thread_sanitizer)
+#define _GLIBCXX_SIMD_PAGE_SAFE_OVERREAD 0
+#else
+#define _GLIBCXX_SIMD_PAGE_SAFE_OVERREAD 1
+#endif
+#else
+#define _GLIBCXX_SIMD_PAGE_SAFE_OVERREAD 1
+#endif
+#endif
+
+// The default distance in bytes of loop-level prefetches (__simd_flag_prefetch_stream<>) for
+// streaming loops over ranges that do not fit into the cache. benchmarks/prefetch.cpp finds the best
+// value for the host.
+#ifndef _GLIBCXX_SIMD_PREFETCH_DISTANCE
+#define _GLIBCXX_SIMD_PREFETCH_DISTANCE 2048
+#endif
+
 #if defined __GXX_CONDITIONAL_IS_OVERLOADABLE__ and SIMD_CONDITIONAL_OPERATOR
 #define simd_select_impl operator?:
 #endif
@@ -36,7 +36,7 @@ namespace std::__detail
         constexpr auto _NTo = _ToAbi::_S_size;
         static_assert(_NFrom >= _NTo);
         return _Impl::template _S_generator<_To>([&] [[__gnu__::__always_inline__]] (auto __i) {
-                 return _FromImpl::_S_get(__x, __i);
+                 return static_cast<_To>(_FromImpl::_S_get(__x, __i));
                });
       }
     };
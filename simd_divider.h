@@ -0,0 +1,149 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_DIVIDER_H_
+#define PROTOTYPE_SIMD_DIVIDER_H_
+
+#include "simd.h"
+
+#include <bit>
+
+// Division of integer simds by a runtime-invariant divisor. The divisor is turned into a
+// multiplier and shift counts once (Granlund & Montgomery, "Division by Invariant Integers using
+// Multiplication"; Warren, "Hacker's Delight", chapter 10), so that every division costs a high
+// multiplication, an addition, and shifts.
+
+namespace std
+{
+  namespace __detail
+  {
+    template <typename _Tp, typename _Abi>
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+      __mulhi(const basic_simd<_Tp, _Abi>& __x, const basic_simd<_Tp, _Abi>& __y)
+      {
+        using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+        return {__private_init, _Impl::_S_mulhi(__data(__x), __data(__y))};
+      }
+  }
+
+  /**
+   * Precomputes division by @p __d for all basic_simd<_Tp, _Abi>.
+   *
+   * Precondition: __d != 0
+   */
+  template <__detail::__signed_or_unsigned_integer _Tp>
+    class simd_divider
+    {
+      using _Up = make_unsigned_t<_Tp>;
+
+      static constexpr int _S_bits = sizeof(_Tp) * __CHAR_BIT__;
+
+      _Tp _M_divisor;
+
+      _Tp _M_magic = 0;
+
+      // unsigned: shift of (x - t) and of the final sum; signed: the final shift
+      unsigned char _M_shift1 = 0;
+
+      unsigned char _M_shift2 = 0;
+
+      // signed: whether x needs to be added to (1) or subtracted from (-1) the high product
+      signed char _M_add = 0;
+
+    public:
+      using value_type = _Tp;
+
+      constexpr explicit
+      simd_divider(_Tp __d) noexcept
+      : _M_divisor(__d)
+      {
+        if (__d == 0)
+          __detail::__invoke_ub("simd_divider(d): precondition d != 0 failed");
+
+        if constexpr (is_unsigned_v<_Tp>)
+          {
+            // ceil(log2(d)); the multiplier is 2^N * (2^l - d) / d + 1 and fits into N bits
+            const int __l = std::bit_width(_Up(__d - 1));
+            using _Wp = conditional_t<sizeof(_Tp) == 8, unsigned __int128, unsigned long long>;
+            _M_magic = _Tp((((_Wp(1) << __l) - __d) << _S_bits) / __d + 1);
+            _M_shift1 = std::min(__l, 1);
+            _M_shift2 = std::max(__l - 1, 0);
+          }
+        else if (__d != 1 and __d != -1)
+          {
+            const _Up __two = _Up(1) << (_S_bits - 1);
+            const _Up __ad = __d < 0 ? _Up(-_Up(__d)) : _Up(__d);
+            const _Up __t = _Up(__two + (_Up(__d) >> (_S_bits - 1)));
+            const _Up __anc = _Up(__t - 1 - __t % __ad);
+            int __p = _S_bits - 1;
+            _Up __q1 = _Up(__two / __anc);
+            _Up __r1 = _Up(__two - __q1 * __anc);
+            _Up __q2 = _Up(__two / __ad);
+            _Up __r2 = _Up(__two - __q2 * __ad);
+            _Up __delta;
+            do
+              {
+                ++__p;
+                __q1 = _Up(2 * __q1);
+                __r1 = _Up(2 * __r1);
+                if (__r1 >= __anc)
+                  {
+                    ++__q1;
+                    __r1 -= __anc;
+                  }
+                __q2 = _Up(2 * __q2);
+                __r2 = _Up(2 * __r2);
+                if (__r2 >= __ad)
+                  {
+                    ++__q2;
+                    __r2 -= __ad;
+                  }
+                __delta = _Up(__ad - __r2);
+              }
+            while (__q1 < __delta or (__q1 == __delta and __r1 == 0));
+            const _Up __m = _Up(__q2 + 1);
+            _M_magic = __d < 0 ? _Tp(-__m) : _Tp(__m);
+            _M_shift1 = __p - _S_bits;
+            _M_add = __d > 0 and _M_magic < 0 ? 1 : __d < 0 and _M_magic > 0 ? -1 : 0;
+          }
+      }
+
+      constexpr _Tp
+      divisor() const noexcept
+      { return _M_divisor; }
+
+      template <typename _Abi>
+        _GLIBCXX_SIMD_ALWAYS_INLINE constexpr friend basic_simd<_Tp, _Abi>
+        operator/(const basic_simd<_Tp, _Abi>& __x, const simd_divider& __d) noexcept
+        {
+          using _V = basic_simd<_Tp, _Abi>;
+          const _V __t = __detail::__mulhi(__x, _V(__d._M_magic));
+          if constexpr (is_unsigned_v<_Tp>)
+            return (__t + ((__x - __t) >> __d._M_shift1)) >> __d._M_shift2;
+          else if (__d._M_divisor == 1)
+            return __x;
+          else if (__d._M_divisor == -1)
+            return -__x;
+          else
+            {
+              _V __q = __t;
+              if (__d._M_add > 0)
+                __q += __x;
+              else if (__d._M_add < 0)
+                __q -= __x;
+              __q >>= __d._M_shift1;
+              // round towards zero: add 1 to negative quotients
+              return __q - (__q >> (_S_bits - 1));
+            }
+        }
+
+      template <typename _Abi>
+        _GLIBCXX_SIMD_ALWAYS_INLINE constexpr friend basic_simd<_Tp, _Abi>
+        operator%(const basic_simd<_Tp, _Abi>& __x, const simd_divider& __d) noexcept
+        { return __x - (__x / __d) * basic_simd<_Tp, _Abi>(__d._M_divisor); }
+    };
+}
+
+#endif  // PROTOTYPE_SIMD_DIVIDER_H_
@@ -0,0 +1,413 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_EXECUTION_H_
+#define PROTOTYPE_SIMD_EXECUTION_H_
+
+#include "simd.h"
+#include "simd_executor.h"
+#include "simd_loop.h"
+#include "simd_reductions.h"
+
+#include <algorithm>
+#include <execution>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+
+/* Standard algorithms, vectorized with basic_simd
+ * ===============================================
+ *
+ * The namespace simd_execution provides transform, reduce, and transform_reduce with the
+ * signatures of the parallel overloads in <algorithm> and <numeric>:
+ *
+ *   simd_execution::transform(execution::unseq, in.begin(), in.end(), out.begin(),
+ *                             [](auto x) { return simd_select(x > 0, x, -x); });
+ *
+ * With execution::unseq or execution::par_unseq, the element-wise operations are invoked with
+ * simd<T> arguments (T is the value type of the first input range) and the reduction operations
+ * with simd<U, N> arguments (U is the type of init). Thus, the loops are vectorized independent of
+ * the auto-vectorizer, also for operations that need simd_select or other simd-only functions.
+ * The first and last chunk of a range are partial: the input lanes beyond the range are copies of
+ * the first element of the chunk (thus the operations are only called with values of the range),
+ * and the results of these lanes are ignored.
+ *
+ * par_unseq additionally distributes ranges of at least __par_unseq_min_bytes over the threads of
+ * a shared simd_executor (with all hardware threads). The executor runs one algorithm at a time:
+ * while it is busy, and for par_unseq calls from inside a par_unseq algorithm, the algorithm runs
+ * on the calling thread only. Parallel reductions need the identity
+ * element of the reduction (see __identity_element_for); other reductions run on the calling
+ * thread.
+ *
+ * The simd path requires contiguous iterators over vectorizable types and operations that are
+ * callable with simd arguments (as above). Otherwise, and for the other execution policies, the
+ * calls are forwarded to the std algorithms.
+ *
+ * This header is not part of <simd> because <execution> may require linking the parallel backend
+ * of the standard library (TBB).
+ */
+
+namespace std
+{
+  namespace __detail
+  {
+    // ranges smaller than this are not worth waking the workers of the executor for
+    inline constexpr size_t __par_unseq_min_bytes = __parallel_block_bytes;
+
+    template <typename _Ep>
+      concept __par_unseq_policy
+        = same_as<remove_cvref_t<_Ep>, execution::parallel_unsequenced_policy>;
+
+    template <typename _Ep>
+      concept __unseq_policy
+        = __par_unseq_policy<_Ep>
+            or same_as<remove_cvref_t<_Ep>, execution::unsequenced_policy>;
+
+    template <typename _It>
+      concept __simd_iterator = contiguous_iterator<_It> and __vectorizable<iter_value_t<_It>>;
+
+    // the simd type the algorithms use for ranges of _It
+    template <typename _It>
+      using __execution_simd_t = simd<iter_value_t<_It>>;
+
+    // the simd type with the value type _Up and the width of _Vp
+    template <typename _Up, typename _Vp>
+      using __execution_result_t = resize_simd_t<_Vp::size(), simd<_Up>>;
+
+    // __fn(simd...) returns a simd of the same width
+    template <typename _Fp, typename _Vp, typename... _Vs>
+      concept __simd_elementwise = requires(_Fp& __fn, _Vp __x, _Vs... __xs) {
+        { __fn(__x, __xs...) } -> __simd_type<_Vp::size()>;
+      };
+
+    // __fn(simd...) returns a simd that converts to a simd of _Up
+    template <typename _Fp, typename _Up, typename _Vp, typename... _Vs>
+      concept __simd_elementwise_to
+        = __vectorizable<_Up> and __simd_elementwise<_Fp, _Vp, _Vs...>
+            and constructible_from<__execution_result_t<_Up, _Vp>,
+                                   invoke_result_t<_Fp&, _Vp, _Vs...>>;
+
+    // as above, and the values convert to _Up without loss (as in a reduction with init of _Up)
+    template <typename _Fp, typename _Up, typename _Vp, typename... _Vs>
+      concept __simd_elementwise_into
+        = __simd_elementwise_to<_Fp, _Up, _Vp, _Vs...>
+            and __value_preserving_convertible_to<
+                  typename invoke_result_t<_Fp&, _Vp, _Vs...>::value_type, _Up>;
+
+    // __op reduces simd<_Up, N> (for the width of _Vp and for reduce())
+    template <typename _Op, typename _Up, typename _Vp>
+      concept __simd_reduction
+        = __vectorizable<_Up>
+            and requires(_Op& __op, __execution_result_t<_Up, _Vp> __x, simd<_Up, 1> __x1) {
+              { __op(__x, __x) } -> same_as<__execution_result_t<_Up, _Vp>>;
+              { __op(__x1, __x1) } -> same_as<simd<_Up, 1>>;
+            };
+
+    // the executor of parallel_unsequenced_policy
+    inline simd_executor&
+    __par_unseq_executor()
+    {
+      static simd_executor __exec;
+      return __exec;
+    }
+
+    // serializes the algorithms on __par_unseq_executor()
+    inline mutex&
+    __par_unseq_mutex()
+    {
+      static mutex __m;
+      return __m;
+    }
+
+    // Locks __par_unseq_executor() for one algorithm. The lock is not owned if another thread
+    // uses the executor or if the calling thread runs a job of the executor (a nested call).
+    inline unique_lock<mutex>
+    __try_lock_par_unseq_executor()
+    {
+      if (__current_executor == &__par_unseq_executor())
+        return {};
+      return unique_lock<mutex>(__par_unseq_mutex(), try_to_lock);
+    }
+
+    template <typename _Ep, typename _Tp>
+      _GLIBCXX_SIMD_INTRINSIC bool
+      __use_par_unseq_executor(size_t __n)
+      { return __par_unseq_policy<_Ep> and __n * sizeof(_Tp) >= __par_unseq_min_bytes; }
+
+    // loads __chunk, with the lanes of a partial chunk outside of the range set to the first
+    // element of the chunk
+    template <typename _Chunk>
+      _GLIBCXX_SIMD_INTRINSIC typename _Chunk::simd_type
+      __load_in_range(const _Chunk& __chunk)
+      {
+        using _Vp = typename _Chunk::simd_type;
+        const _Vp __x = __chunk.load();
+        if constexpr (_Chunk::is_partial)
+          return simd_select(__chunk.mask(), __x, _Vp(__x[0]));
+        else
+          return __x;
+      }
+
+    // loads the elements of a second range that correspond to __chunk (as __load_in_range)
+    template <typename _Vp, typename _Chunk>
+      _GLIBCXX_SIMD_INTRINSIC _Vp
+      __load_for_chunk(const typename _Vp::value_type* __ptr, const _Chunk& __chunk)
+      {
+        if constexpr (_Chunk::is_partial)
+          {
+            const _Vp __x = simd_partial_load<_Vp>(__ptr + __chunk.index(), __chunk.size());
+            return simd_select(__chunk_mask_for<_Vp>(__chunk), __x, _Vp(__x[0]));
+          }
+        else
+          return _Vp(__ptr + __chunk.index());
+      }
+
+    // stores the lanes of __x that belong to __chunk to the output range at __ptr
+    template <typename _Up, typename _Chunk, typename _Rp>
+      _GLIBCXX_SIMD_INTRINSIC void
+      __store_for_chunk(_Up* __ptr, const _Chunk& __chunk, const _Rp& __x)
+      {
+        using _Ry = rebind_simd_t<_Up, _Rp>;
+        const _Ry __y(__x);
+        if constexpr (_Chunk::is_partial)
+          __y.copy_to(__ptr + __chunk.index(), __chunk_mask_for<_Ry>(__chunk));
+        else
+          __y.copy_to(__ptr + __chunk.index());
+      }
+
+    // calls __fn with the chunks of [__ptr, __ptr + __n) (on all threads for par_unseq)
+    template <typename _Vp, typename _Ep, typename _Tp, typename _Fp>
+      void
+      __execution_for_each(_Tp* __ptr, size_t __n, _Fp&& __fn)
+      {
+        if (__n == 0)
+          return;
+        if (__use_par_unseq_executor<_Ep, _Tp>(__n))
+          if (const unique_lock<mutex> __lock = __try_lock_par_unseq_executor();
+              __lock.owns_lock())
+            {
+              __parallel_for_each<_Vp>(__par_unseq_executor(), __ptr, __n,
+                                       [&](unsigned, auto __chunk) { __fn(__chunk); });
+              return;
+            }
+        __simd_for_each_aligned<_Vp>(__ptr, __n, 0, __fn, simd_flag_default);
+      }
+
+    // init op reduce(__fn(chunk) op ...)
+    template <typename _Vp, typename _Ep, typename _Tp, typename _Up, typename _BinaryOperation,
+              typename _Fp>
+      _Up
+      __execution_transform_reduce(_Tp* __ptr, size_t __n, _Up __init,
+                                   _BinaryOperation& __binary_op, _Fp&& __fn)
+      {
+        if (__n == 0)
+          return __init;
+        using _Rp = __execution_result_t<_Up, _Vp>;
+        using _R1 = simd<_Up, 1>;
+        const auto __op1 = [&](_Up __a, _Up __b) { return __binary_op(_R1(__a), _R1(__b))[0]; };
+        constexpr auto __identity = __identity_element_for<_Up, _BinaryOperation>;
+        if constexpr (not same_as<decltype(__identity), const nullptr_t>)
+          {
+            if (__use_par_unseq_executor<_Ep, _Tp>(__n))
+              if (const unique_lock<mutex> __lock = __try_lock_par_unseq_executor();
+                  __lock.owns_lock())
+                return __op1(__init, __parallel_transform_reduce<_Vp>(
+                                       __par_unseq_executor(), __ptr, __n, _Up(__identity),
+                                       __binary_op, __fn));
+            _Rp __acc(__identity);
+            auto __body = [&](auto __chunk) {
+              if constexpr (decltype(__chunk)::is_partial)
+                __acc = __binary_op(__acc, simd_select(__chunk_mask_for<_Rp>(__chunk),
+                                                       _Rp(__fn(__chunk)), _Rp(__identity)));
+              else
+                __acc = __binary_op(__acc, _Rp(__fn(__chunk)));
+            };
+            __simd_for_each_aligned<_Vp>(__ptr, __n, 0, __body, simd_flag_default);
+            return __op1(__init, reduce(__acc, __binary_op));
+          }
+        else
+          {
+            // Without identity element the accumulator starts with the first full chunk, and the
+            // lanes of partial chunks are combined with the scalar result one by one.
+            _Up __r = __init;
+            _Rp __acc;
+            bool __empty = true;
+            auto __body = [&](auto __chunk) {
+              if constexpr (decltype(__chunk)::is_partial)
+                {
+                  const _Rp __x(__fn(__chunk));
+                  for (size_t __i = 0; __i < __chunk.size(); ++__i)
+                    __r = __op1(__r, __x[__i]);
+                }
+              else if (__empty)
+                {
+                  __acc = _Rp(__fn(__chunk));
+                  __empty = false;
+                }
+              else
+                __acc = __binary_op(__acc, _Rp(__fn(__chunk)));
+            };
+            __simd_for_each_aligned<_Vp>(__ptr, __n, 0, __body, simd_flag_default);
+            return __empty ? __r : __op1(__r, reduce(__acc, __binary_op));
+          }
+      }
+  }
+
+  namespace simd_execution
+  {
+    /// d_first[i] = op(first[i])
+    template <typename _Ep, forward_iterator _It, forward_iterator _Out, typename _UnaryOperation>
+      requires is_execution_policy_v<remove_cvref_t<_Ep>>
+      _Out
+      transform(_Ep&& __policy, _It __first, _It __last, _Out __d_first, _UnaryOperation __op)
+      {
+        using _Vp = __detail::__execution_simd_t<_It>;
+        if constexpr (__detail::__unseq_policy<_Ep> and __detail::__simd_iterator<_It>
+                        and contiguous_iterator<_Out>
+                        and __detail::__simd_elementwise_to<_UnaryOperation, iter_value_t<_Out>,
+                                                            _Vp>)
+          {
+            const size_t __n = __last - __first;
+            auto* const __out = std::to_address(__d_first);
+            __detail::__execution_for_each<_Vp, _Ep>(
+              std::to_address(__first), __n, [&](auto __chunk) {
+                __detail::__store_for_chunk(__out, __chunk,
+                                            __op(__detail::__load_in_range(__chunk)));
+              });
+            return __d_first + __n;
+          }
+        else
+          return std::transform(std::forward<_Ep>(__policy), __first, __last, __d_first, __op);
+      }
+
+    /// d_first[i] = op(first1[i], first2[i])
+    template <typename _Ep, forward_iterator _It1, forward_iterator _It2, forward_iterator _Out,
+              typename _BinaryOperation>
+      requires is_execution_policy_v<remove_cvref_t<_Ep>>
+      _Out
+      transform(_Ep&& __policy, _It1 __first1, _It1 __last1, _It2 __first2, _Out __d_first,
+                _BinaryOperation __op)
+      {
+        using _Vp = __detail::__execution_simd_t<_It1>;
+        using _V2 = __detail::__execution_result_t<iter_value_t<_It2>, _Vp>;
+        if constexpr (__detail::__unseq_policy<_Ep> and __detail::__simd_iterator<_It1>
+                        and __detail::__simd_iterator<_It2> and contiguous_iterator<_Out>
+                        and __detail::__simd_elementwise_to<_BinaryOperation,
+                                                            iter_value_t<_Out>, _Vp, _V2>)
+          {
+            const size_t __n = __last1 - __first1;
+            const auto* const __in2 = std::to_address(__first2);
+            auto* const __out = std::to_address(__d_first);
+            __detail::__execution_for_each<_Vp, _Ep>(
+              std::to_address(__first1), __n, [&](auto __chunk) {
+                __detail::__store_for_chunk(
+                  __out, __chunk, __op(__detail::__load_in_range(__chunk),
+                                       __detail::__load_for_chunk<_V2>(__in2, __chunk)));
+              });
+            return __d_first + __n;
+          }
+        else
+          return std::transform(std::forward<_Ep>(__policy), __first1, __last1, __first2,
+                                __d_first, __op);
+      }
+
+    /// init op first[0] op first[1] op ... (in any order)
+    template <typename _Ep, forward_iterator _It, typename _Tp, typename _BinaryOperation>
+      requires is_execution_policy_v<remove_cvref_t<_Ep>>
+      _Tp
+      reduce(_Ep&& __policy, _It __first, _It __last, _Tp __init, _BinaryOperation __binary_op)
+      {
+        using _Vp = __detail::__execution_simd_t<_It>;
+        if constexpr (__detail::__unseq_policy<_Ep> and __detail::__simd_iterator<_It>
+                        and __detail::__value_preserving_convertible_to<iter_value_t<_It>, _Tp>
+                        and __detail::__simd_reduction<_BinaryOperation, _Tp, _Vp>)
+          return __detail::__execution_transform_reduce<_Vp, _Ep>(
+                   std::to_address(__first), __last - __first, __init, __binary_op,
+                   [](auto __chunk) { return __detail::__load_in_range(__chunk); });
+        else
+          return std::reduce(std::forward<_Ep>(__policy), __first, __last, __init, __binary_op);
+      }
+
+    template <typename _Ep, forward_iterator _It, typename _Tp>
+      requires is_execution_policy_v<remove_cvref_t<_Ep>>
+      _Tp
+      reduce(_Ep&& __policy, _It __first, _It __last, _Tp __init)
+      {
+        return simd_execution::reduce(std::forward<_Ep>(__policy), __first, __last, __init,
+                                      plus<>());
+      }
+
+    template <typename _Ep, forward_iterator _It>
+      requires is_execution_policy_v<remove_cvref_t<_Ep>>
+      iter_value_t<_It>
+      reduce(_Ep&& __policy, _It __first, _It __last)
+      {
+        return simd_execution::reduce(std::forward<_Ep>(__policy), __first, __last,
+                                      iter_value_t<_It>(), plus<>());
+      }
+
+    /// init op transform(first1[0], first2[0]) op transform(first1[1], first2[1]) op ...
+    template <typename _Ep, forward_iterator _It1, forward_iterator _It2, typename _Tp,
+              typename _BinaryReductionOp, typename _BinaryTransformOp>
+      requires is_execution_policy_v<remove_cvref_t<_Ep>>
+      _Tp
+      transform_reduce(_Ep&& __policy, _It1 __first1, _It1 __last1, _It2 __first2, _Tp __init,
+                       _BinaryReductionOp __reduce_op, _BinaryTransformOp __transform_op)
+      {
+        using _Vp = __detail::__execution_simd_t<_It1>;
+        using _V2 = __detail::__execution_result_t<iter_value_t<_It2>, _Vp>;
+        if constexpr (__detail::__unseq_policy<_Ep> and __detail::__simd_iterator<_It1>
+                        and __detail::__simd_iterator<_It2>
+                        and __detail::__simd_reduction<_BinaryReductionOp, _Tp, _Vp>
+                        and __detail::__simd_elementwise_into<_BinaryTransformOp, _Tp, _Vp, _V2>)
+          {
+            const auto* const __in2 = std::to_address(__first2);
+            return __detail::__execution_transform_reduce<_Vp, _Ep>(
+                     std::to_address(__first1), __last1 - __first1, __init, __reduce_op,
+                     [&](auto __chunk) {
+                       return __transform_op(__detail::__load_in_range(__chunk),
+                                             __detail::__load_for_chunk<_V2>(__in2, __chunk));
+                     });
+          }
+        else
+          return std::transform_reduce(std::forward<_Ep>(__policy), __first1, __last1, __first2,
+                                       __init, __reduce_op, __transform_op);
+      }
+
+    template <typename _Ep, forward_iterator _It1, forward_iterator _It2, typename _Tp>
+      requires is_execution_policy_v<remove_cvref_t<_Ep>>
+      _Tp
+      transform_reduce(_Ep&& __policy, _It1 __first1, _It1 __last1, _It2 __first2, _Tp __init)
+      {
+        return simd_execution::transform_reduce(std::forward<_Ep>(__policy), __first1, __last1,
+                                                __first2, __init, plus<>(), multiplies<>());
+      }
+
+    /// init op transform(first[0]) op transform(first[1]) op ...
+    template <typename _Ep, forward_iterator _It, typename _Tp, typename _BinaryReductionOp,
+              typename _UnaryTransformOp>
+      requires is_execution_policy_v<remove_cvref_t<_Ep>>
+      _Tp
+      transform_reduce(_Ep&& __policy, _It __first, _It __last, _Tp __init,
+                       _BinaryReductionOp __reduce_op, _UnaryTransformOp __transform_op)
+      {
+        using _Vp = __detail::__execution_simd_t<_It>;
+        if constexpr (__detail::__unseq_policy<_Ep> and __detail::__simd_iterator<_It>
+                        and __detail::__simd_reduction<_BinaryReductionOp, _Tp, _Vp>
+                        and __detail::__simd_elementwise_into<_UnaryTransformOp, _Tp, _Vp>)
+          return __detail::__execution_transform_reduce<_Vp, _Ep>(
+                   std::to_address(__first), __last - __first, __init, __reduce_op,
+                   [&](auto __chunk) {
+                     return __transform_op(__detail::__load_in_range(__chunk));
+                   });
+        else
+          return std::transform_reduce(std::forward<_Ep>(__policy), __first, __last, __init,
+                                       __reduce_op, __transform_op);
+      }
+  }
+}
+
+#endif  // PROTOTYPE_SIMD_EXECUTION_H_
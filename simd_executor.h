@@ -0,0 +1,460 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_EXECUTOR_H_
+#define PROTOTYPE_SIMD_EXECUTOR_H_
+
+#include "simd.h"
+#include "simd_loop.h"
+#include "simd_numa.h"
+#include "simd_reductions.h"
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* A multi-threaded loop driver
+ * ============================
+ *
+ * simd_executor owns a pool of worker threads (the calling thread participates as worker 0).
+ *
+ * simd_for_each<V>(executor, range, fn) calls fn with the same chunk proxies as
+ * simd_for_each_aligned (index() is relative to the whole range), from all workers concurrently.
+ * The range is split into blocks of about __parallel_block_bytes whose boundaries are aligned to
+ * simd_alignment_v<V>. Thus, only the first and the last block have partial chunks.
+ *
+ * simd_reduce<V>(executor, range, op) reduces the range with op (plus<> by default). Every worker
+ * accumulates into its own V (lane-wise op), the accumulators are combined lane-wise at the end and
+ * reduced with reduce(). Without a known identity element for op (see __identity_element_for),
+ * pass it as an argument: simd_reduce<V>(executor, range, identity, op).
+ *
+ * Load balancing: every worker starts with a contiguous share of the blocks and takes blocks from
+ * its front. A worker without blocks steals half of the remaining blocks from the back of another
+ * worker's share. Every share (and every accumulator) lives in its own cache line, thus the
+ * workers do not share any cache lines in the loop, except when stealing.
+ *
+ * NUMA: simd_executor(simd_numa_topology(), threads) pins the worker threads to CPUs, spread evenly
+ * over the NUMA nodes, and orders them by node. (The calling thread is not pinned; it takes the
+ * place of the first CPU.) Since the initial shares are contiguous in worker order, every node
+ * starts with a contiguous part of the range, and idle workers steal from workers of their own node
+ * first. simd_first_touch<V>(executor, range, value) writes value to range with the initial shares
+ * and without stealing. On first-touch NUMA policies (the Linux default), the pages of each share
+ * are thus allocated on the node of the worker that later processes them, as long as range is
+ * processed with the same V (e.g. a simd_buffer::for_overwrite that is not yet touched). On a
+ * single-node machine this is the plain pool with pinned threads.
+ *
+ * One executor runs one parallel algorithm at a time. Exceptions thrown by fn are rethrown (one of
+ * them, if several workers throw) after all workers finished.
+ */
+
+namespace std
+{
+  class simd_executor;
+
+  namespace __detail
+  {
+    // the target size of the blocks that the workers take (and steal) at once
+    inline constexpr size_t __parallel_block_bytes = 64 << 10;
+
+    template <typename _Vp, typename _Tp, typename _Fp>
+      void
+      __parallel_for_each(simd_executor& __exec, _Tp* __ptr, size_t __n, _Fp&& __fn,
+                          bool __steal = true);
+
+    // the executor whose job the current thread runs (as worker or as the calling thread)
+    inline thread_local const simd_executor* __current_executor = nullptr;
+  }
+
+  class simd_executor
+  {
+    // the blocks [begin, end) of one worker, packed as begin << 32 | end
+    struct alignas(__detail::__cache_line_size) _Share
+    {
+      atomic<uint64_t> _M_bounds = 0;
+    };
+
+    // the job of the current parallel algorithm: _M_job(_M_context, worker index)
+    void (*_M_job)(void*, unsigned) = nullptr;
+
+    void* _M_context = nullptr;
+
+    // incremented for every job (and for stopping), the workers wait for it to change
+    atomic<unsigned> _M_generation = 0;
+
+    // the number of workers (excluding the calling thread) still running the current job
+    atomic<unsigned> _M_running = 0;
+
+    atomic<bool> _M_stop = false;
+
+    atomic<bool> _M_failed = false;
+
+    exception_ptr _M_error;
+
+    unique_ptr<_Share[]> _M_shares;
+
+    // the NUMA node (index into the topology) of every worker, ascending
+    unique_ptr<unsigned[]> _M_nodes;
+
+    vector<jthread> _M_threads;
+
+    void
+    _M_work(unsigned __worker) noexcept
+    {
+      const simd_executor* const __outer
+        = std::exchange(__detail::__current_executor, this);
+      try
+        {
+          _M_job(_M_context, __worker);
+        }
+      catch (...)
+        {
+          if (not _M_failed.exchange(true))
+            _M_error = current_exception();
+        }
+      __detail::__current_executor = __outer;
+    }
+
+    void
+    _M_worker_loop(unsigned __worker) noexcept
+    {
+      for (unsigned __gen = 0; ; )
+        {
+          _M_generation.wait(__gen, memory_order_acquire);
+          __gen = _M_generation.load(memory_order_acquire);
+          if (_M_stop.load(memory_order_relaxed))
+            return;
+          _M_work(__worker);
+          if (_M_running.fetch_sub(1, memory_order_acq_rel) == 1)
+            _M_running.notify_one();
+        }
+    }
+
+    // takes the block at the front of __worker's share
+    bool
+    _M_pop(unsigned __worker, uint32_t& __block) noexcept
+    {
+      atomic<uint64_t>& __bounds = _M_shares[__worker]._M_bounds;
+      uint64_t __b = __bounds.load(memory_order_relaxed);
+      while (uint32_t(__b >> 32) < uint32_t(__b))
+        {
+          if (__bounds.compare_exchange_weak(__b, __b + (uint64_t(1) << 32),
+                                             memory_order_acquire, memory_order_relaxed))
+            {
+              __block = uint32_t(__b >> 32);
+              return true;
+            }
+        }
+      return false;
+    }
+
+    // moves half of the blocks of another worker's share to the (empty) share of __worker,
+    // preferring workers on the same node
+    bool
+    _M_steal(unsigned __worker) noexcept
+    {
+      const unsigned __n = concurrency();
+      for (unsigned __k = 1; __k < 2 * __n; ++__k)
+        {
+          const unsigned __w = (__worker + __k) % __n;
+          if ((_M_nodes[__w] == _M_nodes[__worker]) != (__k < __n))
+            continue;
+          atomic<uint64_t>& __victim = _M_shares[__w]._M_bounds;
+          uint64_t __b = __victim.load(memory_order_relaxed);
+          for (uint32_t __begin, __end; (__begin = __b >> 32) < (__end = uint32_t(__b)); )
+            {
+              const uint32_t __mid = __end - (__end - __begin + 1) / 2;
+              if (__victim.compare_exchange_weak(__b, uint64_t(__begin) << 32 | __mid,
+                                                 memory_order_acquire, memory_order_relaxed))
+                {
+                  _M_shares[__worker]._M_bounds.store(uint64_t(__mid) << 32 | __end,
+                                                      memory_order_release);
+                  return true;
+                }
+            }
+        }
+      return false;
+    }
+
+    // wakes all workers and makes them return (~vector<jthread> joins them)
+    void
+    _M_stop_workers() noexcept
+    {
+      _M_stop.store(true, memory_order_relaxed);
+      _M_generation.fetch_add(1, memory_order_release);
+      _M_generation.notify_all();
+    }
+
+    template <typename _Fp>
+      void
+      _M_run(_Fp& __fn)
+      {
+        _M_job = [](void* __ctx, unsigned __worker) { (*static_cast<_Fp*>(__ctx))(__worker); };
+        _M_context = &__fn;
+        _M_failed.store(false, memory_order_relaxed);
+        _M_error = nullptr;
+        _M_running.store(_M_threads.size(), memory_order_relaxed);
+        _M_generation.fetch_add(1, memory_order_release);
+        _M_generation.notify_all();
+        _M_work(0);
+        for (unsigned __r; (__r = _M_running.load(memory_order_acquire)) != 0; )
+          _M_running.wait(__r, memory_order_acquire);
+        if (_M_error)
+          rethrow_exception(std::exchange(_M_error, nullptr));
+      }
+
+    // calls __fn(worker, block) for every block in [0, __blocks), distributed over all workers
+    // (without __steal, every worker processes exactly its initial share)
+    template <typename _Fp>
+      void
+      _M_for_each_block(uint32_t __blocks, _Fp&& __fn, bool __steal)
+      {
+        const unsigned __n = concurrency();
+        for (unsigned __w = 0; __w < __n; ++__w)
+          _M_shares[__w]._M_bounds.store(uint64_t(uint64_t(__blocks) * __w / __n) << 32
+                                           | uint64_t(__blocks) * (__w + 1) / __n,
+                                         memory_order_relaxed);
+        auto __job = [&](unsigned __worker) {
+          uint32_t __block;
+          do
+            while (_M_pop(__worker, __block))
+              __fn(__worker, __block);
+          while (__steal and _M_steal(__worker));
+        };
+        _M_run(__job);
+      }
+
+    template <typename _Vp, typename _Tp, typename _Fp>
+      friend void
+      __detail::__parallel_for_each(simd_executor&, _Tp*, size_t, _Fp&&, bool);
+
+  public:
+    /// Starts @p __threads - 1 worker threads (all hardware threads by default).
+    explicit
+    simd_executor(unsigned __threads = thread::hardware_concurrency())
+    : _M_shares(new _Share[std::max(1u, __threads)]),
+      _M_nodes(new unsigned[std::max(1u, __threads)]())
+    {
+      _M_threads.reserve(std::max(1u, __threads) - 1);
+      try
+        {
+          for (unsigned __w = 1; __w < __threads; ++__w)
+            _M_threads.emplace_back([this, __w] { _M_worker_loop(__w); });
+        }
+      catch (...)
+        {
+          // the destructor does not run, stop the workers that already started
+          _M_stop_workers();
+          throw;
+        }
+    }
+
+    /**
+     * Starts @p __threads - 1 worker threads (one per CPU of @p __topology by default), pinned to
+     * CPUs of @p __topology, with the same number of threads on every node (as far as possible).
+     */
+    explicit
+    simd_executor(const simd_numa_topology& __topology, unsigned __threads = 0)
+    {
+      const span<const simd_numa_node> __nodes = __topology.nodes();
+      __threads = __threads == 0 ? __topology.cpus() : std::min(__threads, __topology.cpus());
+      // round-robin over the nodes, then grouped by node
+      vector<pair<unsigned, unsigned>> __placement; // node index, CPU
+      for (size_t __i = 0; __placement.size() < __threads; ++__i)
+        for (unsigned __node = 0; __node < __nodes.size() and __placement.size() < __threads;
+             ++__node)
+          if (__i < __nodes[__node].cpus.size())
+            __placement.emplace_back(__node, __nodes[__node].cpus[__i]);
+      std::stable_sort(__placement.begin(), __placement.end(),
+                       [](auto __a, auto __b) { return __a.first < __b.first; });
+      _M_shares.reset(new _Share[__threads]);
+      _M_nodes.reset(new unsigned[__threads]);
+      for (unsigned __w = 0; __w < __threads; ++__w)
+        _M_nodes[__w] = __placement[__w].first;
+      _M_threads.reserve(__threads - 1);
+      try
+        {
+          for (unsigned __w = 1; __w < __threads; ++__w)
+            {
+              _M_threads.emplace_back([this, __w] { _M_worker_loop(__w); });
+              __detail::__pin_thread(_M_threads.back().native_handle(),
+                                     __placement[__w].second);
+            }
+        }
+      catch (...)
+        {
+          _M_stop_workers();
+          throw;
+        }
+    }
+
+    simd_executor(const simd_executor&) = delete;
+
+    simd_executor&
+    operator=(const simd_executor&) = delete;
+
+    ~simd_executor()
+    { _M_stop_workers(); }
+
+    /// The number of threads that run a parallel algorithm, including the calling thread.
+    unsigned
+    concurrency() const noexcept
+    { return _M_threads.size() + 1; }
+  };
+
+  namespace __detail
+  {
+    /**
+     * Calls @p __fn(worker, chunk proxy) for all chunks of [@p __ptr, @p __ptr + @p __n) on all
+     * workers of @p __exec.
+     */
+    template <typename _Vp, typename _Tp, typename _Fp>
+      void
+      __parallel_for_each(simd_executor& __exec, _Tp* __ptr, size_t __n, _Fp&& __fn,
+                          bool __steal)
+      {
+        if (__n == 0)
+          return;
+        constexpr size_t __width = _Vp::size();
+        constexpr size_t __alignment = simd_alignment_v<_Vp>;
+        constexpr size_t __block
+          = std::max<size_t>(1, __parallel_block_bytes / sizeof(_Tp) / __width) * __width;
+        // the first block extends to an aligned boundary (if possible), all others start at one
+        const size_t __head
+          = __width * sizeof(_Tp) % __alignment != 0
+              ? 0 : (__alignment - reinterpret_cast<uintptr_t>(__ptr) % __alignment)
+                      % __alignment / sizeof(_Tp);
+        const size_t __blocks = __n <= __head ? 1 : (__n - __head + __block - 1) / __block;
+        if (__blocks > UINT32_MAX)
+          __throw_length_error("simd_executor: range too large");
+        __exec._M_for_each_block(uint32_t(__blocks), [&](unsigned __worker, uint32_t __b) {
+          const size_t __begin = __b == 0 ? 0 : std::min(__n, __head + __b * __block);
+          const size_t __end = std::min(__n, __head + (__b + 1) * __block);
+          auto __chunk_fn = [&](auto __chunk) { __fn(__worker, __chunk); };
+          __simd_for_each_aligned<_Vp>(__ptr + __begin, __end - __begin, __begin, __chunk_fn,
+                                       simd_flag_default);
+        }, __steal);
+      }
+
+    // chunk.mask() as a mask of _Rp (a simd of the same width, but maybe another value type)
+    template <typename _Rp, typename _Chunk>
+      _GLIBCXX_SIMD_INTRINSIC typename _Rp::mask_type
+      __chunk_mask_for(const _Chunk& __chunk)
+      {
+        if constexpr (same_as<typename _Rp::mask_type, typename _Chunk::mask_type>)
+          return __chunk.mask();
+        else
+          return iota_v<_Rp> < typename _Rp::value_type(__chunk.size());
+      }
+
+    // one accumulator per worker, each in its own cache lines
+    template <typename _Vp>
+      struct alignas(__cache_line_size) _ParallelAccumulator
+      {
+        _Vp _M_value;
+      };
+  }
+
+  /// Calls @p __fn with the chunks of @p __range (see simd_for_each_aligned) on all workers.
+  template <__detail::__simd_type _Vp, ranges::contiguous_range _Rg, typename _Fp>
+    requires ranges::sized_range<_Rg>
+               and same_as<remove_cvref_t<ranges::range_reference_t<_Rg>>,
+                           typename _Vp::value_type>
+    void
+    simd_for_each(simd_executor& __exec, _Rg&& __range, _Fp&& __fn)
+    {
+      __detail::__parallel_for_each<_Vp>(__exec, ranges::data(__range), ranges::size(__range),
+                                         [&](unsigned, auto __chunk) { __fn(__chunk); });
+    }
+
+  namespace __detail
+  {
+    /**
+     * Reduces __fn(chunk) over all chunks of [@p __ptr, @p __ptr + @p __n) with @p __binary_op,
+     * where @p __identity_element is its identity. __fn returns a simd of the width of _Vp (lanes
+     * outside of chunk.mask() are ignored).
+     */
+    template <typename _Vp, typename _Tp, typename _Up, typename _BinaryOperation, typename _Fp>
+      _Up
+      __parallel_transform_reduce(simd_executor& __exec, _Tp* __ptr, size_t __n,
+                                  _Up __identity_element, _BinaryOperation __binary_op,
+                                  _Fp&& __fn)
+      {
+        using _Rp = resize_simd_t<_Vp::size(), simd<_Up>>;
+        using _Acc = _ParallelAccumulator<_Rp>;
+        const unsigned __workers = __exec.concurrency();
+        const unique_ptr<_Acc[]> __acc(new _Acc[__workers]);
+        for (unsigned __w = 0; __w < __workers; ++__w)
+          __acc[__w]._M_value = _Rp(__identity_element);
+        __parallel_for_each<_Vp>(__exec, __ptr, __n, [&](unsigned __w, auto __chunk) {
+          _Rp& __a = __acc[__w]._M_value;
+          if constexpr (decltype(__chunk)::is_partial)
+            __a = __binary_op(__a, simd_select(__chunk_mask_for<_Rp>(__chunk),
+                                               _Rp(__fn(__chunk)), _Rp(__identity_element)));
+          else
+            __a = __binary_op(__a, _Rp(__fn(__chunk)));
+        });
+        _Rp __r = __acc[0]._M_value;
+        for (unsigned __w = 1; __w < __workers; ++__w)
+          __r = __binary_op(__r, __acc[__w]._M_value);
+        return reduce(__r, __binary_op);
+      }
+  }
+
+  /**
+   * Writes @p __value to all elements of @p __range, every worker to the part that it starts with
+   * in simd_for_each<_Vp> and simd_reduce<_Vp>.
+   */
+  template <__detail::__simd_type _Vp, ranges::contiguous_range _Rg>
+    requires ranges::sized_range<_Rg>
+               and same_as<ranges::range_value_t<_Rg>, typename _Vp::value_type>
+    void
+    simd_first_touch(simd_executor& __exec, _Rg&& __range,
+                     type_identity_t<typename _Vp::value_type> __value = {})
+    {
+      __detail::__parallel_for_each<_Vp>(__exec, ranges::data(__range), ranges::size(__range),
+                                         [&](unsigned, auto __chunk) {
+                                           __chunk.store(_Vp(__value));
+                                         }, false);
+    }
+
+  /// Reduces @p __range with @p __binary_op, where @p __identity_element is its identity.
+  template <__detail::__simd_type _Vp, ranges::contiguous_range _Rg,
+            typename _BinaryOperation = plus<>>
+    requires ranges::sized_range<_Rg>
+               and same_as<remove_cvref_t<ranges::range_reference_t<_Rg>>,
+                           typename _Vp::value_type>
+    typename _Vp::value_type
+    simd_reduce(simd_executor& __exec, _Rg&& __range,
+                type_identity_t<typename _Vp::value_type> __identity_element,
+                _BinaryOperation __binary_op = {})
+    {
+      return __detail::__parallel_transform_reduce<_Vp>(
+               __exec, ranges::data(__range), ranges::size(__range), __identity_element,
+               __binary_op, [](auto __chunk) { return __chunk.load(); });
+    }
+
+  template <__detail::__simd_type _Vp, ranges::contiguous_range _Rg,
+            typename _BinaryOperation = plus<>>
+    requires ranges::sized_range<_Rg>
+               and same_as<remove_cvref_t<ranges::range_reference_t<_Rg>>,
+                           typename _Vp::value_type>
+               and (not same_as<decltype(__detail::__identity_element_for<
+                                           typename _Vp::value_type, _BinaryOperation>),
+                                const nullptr_t>)
+    typename _Vp::value_type
+    simd_reduce(simd_executor& __exec, _Rg&& __range, _BinaryOperation __binary_op = {})
+    {
+      return simd_reduce<_Vp>(
+               __exec, __range,
+               __detail::__identity_element_for<typename _Vp::value_type, _BinaryOperation>,
+               __binary_op);
+    }
+}
+
+#endif  // PROTOTYPE_SIMD_EXECUTOR_H_
@@ -0,0 +1,292 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_GROUP_PREFETCH_H_
+#define PROTOTYPE_SIMD_GROUP_PREFETCH_H_
+
+#include "simd.h"
+#include "iota.h"
+
+#include <array>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+/* Group prefetching with coroutines
+ * =================================
+ *
+ * Lookups in hash tables, trees, or any other pointer-chasing structure are bound by memory
+ * latency: every access depends on the previous one, so a single lookup never has more than one
+ * cache miss in flight. Interleaving independent lookups hides that latency. A lookup is written
+ * as a coroutine returning simd_prefetch_task<R>, which says where it will read next with
+ *
+ *   co_await simd_prefetch(ptr);
+ *
+ * That issues a prefetch for ptr and suspends the lookup. simd_group_prefetch<K>(n, lookup, fn)
+ * keeps K lookups in flight: it resumes them round-robin, thus every lookup continues after K - 1
+ * other lookups issued their prefetches, when its cache line has likely arrived. The results of
+ * finished lookups are collected into simd<R, K> batches and handed to
+ *
+ *   fn(const simd<R, K>& values, const simd<uint32_t, K>& ids, const simd<R, K>::mask_type& k)
+ *
+ * where ids holds the argument passed to lookup(id) and k marks the valid lanes (all but the last
+ * batch are full). Batches are in completion order, not in id order.
+ *
+ * K should be about the number of outstanding L1 misses a core supports (10-20 on current x86).
+ * n must not exceed 2^32 (otherwise length_error is thrown). An exception thrown from a lookup
+ * destroys the other lookups in flight and propagates out of simd_group_prefetch.
+ */
+
+namespace std
+{
+  namespace __detail
+  {
+    // Recycles coroutine frames of one size per thread: a lookup is far too short to pay for
+    // operator new and delete.
+    class _FrameCache
+    {
+      struct _Block
+      {
+        _Block* _M_next;
+      };
+
+      size_t _M_size = 0;
+
+      _Block* _M_free = nullptr;
+
+    public:
+      ~_FrameCache()
+      {
+        while (_M_free)
+          ::operator delete(std::exchange(_M_free, _M_free->_M_next), _M_size);
+      }
+
+      static _FrameCache&
+      _S_instance() noexcept
+      {
+        static thread_local _FrameCache __cache;
+        return __cache;
+      }
+
+      void*
+      _M_allocate(size_t __size)
+      {
+        if (__size == _M_size and _M_free)
+          return std::exchange(_M_free, _M_free->_M_next);
+        return ::operator new(__size);
+      }
+
+      void
+      _M_deallocate(void* __ptr, size_t __size) noexcept
+      {
+        if (_M_size == 0 and __size >= sizeof(_Block))
+          _M_size = __size;
+        if (__size == _M_size)
+          _M_free = ::new(__ptr) _Block{_M_free};
+        else
+          ::operator delete(__ptr, __size);
+      }
+    };
+  }
+
+  template <__detail::__vectorizable _Rp>
+    class simd_prefetch_task
+    {
+    public:
+      using value_type = _Rp;
+
+      struct promise_type
+      {
+        _Rp _M_value = {};
+
+        static void*
+        operator new(size_t __size)
+        { return __detail::_FrameCache::_S_instance()._M_allocate(__size); }
+
+        static void
+        operator delete(void* __ptr, size_t __size) noexcept
+        { __detail::_FrameCache::_S_instance()._M_deallocate(__ptr, __size); }
+
+        simd_prefetch_task
+        get_return_object() noexcept
+        { return simd_prefetch_task(coroutine_handle<promise_type>::from_promise(*this)); }
+
+        // lookups start on the first resume from the driver
+        suspend_always
+        initial_suspend() const noexcept
+        { return {}; }
+
+        suspend_always
+        final_suspend() const noexcept
+        { return {}; }
+
+        void
+        return_value(_Rp __x) noexcept
+        { _M_value = __x; }
+
+        [[noreturn]] void
+        unhandled_exception()
+        { throw; }
+      };
+
+    private:
+      coroutine_handle<promise_type> _M_handle;
+
+      explicit
+      simd_prefetch_task(coroutine_handle<promise_type> __h) noexcept
+      : _M_handle(__h)
+      {}
+
+    public:
+      simd_prefetch_task() = default;
+
+      simd_prefetch_task(simd_prefetch_task&& __x) noexcept
+      : _M_handle(std::exchange(__x._M_handle, nullptr))
+      {}
+
+      simd_prefetch_task&
+      operator=(simd_prefetch_task&& __x) noexcept
+      {
+        simd_prefetch_task(std::move(__x)).swap(*this);
+        return *this;
+      }
+
+      ~simd_prefetch_task()
+      {
+        if (_M_handle)
+          _M_handle.destroy();
+      }
+
+      void
+      swap(simd_prefetch_task& __x) noexcept
+      { std::swap(_M_handle, __x._M_handle); }
+
+      explicit
+      operator bool() const noexcept
+      { return bool(_M_handle); }
+
+      /// Runs the lookup to its next suspension; returns whether it finished.
+      bool
+      resume()
+      {
+        _M_handle.resume();
+        return _M_handle.done();
+      }
+
+      _Rp
+      value() const noexcept
+      { return _M_handle.promise()._M_value; }
+    };
+
+  /// Awaitable: prefetches the cache line at @p __ptr and suspends the lookup.
+  template <typename _Tp>
+    constexpr auto
+    simd_prefetch(const _Tp* __ptr) noexcept
+    {
+      struct _Awaiter
+      {
+        const _Tp* _M_ptr;
+
+        constexpr bool
+        await_ready() const noexcept
+        { return false; }
+
+        _GLIBCXX_SIMD_ALWAYS_INLINE void
+        await_suspend(coroutine_handle<>) const noexcept
+        { __builtin_prefetch(static_cast<const void*>(_M_ptr), 0, 3); }
+
+        constexpr void
+        await_resume() const noexcept
+        {}
+      };
+
+      return _Awaiter{__ptr};
+    }
+
+  namespace __detail
+  {
+    template <typename _Tp>
+      inline constexpr bool __is_prefetch_task = false;
+
+    template <typename _Rp>
+      inline constexpr bool __is_prefetch_task<simd_prefetch_task<_Rp>> = true;
+  }
+
+  /// Runs @p __lookup(id) for all ids in [0, @p __n), @p _Np at a time, and passes the results to
+  /// @p __fn in batches of @p _Np.
+  template <int _Np, typename _Fp, typename _Gp>
+    requires (_Np > 0 and _Np <= 64)
+      and __detail::__is_prefetch_task<invoke_result_t<_Fp&, size_t>>
+    void
+    simd_group_prefetch(size_t __n, _Fp&& __lookup, _Gp&& __fn)
+    {
+      using _Task = invoke_result_t<_Fp&, size_t>;
+      using _Rp = typename _Task::value_type;
+      using _Vp = simd<_Rp, _Np>;
+      using _Ids = simd<uint32_t, _Np>;
+
+      // the ids are passed as uint32_t
+      if (uint64_t(__n) > uint64_t(UINT32_MAX) + 1)
+        __throw_length_error("simd_group_prefetch: more than 2^32 ids");
+
+      array<_Task, _Np> __lanes;
+      array<uint32_t, _Np> __lane_ids;
+
+      // the batch of finished lookups
+      array<_Rp, _Np> __values = {};
+      array<uint32_t, _Np> __ids = {};
+      int __count = 0;
+
+      auto __flush = [&] {
+        __fn(_Vp(__values.begin()), _Ids(__ids.begin()), iota_v<_Vp> < _Rp(__count));
+        __count = 0;
+      };
+
+      auto __collect = [&](int __lane) {
+        __values[__count] = __lanes[__lane].value();
+        __ids[__count] = __lane_ids[__lane];
+        if (++__count == _Np)
+          __flush();
+      };
+
+      // starts lookups in __lane until one suspends; returns false if none are left
+      size_t __next = 0;
+      auto __start = [&](int __lane) {
+        while (__next < __n)
+          {
+            __lane_ids[__lane] = uint32_t(__next);
+            __lanes[__lane] = __lookup(__next++);
+            if (not __lanes[__lane].resume())
+              return true;
+            __collect(__lane);
+          }
+        __lanes[__lane] = _Task();
+        return false;
+      };
+
+      int __active = 0;
+      for (int __lane = 0; __lane < _Np; ++__lane)
+        __active += __start(__lane);
+      while (__active > 0)
+        for (int __lane = 0; __lane < _Np; ++__lane)
+          if (__lanes[__lane] and __lanes[__lane].resume())
+            {
+              __collect(__lane);
+              __active -= not __start(__lane);
+            }
+      if (__count > 0)
+        {
+          for (int __i = __count; __i < _Np; ++__i)
+            {
+              __values[__i] = _Rp();
+              __ids[__i] = 0;
+            }
+          __flush();
+        }
+    }
+}
+
+#endif  // PROTOTYPE_SIMD_GROUP_PREFETCH_H_
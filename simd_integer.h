@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_INTEGER_H_
+#define PROTOTYPE_SIMD_INTEGER_H_
+
+#include "simd.h"
+
+// Saturating, averaging, and absolute-difference arithmetic on integer simds.
+// add_sat and sub_sat follow the C++26 <numeric> functions of the same name. avg, abs_diff, and
+// sad are extensions (e.g. for pixel and audio processing).
+
+namespace std
+{
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+    add_sat(const basic_simd<_Tp, _Abi>& __x, const basic_simd<_Tp, _Abi>& __y) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      return {__detail::__private_init, _Impl::_S_add_sat(__data(__x), __data(__y))};
+    }
+
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+    sub_sat(const basic_simd<_Tp, _Abi>& __x, const basic_simd<_Tp, _Abi>& __y) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      return {__detail::__private_init, _Impl::_S_sub_sat(__data(__x), __data(__y))};
+    }
+
+  /**
+   * Returns (x + y + 1) >> 1 for every element, computed without overflow.
+   */
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<_Tp, _Abi>
+    avg(const basic_simd<_Tp, _Abi>& __x, const basic_simd<_Tp, _Abi>& __y) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      return {__detail::__private_init, _Impl::_S_avg(__data(__x), __data(__y))};
+    }
+
+  /**
+   * Returns |x - y| for every element. The return type is unsigned, so that the difference of
+   * signed values cannot overflow.
+   */
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr basic_simd<make_unsigned_t<_Tp>, _Abi>
+    abs_diff(const basic_simd<_Tp, _Abi>& __x, const basic_simd<_Tp, _Abi>& __y) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      using _Rp = basic_simd<make_unsigned_t<_Tp>, _Abi>;
+      const basic_simd<_Tp, _Abi> __d(__detail::__private_init,
+                                      _Impl::_S_abs_diff(__data(__x), __data(__y)));
+      if constexpr (is_unsigned_v<_Tp>)
+        return __d;
+      else
+        {
+          // signed and unsigned integers of equal size have equal storage layout
+          static_assert(sizeof(_Rp) == sizeof(__d));
+          return __builtin_bit_cast(_Rp, __d);
+        }
+    }
+
+  /**
+   * Returns the sum of absolute differences of all elements. The sum cannot overflow for 8- and
+   * 16-bit value types; for larger value types it wraps.
+   */
+  template <__detail::__signed_or_unsigned_integer _Tp, typename _Abi>
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr __detail::__sad_result_t<_Tp>
+    sad(const basic_simd<_Tp, _Abi>& __x, const basic_simd<_Tp, _Abi>& __y) noexcept
+    {
+      using _Impl = typename basic_simd<_Tp, _Abi>::_Impl;
+      return _Impl::_S_sad(__data(__x), __data(__y));
+    }
+}
+
+#endif  // PROTOTYPE_SIMD_INTEGER_H_
@@ -0,0 +1,248 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_LOOP_H_
+#define PROTOTYPE_SIMD_LOOP_H_
+
+#include "simd.h"
+#include "iota.h"
+
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+
+/* A loop driver with an aligned main body
+ * =======================================
+ *
+ * simd_for_each_aligned<V>(range, fn) calls fn with proxies for consecutive chunks of range:
+ *
+ * 1. A partial head chunk of at most V::size() elements, up to the first element that is aligned
+ *    to simd_alignment_v<V>. There is no head chunk if the range is already aligned.
+ * 2. Full chunks, loaded and stored with simd_flag_aligned. (If V::size() * sizeof(T) is not a
+ *    multiple of the alignment, the chunks cannot all be aligned and are accessed unaligned.)
+ * 3. A partial tail chunk with the remaining elements, if any.
+ *
+ * The proxies provide index() (the offset of lane 0 in the range), size(), mask() (the lanes that
+ * are part of the chunk), load() (lanes outside of mask() are zero), and store(x) (writes only the
+ * lanes in mask()). is_partial tells at compile time whether a proxy is a head/tail chunk, so fn is
+ * a generic callable.
+ *
+ * The head chunk is loaded with a full-width (unaligned) load whenever the range extends far
+ * enough. The tail chunk is loaded via simd_partial_load. Pass __simd_flag_page_safe as the last
+ * argument to let it read past the end of the range if that cannot fault (see below).
+ *
+ * simd_partial_load<V>(ptr, n, flags) loads min(n, V::size()) elements and zeros the other lanes.
+ * With __simd_flag_page_safe (and _GLIBCXX_SIMD_PAGE_SAFE_OVERREAD, which is 0 in sanitizer
+ * builds) it loads a full vector and zeros the excess lanes in registers, unless the full-width read
+ * would cross a page boundary. Otherwise, it copies the elements via a buffer on the stack.
+ *
+ * Pass __simd_flag_prefetch_stream<Distance> to prefetch the range ahead of the full chunks. The
+ * loop issues one prefetch per cache line, Distance bytes ahead. The default (Distance = 0) is
+ * _GLIBCXX_SIMD_PREFETCH_DISTANCE, but at least four chunks. Prefetches are for writing unless the
+ * range is const. This only pays off for ranges that are not in the cache already.
+ */
+
+namespace std
+{
+  template <__detail::__simd_type _Vp, typename... _Flags>
+    _GLIBCXX_SIMD_ALWAYS_INLINE inline _Vp
+    simd_partial_load(const typename _Vp::value_type* __ptr, size_t __n,
+                      simd_flags<_Flags...> __flags = {}) noexcept
+    {
+      using _Tp = typename _Vp::value_type;
+      constexpr size_t __width = _Vp::size();
+      if (__n >= __width)
+        return _Vp(__ptr, __flags);
+#if _GLIBCXX_SIMD_PAGE_SAFE_OVERREAD
+      if constexpr (__flags._M_test(__simd_flag_page_safe))
+        {
+          // a non-power-of-2 width might be loaded with the next larger vector
+          constexpr size_t __bytes = std::__bit_ceil(__width * sizeof(_Tp));
+          static_assert(__bytes <= __detail::__min_page_size);
+          // for __n == 0, __ptr may point to the next page
+          if (__n > 0 and (reinterpret_cast<uintptr_t>(__ptr) % __detail::__min_page_size)
+                            + __bytes <= __detail::__min_page_size) [[likely]]
+            return simd_select(iota_v<_Vp> < _Tp(__n), _Vp(__ptr, __flags), _Vp());
+        }
+#endif
+      _Tp __tmp[__width] = {};
+      std::memcpy(__tmp, __ptr, __n * sizeof(_Tp));
+      return _Vp(&__tmp[0]);
+    }
+
+  namespace __detail
+  {
+    // distance of loop-level prefetches for chunks of _Stride bytes, in whole cache lines
+    template <size_t _Stride, size_t _Distance>
+      inline constexpr size_t __prefetch_distance
+        = ((_Distance != 0 ? _Distance
+                           : std::max(size_t(_GLIBCXX_SIMD_PREFETCH_DISTANCE), 4 * _Stride))
+             + __cache_line_size - 1) & ~(__cache_line_size - 1);
+
+    // the prefetch distance requested by the flag _Fp (0: no prefetching)
+    template <size_t _Stride, typename _Fp>
+      inline constexpr size_t __stream_prefetch_distance = 0;
+
+    template <size_t _Stride, size_t _Distance>
+      inline constexpr size_t __stream_prefetch_distance<_Stride, _PrefetchStream<_Distance>>
+        = __prefetch_distance<_Stride, _Distance>;
+
+    // Prefetches the cache lines that start in [__ptr, __ptr + _Stride), _Distance bytes ahead.
+    // Called for consecutive chunks, this issues exactly one prefetch per cache line.
+    template <size_t _Stride, size_t _Distance, typename _Tp>
+      _GLIBCXX_SIMD_INTRINSIC void
+      __prefetch_chunk(_Tp* __ptr)
+      {
+        if constexpr (_Distance != 0)
+          {
+            const uintptr_t __addr = reinterpret_cast<uintptr_t>(__ptr);
+            for (uintptr_t __off = -__addr % __cache_line_size; __off < _Stride;
+                 __off += __cache_line_size)
+              __builtin_prefetch(reinterpret_cast<const void*>(__addr + __off + _Distance),
+                                 not is_const_v<_Tp>, 3);
+          }
+      }
+
+    template <typename _Vp, typename _Tp, typename _Flags, bool _Partial>
+      class _SimdLoopChunk
+      {
+        static constexpr size_t _S_width = _Vp::size();
+
+        _Tp* _M_ptr;
+
+        size_t _M_index;
+
+        size_t _M_size;
+
+        // number of elements in the range starting at _M_ptr
+        size_t _M_readable;
+
+      public:
+        using simd_type = _Vp;
+
+        using mask_type = typename _Vp::mask_type;
+
+        static constexpr bool is_partial = _Partial;
+
+        _GLIBCXX_SIMD_INTRINSIC constexpr
+        _SimdLoopChunk(_Tp* __ptr, size_t __index, size_t __size = _S_width,
+                       size_t __readable = _S_width) noexcept
+        : _M_ptr(__ptr), _M_index(__index), _M_size(__size), _M_readable(__readable)
+        {}
+
+        /// Offset of lane 0 in the range.
+        _GLIBCXX_SIMD_INTRINSIC constexpr size_t
+        index() const noexcept
+        { return _M_index; }
+
+        /// Number of elements in the chunk.
+        _GLIBCXX_SIMD_INTRINSIC constexpr size_t
+        size() const noexcept
+        {
+          if constexpr (_Partial)
+            return _M_size;
+          else
+            return _S_width;
+        }
+
+        _GLIBCXX_SIMD_INTRINSIC constexpr mask_type
+        mask() const noexcept
+        { return iota_v<_Vp> < typename _Vp::value_type(size()); }
+
+        _GLIBCXX_SIMD_INTRINSIC _Vp
+        load() const noexcept
+        {
+          if constexpr (_Partial)
+            {
+              if (_M_readable >= _S_width)
+                return simd_select(mask(), _Vp(_M_ptr), _Vp());
+              else
+                return simd_partial_load<_Vp>(_M_ptr, _M_size, _Flags());
+            }
+          else
+            return _Vp(_M_ptr, _Flags());
+        }
+
+        _GLIBCXX_SIMD_INTRINSIC void
+        store(const _Vp& __x) const noexcept
+        requires (not is_const_v<_Tp>)
+        {
+          if constexpr (_Partial)
+            {
+              if (_M_readable >= _S_width)
+                {
+                  // read-modify-write of elements that belong to the range (the next chunk)
+                  simd_select(mask(), __x, _Vp(_M_ptr)).copy_to(_M_ptr);
+                  return;
+                }
+              _Tp __tmp[_S_width];
+              __x.copy_to(&__tmp[0]);
+              std::memcpy(_M_ptr, __tmp, _M_size * sizeof(_Tp));
+            }
+          else
+            __x.copy_to(_M_ptr, _Flags());
+        }
+      };
+  }
+
+  namespace __detail
+  {
+    // simd_for_each_aligned over [__ptr, __ptr + __n), with chunk indexes starting at __first
+    template <typename _Vp, typename _Tp, typename _Fp, typename... _Flags>
+      _GLIBCXX_SIMD_ALWAYS_INLINE inline void
+      __simd_for_each_aligned(_Tp* const __ptr, const size_t __n, const size_t __first,
+                              _Fp& __fn, simd_flags<_Flags...>)
+      {
+        using _Partial = _SimdLoopChunk<_Vp, _Tp, simd_flags<_Flags...>, true>;
+        constexpr size_t __width = _Vp::size();
+        constexpr size_t __alignment = simd_alignment_v<_Vp>;
+        constexpr size_t __stride = __width * sizeof(_Tp);
+        constexpr size_t __prefetch = (__stream_prefetch_distance<__stride, _Flags> + ... + 0);
+        size_t __i = 0;
+        if constexpr (__stride % __alignment == 0)
+          {
+            using _Aligned
+              = _SimdLoopChunk<_Vp, _Tp, decltype(simd_flag_aligned | simd_flags<_Flags...>()),
+                               false>;
+            const size_t __misaligned = reinterpret_cast<uintptr_t>(__ptr) % __alignment;
+            if (__misaligned != 0) [[likely]]
+              {
+                __i = std::min(__n, (__alignment - __misaligned) / sizeof(_Tp));
+                __fn(_Partial(__ptr, __first, __i, __n));
+              }
+            for (; __i + __width <= __n; __i += __width)
+              {
+                __prefetch_chunk<__stride, __prefetch>(__ptr + __i);
+                __fn(_Aligned(__ptr + __i, __first + __i));
+              }
+          }
+        else
+          {
+            using _Unaligned = _SimdLoopChunk<_Vp, _Tp, simd_flags<_Flags...>, false>;
+            for (; __i + __width <= __n; __i += __width)
+              {
+                __prefetch_chunk<__stride, __prefetch>(__ptr + __i);
+                __fn(_Unaligned(__ptr + __i, __first + __i));
+              }
+          }
+        if (__i < __n)
+          __fn(_Partial(__ptr + __i, __first + __i, __n - __i, __n - __i));
+      }
+  }
+
+  template <__detail::__simd_type _Vp, ranges::contiguous_range _Rg, typename _Fp,
+            typename... _Flags>
+    requires ranges::sized_range<_Rg>
+               and same_as<remove_cvref_t<ranges::range_reference_t<_Rg>>,
+                           typename _Vp::value_type>
+    _GLIBCXX_SIMD_ALWAYS_INLINE inline void
+    simd_for_each_aligned(_Rg&& __range, _Fp&& __fn, simd_flags<_Flags...> __flags = {})
+    {
+      __detail::__simd_for_each_aligned<_Vp>(ranges::data(__range), ranges::size(__range), 0,
+                                             __fn, __flags);
+    }
+}
+
+#endif  // PROTOTYPE_SIMD_LOOP_H_
@@ -0,0 +1,221 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_MAPPED_SPAN_H_
+#define PROTOTYPE_SIMD_MAPPED_SPAN_H_
+
+#include "simd.h"
+#include "simd_allocator.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#if __has_include(<sys/mman.h>) and __has_include(<sys/stat.h>) and __has_include(<fcntl.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Read-only simd views of memory-mapped files
+ * ===========================================
+ *
+ * simd_mapped_span<T, V> maps a file (read-only, private) and exposes its contents as a contiguous
+ * range of size() = file size / sizeof(T) elements, e.g. for the basic_simd range constructors,
+ * simd_index, or simd_for_each_aligned. No data is copied; pages are read on first access.
+ *
+ * As with simd_buffer, the range is followed by padding: full-width loads at every multiple of
+ * V::size() up to and including the last partial chunk are legal, i.e. padded() can be processed
+ * without an epilogue. The padding past the end of the file reads as zero. (The last page of the
+ * file is zero-filled by the kernel; a reserved anonymous mapping provides the rest.) data() is
+ * page aligned, thus aligned loads are legal at every multiple of V::size().
+ *
+ * The simd_map_advice argument selects madvise/mmap hints:
+ * - sequential: MADV_SEQUENTIAL, i.e. aggressive read-ahead and early reclaim of pages that have
+ *   been read (the default).
+ * - huge_pages: a 2 MiB aligned mapping and MADV_HUGEPAGE, for files that are large enough. This
+ *   takes effect for files on tmpfs mounted with huge=advise (or huge=always).
+ * - populate: MAP_POPULATE, i.e. all pages are read and mapped by the constructor.
+ *
+ * Errors are reported with std::system_error.
+ */
+
+namespace std
+{
+  enum class simd_map_advice : unsigned
+  {
+    normal = 0,
+    sequential = 1,
+    huge_pages = 2,
+    populate = 4
+  };
+
+  constexpr simd_map_advice
+  operator|(simd_map_advice __a, simd_map_advice __b) noexcept
+  { return simd_map_advice(unsigned(__a) | unsigned(__b)); }
+
+  constexpr bool
+  operator&(simd_map_advice __a, simd_map_advice __b) noexcept
+  { return (unsigned(__a) & unsigned(__b)) != 0; }
+
+  template <__detail::__vectorizable _Tp, __detail::__simd_type _Vp = simd<_Tp>>
+    class simd_mapped_span
+    {
+      static constexpr size_t _S_width = _Vp::size();
+
+      const _Tp* _M_data = nullptr;
+
+      size_t _M_size = 0;
+
+      // the size of the mapping, including the padding
+      size_t _M_map_bytes = 0;
+
+      [[noreturn]] static void
+      _S_throw_errno(int __fd)
+      {
+        const int __err = errno;
+        if (__fd >= 0)
+          ::close(__fd);
+        __throw_system_error(__err);
+      }
+
+    public:
+      using value_type = _Tp;
+
+      using size_type = size_t;
+
+      using iterator = const _Tp*;
+
+      using const_iterator = const _Tp*;
+
+      static constexpr auto simd_size = __detail::__ic<_S_width>;
+
+      simd_mapped_span() = default;
+
+      /// Maps the file at @p __path.
+      explicit
+      simd_mapped_span(const char* __path,
+                       simd_map_advice __advice = simd_map_advice::sequential)
+      {
+        const int __fd = ::open(__path, O_RDONLY | O_CLOEXEC);
+        if (__fd < 0)
+          _S_throw_errno(__fd);
+        struct stat __st;
+        if (::fstat(__fd, &__st) != 0)
+          _S_throw_errno(__fd);
+        const size_t __file_bytes = size_t(__st.st_size);
+        const size_t __page = size_t(::sysconf(_SC_PAGESIZE));
+        const bool __huge = (__advice & simd_map_advice::huge_pages)
+                              and __file_bytes >= __detail::__simd_huge_page_size;
+        const size_t __align = __huge ? __detail::__simd_huge_page_size : __page;
+        _M_size = __file_bytes / sizeof(_Tp);
+        _M_map_bytes = (__file_bytes + _S_width * sizeof(_Tp) + __page - 1) / __page * __page;
+
+        // reserve zero pages for the file and its padding (plus slack for the alignment)
+        const size_t __reserved_bytes = _M_map_bytes + __align - __page;
+        void* const __reserved = ::mmap(nullptr, __reserved_bytes, PROT_READ,
+                                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (__reserved == MAP_FAILED)
+          _S_throw_errno(__fd);
+        const uintptr_t __begin = reinterpret_cast<uintptr_t>(__reserved);
+        const uintptr_t __aligned = (__begin + __align - 1) / __align * __align;
+        if (__aligned != __begin)
+          ::munmap(__reserved, __aligned - __begin);
+        if (__aligned + _M_map_bytes != __begin + __reserved_bytes)
+          ::munmap(reinterpret_cast<void*>(__aligned + _M_map_bytes),
+                   __begin + __reserved_bytes - __aligned - _M_map_bytes);
+        void* const __base = reinterpret_cast<void*>(__aligned);
+
+        // replace the start of the reservation with the file
+        if (__file_bytes > 0)
+          {
+            int __flags = MAP_PRIVATE | MAP_FIXED;
+#ifdef MAP_POPULATE
+            if (__advice & simd_map_advice::populate)
+              __flags |= MAP_POPULATE;
+#endif
+            if (::mmap(__base, __file_bytes, PROT_READ, __flags, __fd, 0) == MAP_FAILED)
+              {
+                const int __err = errno;
+                ::munmap(__base, _M_map_bytes);
+                ::close(__fd);
+                __throw_system_error(__err);
+              }
+          }
+        ::close(__fd);
+#ifdef MADV_HUGEPAGE
+        if (__huge)
+          ::madvise(__base, _M_map_bytes, MADV_HUGEPAGE);
+#endif
+        if (__advice & simd_map_advice::sequential)
+          ::madvise(__base, _M_map_bytes, MADV_SEQUENTIAL);
+        _M_data = static_cast<const _Tp*>(__base);
+      }
+
+      simd_mapped_span(const simd_mapped_span&) = delete;
+
+      simd_mapped_span(simd_mapped_span&& __other) noexcept
+      : _M_data(std::exchange(__other._M_data, nullptr)),
+        _M_size(std::exchange(__other._M_size, 0)),
+        _M_map_bytes(std::exchange(__other._M_map_bytes, 0))
+      {}
+
+      simd_mapped_span&
+      operator=(simd_mapped_span __other) noexcept
+      {
+        std::swap(_M_data, __other._M_data);
+        std::swap(_M_size, __other._M_size);
+        std::swap(_M_map_bytes, __other._M_map_bytes);
+        return *this;
+      }
+
+      ~simd_mapped_span()
+      {
+        if (_M_data)
+          ::munmap(const_cast<_Tp*>(_M_data), _M_map_bytes);
+      }
+
+      size_t
+      size() const noexcept
+      { return _M_size; }
+
+      /// size() rounded up to a multiple of simd_size.
+      size_t
+      padded_size() const noexcept
+      { return (_M_size + _S_width - 1) / _S_width * _S_width; }
+
+      bool
+      empty() const noexcept
+      { return _M_size == 0; }
+
+      const _Tp*
+      data() const noexcept
+      { return _M_data; }
+
+      const _Tp&
+      operator[](size_t __i) const noexcept
+      { return _M_data[__i]; }
+
+      const_iterator
+      begin() const noexcept
+      { return _M_data; }
+
+      const_iterator
+      end() const noexcept
+      { return _M_data + _M_size; }
+
+      operator span<const _Tp>() const noexcept
+      { return {_M_data, _M_size}; }
+
+      /// The range including its padding, for full-width loads of the last chunk.
+      span<const _Tp>
+      padded() const noexcept
+      { return {_M_data, padded_size()}; }
+    };
+}
+#endif
+
+#endif  // PROTOTYPE_SIMD_MAPPED_SPAN_H_
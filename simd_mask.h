@@ -155,7 +155,9 @@ namespace std
                 else if constexpr (_S_is_bitmask)
                   return ((uint64_t(__gen(__detail::__ic<_Is>)) << _Is) | ...);
                 else
-                  return _MemberType { -__gen(__detail::__ic<_Is>)... };
+                  return _MemberType {
+                           __detail::__value_type_of<_MemberType>(-__gen(__detail::__ic<_Is>))...
+                         };
               }
           }(__detail::_MakeSimdIndexSequence<size()>()))
         {}
@@ -21,6 +21,15 @@ namespace std::__detail
   template <typename _Tp>
     concept __arithmetic = integral<_Tp> || floating_point<_Tp>;
 
+  // signed and unsigned integer types, i.e. not bool or character types ([basic.fundamental])
+  template <typename _Tp>
+    concept __signed_or_unsigned_integer = __is_standard_integer<_Tp>::value;
+
+  // The integer type returned from a sum of absolute differences. Sufficient to never overflow for
+  // 8- and 16-bit value types.
+  template <integral _Tp>
+    using __sad_result_t = __make_unsigned_int_t<decltype(_Tp() + _Tp())>;
+
   template <typename _Abi>
     concept __simd_abi_tag
       = not _Abi::template _IsValid<void>::value
@@ -0,0 +1,176 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_NUMA_H_
+#define PROTOTYPE_SIMD_NUMA_H_
+
+#include <algorithm>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if __has_include(<sched.h>) and __has_include(<pthread.h>) and defined __linux__
+#include <pthread.h>
+#include <sched.h>
+#define _GLIBCXX_SIMD_HAVE_CPU_AFFINITY 1
+#else
+#define _GLIBCXX_SIMD_HAVE_CPU_AFFINITY 0
+#endif
+
+/* NUMA topology
+ * =============
+ *
+ * simd_numa_topology lists the NUMA nodes of the machine and the CPUs of every node, as read from
+ * /sys/devices/system/node (node<N>/cpulist for every node in the "online" list). The default
+ * constructor only keeps the CPUs the process may run on (sched_getaffinity) and drops nodes
+ * without such CPUs (e.g. memory-only nodes). Where sysfs (or the node directory) is not
+ * available, the topology is a single node with all CPUs. The constructor with a directory
+ * argument reads an arbitrary directory with the layout of /sys/devices/system/node, unfiltered.
+ *
+ * simd_executor(topology, threads) creates workers pinned to CPUs of the topology, spread evenly
+ * over the nodes (see simd_executor.h).
+ */
+
+namespace std
+{
+  struct simd_numa_node
+  {
+    /// The node number (N in /sys/devices/system/node/nodeN).
+    unsigned id;
+
+    /// The CPUs of the node, ascending.
+    vector<unsigned> cpus;
+  };
+
+  class simd_numa_topology
+  {
+    vector<simd_numa_node> _M_nodes;
+
+    // the numbers in a sysfs list such as "0-3,8-11" (empty if the file does not exist)
+    static vector<unsigned>
+    _S_read_list(const string& __path)
+    {
+      vector<unsigned> __r;
+      ifstream __file(__path);
+      string __line;
+      if (not getline(__file, __line))
+        return __r;
+      string_view __list = __line;
+      while (not __list.empty())
+        {
+          const size_t __comma = __list.find(',');
+          const string_view __range = __list.substr(0, __comma);
+          __list = __comma == string_view::npos ? string_view() : __list.substr(__comma + 1);
+          size_t __i = 0;
+          auto __number = [&] {
+            unsigned __x = 0;
+            for (; __i < __range.size() and __range[__i] >= '0' and __range[__i] <= '9'; ++__i)
+              __x = __x * 10 + (__range[__i] - '0');
+            return __x;
+          };
+          const unsigned __first = __number();
+          if (__i == 0)
+            continue;
+          const unsigned __last
+            = __i < __range.size() and __range[__i] == '-' ? (++__i, __number()) : __first;
+          for (unsigned __cpu = __first; __cpu <= __last; ++__cpu)
+            __r.push_back(__cpu);
+        }
+      return __r;
+    }
+
+    void
+    _M_read(const string& __dir)
+    {
+      for (unsigned __node : _S_read_list(__dir + "/online"))
+        {
+          vector<unsigned> __cpus
+            = _S_read_list(__dir + "/node" + to_string(__node) + "/cpulist");
+          _M_nodes.push_back({__node, std::move(__cpus)});
+        }
+    }
+
+  public:
+    /// The topology of this machine, restricted to the CPUs this process may run on.
+    simd_numa_topology()
+    {
+      _M_read("/sys/devices/system/node");
+#if _GLIBCXX_SIMD_HAVE_CPU_AFFINITY
+      cpu_set_t __allowed;
+      CPU_ZERO(&__allowed);
+      if (sched_getaffinity(0, sizeof(__allowed), &__allowed) == 0)
+        {
+          if (_M_nodes.empty())
+            _M_nodes.push_back({0, {}});
+          for (simd_numa_node& __node : _M_nodes)
+            {
+              if (__node.cpus.empty() and _M_nodes.size() == 1)
+                for (unsigned __cpu = 0; __cpu < CPU_SETSIZE; ++__cpu)
+                  __node.cpus.push_back(__cpu);
+              std::erase_if(__node.cpus, [&](unsigned __cpu) {
+                return __cpu >= CPU_SETSIZE or not CPU_ISSET(__cpu, &__allowed);
+              });
+            }
+        }
+#endif
+      std::erase_if(_M_nodes, [](const simd_numa_node& __node) { return __node.cpus.empty(); });
+      if (_M_nodes.empty())
+        {
+          _M_nodes.push_back({0, {}});
+          for (unsigned __cpu = 0; __cpu < std::max(1u, thread::hardware_concurrency()); ++__cpu)
+            _M_nodes[0].cpus.push_back(__cpu);
+        }
+    }
+
+    /// The topology described by @p __dir (with the layout of /sys/devices/system/node).
+    explicit
+    simd_numa_topology(const string& __dir)
+    {
+      _M_read(__dir);
+      std::erase_if(_M_nodes, [](const simd_numa_node& __node) { return __node.cpus.empty(); });
+      if (_M_nodes.empty())
+        _M_nodes.push_back({0, {0}});
+    }
+
+    span<const simd_numa_node>
+    nodes() const noexcept
+    { return _M_nodes; }
+
+    /// The number of CPUs on all nodes.
+    unsigned
+    cpus() const noexcept
+    {
+      size_t __n = 0;
+      for (const simd_numa_node& __node : _M_nodes)
+        __n += __node.cpus.size();
+      return __n;
+    }
+  };
+
+  namespace __detail
+  {
+    // Pins the thread __handle to __cpu. Failure is not an error: the thread runs unpinned.
+    inline void
+    __pin_thread(thread::native_handle_type __handle, unsigned __cpu) noexcept
+    {
+#if _GLIBCXX_SIMD_HAVE_CPU_AFFINITY
+      if (__cpu >= CPU_SETSIZE)
+        return;
+      cpu_set_t __set;
+      CPU_ZERO(&__set);
+      CPU_SET(__cpu, &__set);
+      pthread_setaffinity_np(__handle, sizeof(__set), &__set);
+#else
+      (void) __handle;
+      (void) __cpu;
+#endif
+    }
+  }
+}
+
+#endif  // PROTOTYPE_SIMD_NUMA_H_
@@ -0,0 +1,222 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_PIPELINE_H_
+#define PROTOTYPE_SIMD_PIPELINE_H_
+
+#include "simd.h"
+#include "simd_allocator.h"
+#include "simd_loop.h"
+
+#include <atomic>
+#include <exception>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+/* Fused element-wise pipelines
+ * ============================
+ *
+ * simd_pipeline composes element-wise stages, i.e. callables that map a basic_simd to a basic_simd
+ * of the same width (the value type may change):
+ *
+ *   auto p = simd_pipeline() | [](auto x) { return x * 2; } | [](auto x) { return x + 1; };
+ *
+ * A pipeline is itself such a callable, applying all stages to one simd value while it is in
+ * registers. Therefore a single pass over the data applies all stages, instead of one pass per
+ * stage with intermediate arrays.
+ *
+ * simd_transform<V>(in, out, fn) is that single pass: out[i] = fn(in[i]) for the contiguous ranges
+ * in and out, in chunks of V::size() elements (driven by simd_for_each_aligned over in). The lanes
+ * of a partial chunk beyond the range are copies of its first element, thus fn only ever sees
+ * values from in (e.g. no division by zero).
+ *
+ * simd_stream<V>(source, fn, sink) runs fn over a stream of blocks. A producer thread calls
+ * source(span<T>) to fill the next block (returning the number of elements, 0 for the end of the
+ * stream) while the calling thread transforms the previous block and passes the result to
+ * sink(span<const U>). The two input blocks (double buffering) and the output block fit into the
+ * L1 cache together (__pipeline_block_bytes), thus the intermediate results never leave L1.
+ * Exceptions thrown by source, fn, or sink are rethrown from simd_stream.
+ */
+
+namespace std
+{
+  namespace __detail
+  {
+    // the L1 budget for the blocks of simd_stream (two input blocks and one output block)
+    inline constexpr size_t __pipeline_block_bytes = 16 << 10;
+
+    template <typename _Vp>
+      _GLIBCXX_SIMD_INTRINSIC constexpr _Vp
+      __apply_stages(_Vp __x)
+      { return __x; }
+
+    template <typename _Vp, typename _F0, typename... _Fs>
+      _GLIBCXX_SIMD_INTRINSIC constexpr auto
+      __apply_stages(_Vp __x, const _F0& __f0, const _Fs&... __fs)
+      { return __apply_stages(__f0(__x), __fs...); }
+
+    // the value type of fn(_Vp)
+    template <typename _Vp, typename _Fp>
+      using __stage_value_t = typename invoke_result_t<const _Fp&, _Vp>::value_type;
+
+    // _Fp maps _Vp to a simd type of the same width
+    template <typename _Fp, typename _Vp>
+      concept __simd_stage = requires(const _Fp& __f, _Vp __x) {
+        { __f(__x) } -> __simd_type;
+        requires invoke_result_t<const _Fp&, _Vp>::size() == _Vp::size();
+      };
+  }
+
+  template <typename... _Stages>
+    class simd_pipeline
+    {
+      template <typename...>
+        friend class simd_pipeline;
+
+      [[no_unique_address]] tuple<_Stages...> _M_stages;
+
+    public:
+      constexpr explicit
+      simd_pipeline(_Stages... __stages)
+      : _M_stages(std::move(__stages)...)
+      {}
+
+      /// Appends the element-wise stage @p __f.
+      template <typename _Fp>
+        friend constexpr simd_pipeline<_Stages..., decay_t<_Fp>>
+        operator|(simd_pipeline __p, _Fp&& __f)
+        {
+          return std::apply([&](_Stages&... __s) {
+                   return simd_pipeline<_Stages..., decay_t<_Fp>>(std::move(__s)...,
+                                                                  std::forward<_Fp>(__f));
+                 }, __p._M_stages);
+        }
+
+      /// Applies all stages to @p __x.
+      template <__detail::__simd_type _Vp>
+        _GLIBCXX_SIMD_INTRINSIC constexpr auto
+        operator()(_Vp __x) const
+        {
+          return std::apply([&](const _Stages&... __s) {
+                   return __detail::__apply_stages(__x, __s...);
+                 }, _M_stages);
+        }
+    };
+
+  /// out[i] = fn(in[i]) in a single pass, in chunks of _Vp::size() elements.
+  template <__detail::__simd_type _Vp, ranges::contiguous_range _Rin,
+            ranges::contiguous_range _Rout, __detail::__simd_stage<_Vp> _Fp>
+    requires ranges::sized_range<_Rin>
+               and same_as<remove_cvref_t<ranges::range_reference_t<_Rin>>,
+                           typename _Vp::value_type>
+               and same_as<ranges::range_value_t<_Rout>, __detail::__stage_value_t<_Vp, _Fp>>
+    _GLIBCXX_SIMD_ALWAYS_INLINE inline void
+    simd_transform(_Rin&& __in, _Rout&& __out, const _Fp& __fn)
+    {
+      if (ranges::size(__in) == 0)
+        return;
+      auto* const __dst = ranges::data(__out);
+      simd_for_each_aligned<_Vp>(std::span(ranges::data(__in), ranges::size(__in)),
+                                 [&](auto __chunk) {
+        if constexpr (decltype(__chunk)::is_partial)
+          {
+            const _Vp __x = __chunk.load();
+            __fn(simd_select(__chunk.mask(), __x, _Vp(__x[0])))
+              .copy_to(__dst + __chunk.index(), __chunk.mask());
+          }
+        else
+          __fn(__chunk.load()).copy_to(__dst + __chunk.index());
+      });
+    }
+
+  /// Runs @p __fn over the blocks from @p __source, passing the results to @p __sink.
+  template <__detail::__simd_type _Vp, typename _Source, __detail::__simd_stage<_Vp> _Fp,
+            typename _Sink>
+    requires is_invocable_r_v<size_t, _Source&, span<typename _Vp::value_type>>
+               and is_invocable_v<_Sink&, span<const __detail::__stage_value_t<_Vp, _Fp>>>
+    void
+    simd_stream(_Source&& __source, const _Fp& __fn, _Sink&& __sink)
+    {
+      using _Tp = typename _Vp::value_type;
+      using _Up = __detail::__stage_value_t<_Vp, _Fp>;
+      constexpr size_t __width = _Vp::size();
+      constexpr size_t __block
+        = std::max(__width, __detail::__pipeline_block_bytes / (2 * sizeof(_Tp) + sizeof(_Up))
+                              / __width * __width);
+      // a slot holds the number of elements in its block, 0 for the end of the stream, or __free
+      constexpr size_t __free = size_t(-1);
+
+      struct _Slot
+      {
+        simd_buffer<_Tp, _Vp> _M_data = simd_buffer<_Tp, _Vp>(__block);
+
+        atomic<size_t> _M_state{__free};
+      };
+
+      _Slot __slots[2];
+      simd_buffer<_Up> __out(__block);
+      exception_ptr __producer_error;
+
+      jthread __producer([&](stop_token __stop) {
+        for (size_t __k = 0; ; __k ^= 1)
+          {
+            _Slot& __slot = __slots[__k];
+            for (size_t __s; (__s = __slot._M_state.load(memory_order_acquire)) != __free; )
+              __slot._M_state.wait(__s, memory_order_acquire);
+            if (__stop.stop_requested())
+              return;
+            size_t __n = 0;
+            try
+              {
+                __n = std::min(__block, size_t(__source(__slot._M_data.padded())));
+              }
+            catch (...)
+              {
+                __producer_error = current_exception();
+              }
+            __slot._M_state.store(__n, memory_order_release);
+            __slot._M_state.notify_one();
+            if (__n == 0)
+              return;
+          }
+      });
+
+      try
+        {
+          for (size_t __k = 0; ; __k ^= 1)
+            {
+              _Slot& __slot = __slots[__k];
+              size_t __n;
+              while ((__n = __slot._M_state.load(memory_order_acquire)) == __free)
+                __slot._M_state.wait(__free, memory_order_acquire);
+              if (__n == 0)
+                break;
+              simd_transform<_Vp>(span<const _Tp>(__slot._M_data.data(), __n), __out.padded(),
+                                  __fn);
+              __slot._M_state.store(__free, memory_order_release);
+              __slot._M_state.notify_one();
+              __sink(span<const _Up>(__out.data(), __n));
+            }
+        }
+      catch (...)
+        {
+          // release the producer if it waits for a free slot
+          __producer.request_stop();
+          for (_Slot& __slot : __slots)
+            {
+              __slot._M_state.store(__free, memory_order_release);
+              __slot._M_state.notify_one();
+            }
+          throw;
+        }
+      __producer.join();
+      if (__producer_error)
+        rethrow_exception(__producer_error);
+    }
+}
+
+#endif  // PROTOTYPE_SIMD_PIPELINE_H_
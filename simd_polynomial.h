@@ -0,0 +1,150 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_POLYNOMIAL_H_
+#define PROTOTYPE_SIMD_POLYNOMIAL_H_
+
+#include "simd.h"
+#include "permute.h"
+
+#include <array>
+
+// Polynomial evaluation and piecewise linear table interpolation. The polynomial coefficients are
+// passed as constexpr_wrapper objects (e.g. vir::cw<1.f>), in ascending order (c0, c1, c2, ...).
+// Thus multiplications by 0, 1, and -1 and additions of 0 are dropped at compile time, and all
+// remaining constants are broadcasts of compile-time constants.
+
+namespace std
+{
+  namespace __detail
+  {
+    template <typename _Cp, typename _Tp>
+      concept __coefficient_for = __constexpr_wrapper_like<_Cp>
+                                    and convertible_to<decltype(_Cp::value), _Tp>;
+
+    // __c0 + __c1 * __x
+    template <auto __c0, auto __c1, typename _Vp>
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr _Vp
+      __linear(const _Vp& __x)
+      {
+        using _Tp = typename _Vp::value_type;
+        if constexpr (__c1 == _Tp())
+          return _Vp(__c0);
+        else
+          {
+            const _Vp __t = [&] {
+              if constexpr (__c1 == _Tp(1))
+                return __x;
+              else if constexpr (__c1 == _Tp(-1))
+                return -__x;
+              else
+                return __x * __c1;
+            }();
+            if constexpr (__c0 == _Tp())
+              return __t;
+            else
+              return __t + __c0;
+          }
+      }
+
+    template <typename _Vp, typename _C0, typename... _Cs>
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr _Vp
+      __horner(const _Vp& __x)
+      {
+        using _Tp = typename _Vp::value_type;
+        constexpr _Tp __c0 = static_cast<_Tp>(_C0::value);
+        if constexpr (sizeof...(_Cs) == 0)
+          return _Vp(__c0);
+        else if constexpr (sizeof...(_Cs) == 1)
+          return __linear<__c0, static_cast<_Tp>(_Cs::value)...>(__x);
+        else if constexpr (__c0 == _Tp())
+          return __horner<_Vp, _Cs...>(__x) * __x;
+        else
+          return __horner<_Vp, _Cs...>(__x) * __x + __c0;
+      }
+
+    // __p[0] + __p[1] * __x2 + __p[2] * __x2² + ...
+    template <typename _Vp, size_t _Np>
+      _GLIBCXX_SIMD_ALWAYS_INLINE constexpr _Vp
+      __estrin_reduce(const _Vp& __x2, const array<_Vp, _Np>& __p)
+      {
+        if constexpr (_Np == 1)
+          return __p[0];
+        else
+          {
+            array<_Vp, (_Np + 1) / 2> __q;
+            for (size_t __i = 0; __i < _Np / 2; ++__i)
+              __q[__i] = __p[2 * __i + 1] * __x2 + __p[2 * __i];
+            if constexpr (_Np % 2 == 1)
+              __q[_Np / 2] = __p[_Np - 1];
+            return __estrin_reduce(__x2 * __x2, __q);
+          }
+      }
+  }
+
+  /**
+   * Evaluates `c0 + c1 x + c2 x² + ... + cₙ xⁿ` using Horner's scheme (n multiply-adds in a single
+   * dependency chain).
+   */
+  template <__detail::__simd_type _Vp, __detail::__coefficient_for<typename _Vp::value_type>... _Cs>
+    requires (sizeof...(_Cs) > 0)
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr _Vp
+    simd_horner(const _Vp& __x, _Cs...) noexcept
+    { return __detail::__horner<_Vp, _Cs...>(__x); }
+
+  /**
+   * Evaluates `c0 + c1 x + c2 x² + ... + cₙ xⁿ` using Estrin's scheme. This needs more
+   * multiplications than simd_horner but shortens the dependency chain to about 2 log₂(n) operations,
+   * which is faster when latency, rather than throughput, is the bottleneck.
+   */
+  template <__detail::__simd_type _Vp, __detail::__coefficient_for<typename _Vp::value_type>... _Cs>
+    requires (sizeof...(_Cs) > 0)
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr _Vp
+    simd_estrin(const _Vp& __x, _Cs...) noexcept
+    {
+      using _Tp = typename _Vp::value_type;
+      constexpr size_t __n = sizeof...(_Cs);
+      constexpr array<_Tp, __n + 1> __c = {static_cast<_Tp>(_Cs::value)..., _Tp()};
+      return __detail::__estrin_reduce(__x * __x, [&]<size_t... _Is>(index_sequence<_Is...>) {
+               return array<_Vp, (__n + 1) / 2>{
+                 __detail::__linear<__c[2 * _Is], __c[2 * _Is + 1]>(__x)...};
+             }(make_index_sequence<(__n + 1) / 2>()));
+    }
+
+  /**
+   * Piecewise linear interpolation in the table @p __table at the positions @p __x, i.e.
+   * `__table[i] + (__x - i) * (__table[i + 1] - __table[i])` with `i = floor(__x)`. Positions
+   * outside of [0, __table.size() - 1] are clamped to the first/last table entry.
+   *
+   * The table is passed as a simd so that the lookups are permutes (a single variable shuffle
+   * instruction when the table fits into one register) rather than gathers.
+   *
+   * Precondition: No element of @p __x is NaN.
+   */
+  template <__detail::__simd_type _Tab, __detail::__simd_type _Vp>
+    requires floating_point<typename _Vp::value_type>
+               and same_as<typename _Tab::value_type, typename _Vp::value_type>
+               and (_Tab::size() >= 2)
+    _GLIBCXX_SIMD_ALWAYS_INLINE constexpr _Vp
+    simd_lut_interpolate(const _Tab& __table, const _Vp& __x) noexcept
+    {
+      using _Tp = typename _Vp::value_type;
+      using _Ip = rebind_simd_t<__detail::__make_signed_int_t<_Tp>, _Vp>;
+      constexpr _Tp __last = _Tab::size() - 1;
+      const _Vp __xc = simd_select(__x > __last, _Vp(__last),
+                                   simd_select(__x > _Tp(), __x, _Vp()));
+      // truncation is floor for non-negative __xc; the last interval also covers __x == __last.
+      // Converting via int is cheaper than via 64-bit integers for double (without AVX512DQ).
+      using _I32 = rebind_simd_t<int, _Vp>;
+      _I32 __i32 = static_cast<_I32>(__xc);
+      __i32 = simd_select(__i32 > int(_Tab::size() - 2), _I32(int(_Tab::size() - 2)), __i32);
+      const _Vp __frac = __xc - static_cast<_Vp>(__i32);
+      const _Ip __i = static_cast<_Ip>(__i32);
+      const _Tab __slope = simd_permute(__table, simd_permutations::rotate<1>) - __table;
+      return simd_permute(__slope, __i) * __frac + simd_permute(__table, __i);
+    }
+}
+
+#endif  // PROTOTYPE_SIMD_POLYNOMIAL_H_
@@ -53,46 +53,56 @@ namespace std
     reduce(const basic_simd<_Tp, _Abi>& __x, _BinaryOperation __binary_op)
     {
       using _V1 = basic_simd<_Tp, _Abi>;
+      using _Impl = typename __detail::_SimdTraits<_Tp, _Abi>::_SimdImpl;
 
-      if constexpr (requires{__detail::_SimdTraits<_Tp, _Abi>::_SimdImpl::_S_reduce(
-                               __x, __binary_op);} and _V1::size.value > 1)
+      // An _S_reduce that is usable in constant expressions makes the generic implementation
+      // below unnecessary. Not instantiating it saves a lot of compile time for non-power-of-2
+      // sizes.
+      if constexpr (requires { requires _Impl::_S_reduce_is_constexpr; })
+        return _Impl::_S_reduce(__x, __binary_op);
+
+      else
         {
-          if (not __builtin_is_constant_evaluated() and not __x._M_is_constprop())
-            return __detail::_SimdTraits<_Tp, _Abi>::_SimdImpl::_S_reduce(__x, __binary_op);
-        }
+          if constexpr (requires{_Impl::_S_reduce(__x, __binary_op);} and _V1::size.value > 1)
+            {
+              if (not __builtin_is_constant_evaluated() and not __x._M_is_constprop())
+                return _Impl::_S_reduce(__x, __binary_op);
+            }
 
-      if constexpr (_V1::size.value == 1)
-        return __x[0];
+          if constexpr (_V1::size.value == 1)
+            return __x[0];
 
-      else if constexpr (_V1::size.value == 2 and sizeof(__x) == 16)
-        return __binary_op(__x, _V1([&](auto __i) { return __x[__i ^ 1]; }))[0];
+          else if constexpr (_V1::size.value == 2 and sizeof(__x) == 16)
+            return __binary_op(__x, _V1([&](auto __i) { return __x[__i ^ 1]; }))[0];
 
-      else if constexpr (std::__has_single_bit(_V1::size.value))
-        return std::reduce(__detail::__split_and_invoke_once(__x, __binary_op), __binary_op);
+          else if constexpr (std::__has_single_bit(_V1::size.value))
+            return std::reduce(__detail::__split_and_invoke_once(__x, __binary_op), __binary_op);
 
-      else
-        {
-          constexpr int __left_size = std::__bit_floor(_V1::size.value);
-          constexpr int __right_size = _V1::size.value - __left_size;
-          constexpr int __max_size = std::__bit_ceil(_V1::size.value);
-          constexpr int __missing = __max_size - _V1::size.value;
-          if constexpr (sizeof(_V1) == sizeof(std::resize_simd_t<__max_size, _V1>)
-                          and (__missing < __right_size)
-                          and not same_as<decltype(__detail::__identity_element_for
-                                                     <_Tp, _BinaryOperation>), nullptr_t>)
+          else
             {
-              using _V2 = std::resize_simd_t<__max_size, _V1>;
-              constexpr std::simd<_Tp, __missing> __padding
-                = __detail::__identity_element_for<_Tp, _BinaryOperation>;
-              const _V2 __y = std::simd_cat(__x, __padding);
-              return std::reduce(__detail::__split_and_invoke_once(__y, __binary_op), __binary_op);
+              constexpr int __left_size = std::__bit_floor(_V1::size.value);
+              constexpr int __right_size = _V1::size.value - __left_size;
+              constexpr int __max_size = std::__bit_ceil(_V1::size.value);
+              constexpr int __missing = __max_size - _V1::size.value;
+              if constexpr (sizeof(_V1) == sizeof(std::resize_simd_t<__max_size, _V1>)
+                              and (__missing < __right_size)
+                              and not same_as<decltype(__detail::__identity_element_for
+                                                         <_Tp, _BinaryOperation>), const nullptr_t>)
+                {
+                  using _V2 = std::resize_simd_t<__max_size, _V1>;
+                  constexpr std::simd<_Tp, __missing> __padding
+                    = __detail::__identity_element_for<_Tp, _BinaryOperation>;
+                  const _V2 __y = std::simd_cat(__x, __padding);
+                  return std::reduce(__detail::__split_and_invoke_once(__y, __binary_op),
+                                     __binary_op);
+                }
+
+              using _V2 = std::resize_simd_t<__left_size, _V1>;
+              const auto [__x0, __x1] = std::simd_split<_V2>(__x);
+              return std::reduce(
+                       std::simd_cat(__detail::__split_and_invoke_once(__x0, __binary_op), __x1),
+                       __binary_op);
             }
-
-          using _V2 = std::resize_simd_t<__left_size, _V1>;
-          const auto [__x0, __x1] = std::simd_split<_V2>(__x);
-          return std::reduce(
-                   std::simd_cat(__detail::__split_and_invoke_once(__x0, __binary_op), __x1),
-                   __binary_op);
         }
     }
 
@@ -0,0 +1,235 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_RING_H_
+#define PROTOTYPE_SIMD_RING_H_
+
+#include "simd.h"
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+/* Lock-free ring buffers of simd batches
+ * ======================================
+ *
+ * simd_ring<V, Kind> is a bounded queue of V (any basic_simd, including the multi-register
+ * ones), for handing batches from producer threads to consumer threads:
+ *
+ * - simd_ring_kind::spsc: one producer thread and one consumer thread (wait-free).
+ * - simd_ring_kind::mpmc: any number of producer and consumer threads (lock-free).
+ *
+ * The capacity is rounded up to a power of 2. Every slot is aligned to (and padded to) a cache
+ * line, and the producer and consumer positions live in cache lines of their own. Thus, a producer
+ * and a consumer never share a cache line, except for the slot they hand over.
+ *
+ * All operations are bulk operations that never block and return the number of batches that they
+ * transferred:
+ *
+ * - produce(n, fn) claims up to n free slots and calls fn(slot, i) for each of them, to construct
+ *   the i-th batch in place (slot is a V&). Then it publishes the slots to the consumers.
+ * - consume(n, fn) claims up to n filled slots and calls fn(slot, i) for each of them, to process
+ *   the i-th batch in place. Then it releases the slots to the producers.
+ * - push(span<const V>) and pop(span<V>) copy batches in and out.
+ *
+ * fn must not throw: claimed slots are handed over unconditionally. With mpmc, a bulk operation
+ * claims consecutive slots only; it may transfer fewer than n batches although more slots are
+ * available (e.g. if another thread holds the next slot).
+ */
+
+namespace std
+{
+  enum class simd_ring_kind
+  {
+    spsc,
+    mpmc
+  };
+
+  template <__detail::__simd_type _Vp, simd_ring_kind _Kind = simd_ring_kind::spsc>
+    class simd_ring
+    {
+      static constexpr bool _S_mpmc = _Kind == simd_ring_kind::mpmc;
+
+      struct _NoSequence
+      {};
+
+      struct alignas(std::max(__detail::__cache_line_size, alignof(_Vp))) _Slot
+      {
+        // mpmc: i if free for the i-th push, i + 1 if filled by the i-th push
+        [[no_unique_address]] conditional_t<_S_mpmc, atomic<size_t>, _NoSequence> _M_seq;
+
+        _Vp _M_value;
+      };
+
+      struct alignas(__detail::__cache_line_size) _Position
+      {
+        atomic<size_t> _M_pos = 0;
+
+        // spsc: the last known position of the other side (only used by the owner of _M_pos)
+        size_t _M_other = 0;
+      };
+
+      // the position of the next push, written by the producers
+      _Position _M_tail;
+
+      // the position of the next pop, written by the consumers
+      _Position _M_head;
+
+      size_t _M_mask;
+
+      unique_ptr<_Slot[]> _M_slots;
+
+      _Slot&
+      _M_slot(size_t __pos) noexcept
+      { return _M_slots[__pos & _M_mask]; }
+
+      // mpmc: claims up to __n consecutive slots at the position __pos_atomic, where a slot at
+      // position p is ready if its sequence number equals p + __ready
+      size_t
+      _M_claim(atomic<size_t>& __pos_atomic, size_t __ready, size_t __n, size_t& __first) noexcept
+      {
+        if (__n == 0)
+          return 0;
+        size_t __pos = __pos_atomic.load(memory_order_relaxed);
+        for (;;)
+          {
+            size_t __k = 0;
+            while (__k < __n
+                     and _M_slot(__pos + __k)._M_seq.load(memory_order_acquire)
+                           == __pos + __k + __ready)
+              ++__k;
+            if (__k == 0)
+              {
+                const size_t __seq = _M_slot(__pos)._M_seq.load(memory_order_acquire);
+                if (ptrdiff_t(__seq - (__pos + __ready)) < 0)
+                  return 0; // full (producers) or empty (consumers)
+                __pos = __pos_atomic.load(memory_order_relaxed);
+              }
+            else if (__pos_atomic.compare_exchange_weak(__pos, __pos + __k,
+                                                        memory_order_relaxed))
+              {
+                __first = __pos;
+                return __k;
+              }
+          }
+      }
+
+    public:
+      using value_type = _Vp;
+
+      /// A ring of at least @p __capacity batches.
+      explicit
+      simd_ring(size_t __capacity)
+      : _M_mask(std::bit_ceil(std::max<size_t>(1, __capacity)) - 1),
+        _M_slots(new _Slot[_M_mask + 1])
+      {
+        if constexpr (_S_mpmc)
+          for (size_t __i = 0; __i <= _M_mask; ++__i)
+            _M_slots[__i]._M_seq.store(__i, memory_order_relaxed);
+      }
+
+      simd_ring(const simd_ring&) = delete;
+
+      simd_ring&
+      operator=(const simd_ring&) = delete;
+
+      size_t
+      capacity() const noexcept
+      { return _M_mask + 1; }
+
+      /// The number of filled slots (a snapshot, if other threads use the ring concurrently).
+      size_t
+      size() const noexcept
+      {
+        const size_t __head = _M_head._M_pos.load(memory_order_acquire);
+        return std::min(_M_tail._M_pos.load(memory_order_acquire) - __head, capacity());
+      }
+
+      /// Constructs up to @p __n batches in place: @p __fn(V& slot, size_t i).
+      template <typename _Fp>
+        size_t
+        produce(size_t __n, _Fp&& __fn) noexcept
+        {
+          if constexpr (_S_mpmc)
+            {
+              size_t __pos;
+              const size_t __k = _M_claim(_M_tail._M_pos, 0, __n, __pos);
+              for (size_t __i = 0; __i < __k; ++__i)
+                {
+                  _Slot& __slot = _M_slot(__pos + __i);
+                  __fn(__slot._M_value, __i);
+                  __slot._M_seq.store(__pos + __i + 1, memory_order_release);
+                }
+              return __k;
+            }
+          else
+            {
+              const size_t __pos = _M_tail._M_pos.load(memory_order_relaxed);
+              if (capacity() - (__pos - _M_tail._M_other) < __n)
+                _M_tail._M_other = _M_head._M_pos.load(memory_order_acquire);
+              const size_t __k = std::min(__n, capacity() - (__pos - _M_tail._M_other));
+              for (size_t __i = 0; __i < __k; ++__i)
+                __fn(_M_slot(__pos + __i)._M_value, __i);
+              _M_tail._M_pos.store(__pos + __k, memory_order_release);
+              return __k;
+            }
+        }
+
+      /// Processes up to @p __n batches in place: @p __fn(V& slot, size_t i).
+      template <typename _Fp>
+        size_t
+        consume(size_t __n, _Fp&& __fn) noexcept
+        {
+          if constexpr (_S_mpmc)
+            {
+              size_t __pos;
+              const size_t __k = _M_claim(_M_head._M_pos, 1, __n, __pos);
+              for (size_t __i = 0; __i < __k; ++__i)
+                {
+                  _Slot& __slot = _M_slot(__pos + __i);
+                  __fn(__slot._M_value, __i);
+                  __slot._M_seq.store(__pos + __i + capacity(), memory_order_release);
+                }
+              return __k;
+            }
+          else
+            {
+              const size_t __pos = _M_head._M_pos.load(memory_order_relaxed);
+              if (_M_head._M_other - __pos < __n)
+                _M_head._M_other = _M_tail._M_pos.load(memory_order_acquire);
+              const size_t __k = std::min(__n, _M_head._M_other - __pos);
+              for (size_t __i = 0; __i < __k; ++__i)
+                __fn(_M_slot(__pos + __i)._M_value, __i);
+              _M_head._M_pos.store(__pos + __k, memory_order_release);
+              return __k;
+            }
+        }
+
+      /// Appends a prefix of @p __batches; returns its size.
+      size_t
+      push(span<const _Vp> __batches) noexcept
+      {
+        return produce(__batches.size(),
+                       [&](_Vp& __slot, size_t __i) { __slot = __batches[__i]; });
+      }
+
+      /// Removes up to @p __out.size() batches into @p __out; returns their number.
+      size_t
+      pop(span<_Vp> __out) noexcept
+      { return consume(__out.size(), [&](_Vp& __slot, size_t __i) { __out[__i] = __slot; }); }
+
+      bool
+      try_push(const _Vp& __x) noexcept
+      { return push(span(&__x, 1)) == 1; }
+
+      bool
+      try_pop(_Vp& __x) noexcept
+      { return pop(span(&__x, 1)) == 1; }
+    };
+}
+
+#endif  // PROTOTYPE_SIMD_RING_H_
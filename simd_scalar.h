@@ -135,9 +135,9 @@ namespace std::__detail
       _S_load(const _Up* __mem, _TypeTag<_Tp>) noexcept
       { return static_cast<_Tp>(__mem[0]); }
 
-    template <typename _Tp, typename _Up>
+    template <typename _Tp, typename _Up, typename... _Fs>
       _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
-      _S_masked_load(_Tp __merge, bool __k, const _Up* __mem) noexcept
+      _S_masked_load(_Tp __merge, bool __k, const _Up* __mem, simd_flags<_Fs...> = {}) noexcept
       {
         if (__k)
           __merge = static_cast<_Tp>(__mem[0]);
@@ -174,6 +174,117 @@ namespace std::__detail
       _S_max(const _Tp __a, const _Tp __b)
       { return std::max(__a, __b); }
 
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+      _S_add_sat(_Tp __x, _Tp __y)
+      {
+        _Tp __r;
+        if (not __builtin_add_overflow(__x, __y, &__r))
+          return __r;
+        else if constexpr (is_unsigned_v<_Tp>)
+          return numeric_limits<_Tp>::max();
+        else
+          return __x < 0 ? numeric_limits<_Tp>::min() : numeric_limits<_Tp>::max();
+      }
+
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+      _S_sub_sat(_Tp __x, _Tp __y)
+      {
+        _Tp __r;
+        if (not __builtin_sub_overflow(__x, __y, &__r))
+          return __r;
+        else if constexpr (is_unsigned_v<_Tp>)
+          return 0;
+        else
+          return __x < 0 ? numeric_limits<_Tp>::min() : numeric_limits<_Tp>::max();
+      }
+
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+      _S_avg(_Tp __x, _Tp __y)
+      { return static_cast<_Tp>((__x | __y) - ((__x ^ __y) >> 1)); }
+
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+      _S_abs_diff(_Tp __x, _Tp __y)
+      {
+        using _Up = __make_unsigned_int_t<_Tp>;
+        return static_cast<_Tp>(__x < __y ? _Up(_Up(__y) - _Up(__x)) : _Up(_Up(__x) - _Up(__y)));
+      }
+
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr __sad_result_t<_Tp>
+      _S_sad(_Tp __x, _Tp __y)
+      { return __make_unsigned_int_t<_Tp>(_S_abs_diff(__x, __y)); }
+
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+      _S_mulhi(_Tp __x, _Tp __y)
+      {
+        constexpr int __bits = sizeof(_Tp) * __CHAR_BIT__;
+        if constexpr (sizeof(_Tp) == 8)
+          {
+            using _Wp = conditional_t<is_signed_v<_Tp>, __int128, unsigned __int128>;
+            return static_cast<_Tp>((_Wp(__x) * __y) >> __bits);
+          }
+        else
+          {
+            using _Up = typename __make_unsigned_int<2 * sizeof(_Tp)>::type;
+            using _Wp = conditional_t<is_signed_v<_Tp>, make_signed_t<_Up>, _Up>;
+            return static_cast<_Tp>((_Wp(__x) * _Wp(__y)) >> __bits);
+          }
+      }
+
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+      _S_popcount(_Tp __x)
+      { return static_cast<_Tp>(std::popcount(__make_unsigned_int_t<_Tp>(__x))); }
+
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+      _S_countl_zero(_Tp __x)
+      { return static_cast<_Tp>(std::countl_zero(__make_unsigned_int_t<_Tp>(__x))); }
+
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+      _S_countr_zero(_Tp __x)
+      { return static_cast<_Tp>(std::countr_zero(__make_unsigned_int_t<_Tp>(__x))); }
+
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+      _S_byteswap(_Tp __x)
+      {
+        if constexpr (sizeof(_Tp) == 1)
+          return __x;
+        else if constexpr (sizeof(_Tp) == 2)
+          return static_cast<_Tp>(__builtin_bswap16(__x));
+        else if constexpr (sizeof(_Tp) == 4)
+          return static_cast<_Tp>(__builtin_bswap32(__x));
+        else
+          return static_cast<_Tp>(__builtin_bswap64(__x));
+      }
+
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+      _S_bit_reverse(_Tp __x)
+      {
+        using _Up = __make_unsigned_int_t<_Tp>;
+        constexpr _Up __m1 = _Up(~_Up()) / 3;
+        constexpr _Up __m2 = _Up(~_Up()) / 5;
+        constexpr _Up __m4 = _Up(~_Up()) / 17;
+        _Up __v = _Up(_S_byteswap(__x));
+        __v = _Up(((__v >> 1) & __m1) | ((__v & __m1) << 1));
+        __v = _Up(((__v >> 2) & __m2) | ((__v & __m2) << 2));
+        __v = _Up(((__v >> 4) & __m4) | ((__v & __m4) << 4));
+        return static_cast<_Tp>(__v);
+      }
+
+    template <integral _Tp>
+      _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
+      _S_rotl(_Tp __x, int __s)
+      { return static_cast<_Tp>(std::rotl(__make_unsigned_int_t<_Tp>(__x), __s)); }
+
     template <typename _Tp>
       _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
       _S_complement(_Tp __x) noexcept
@@ -0,0 +1,615 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2024      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef PROTOTYPE_SIMD_VECTOR_H_
+#define PROTOTYPE_SIMD_VECTOR_H_
+
+#include "simd.h"
+#include "iota.h"
+
+#include <cstring>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <tuple>
+
+/* A structure-of-arrays container for structs of vectorizable members
+ * ===================================================================
+ *
+ * simd_vector<S, N> stores every member of S in its own column. The members of S are found via
+ * the tuple protocol (tuple_size, tuple_element, and get<I>). Thus std::tuple, std::pair, and
+ * std::array work as is and user-defined aggregates opt in by specializing tuple_size and
+ * tuple_element and providing get<I> (which also enables structured bindings).
+ *
+ * Every column is aligned to simd_alignment_v and padded to a multiple of N elements. The padding
+ * is always zero. Therefore, the last chunk is loaded with full-width loads and returns zeros in
+ * the lanes past the end (as simd_index::masked_copy_from with default init), and stores to the
+ * last chunk write zeros to those lanes.
+ *
+ * simd_vector::chunks() iterates in steps of N elements and yields proxies that load/store a
+ * std::tuple of basic_simd objects (one per member).
+ *
+ * The columns are allocated from a std::pmr::memory_resource (the default resource unless one is
+ * passed to the constructor). As for pmr containers, the resource is not propagated on copy
+ * construction or assignment.
+ */
+
+namespace std
+{
+  namespace __detail
+  {
+    template <typename _Tp, size_t... _Is>
+      consteval bool
+      __members_are_vectorizable(index_sequence<_Is...>)
+      { return (__vectorizable<remove_cvref_t<tuple_element_t<_Is, _Tp>>> and ...); }
+
+    template <typename _Tp>
+      concept __simd_reflectable = requires { tuple_size<_Tp>::value; }
+                                     and tuple_size_v<_Tp> > 0
+                                     and __members_are_vectorizable<_Tp>(
+                                           make_index_sequence<tuple_size_v<_Tp>>());
+
+    template <typename _Tp, _SimdSizeType _Np, typename = make_index_sequence<tuple_size_v<_Tp>>>
+      struct __simd_members;
+
+    template <typename _Tp, _SimdSizeType _Np, size_t... _Is>
+      struct __simd_members<_Tp, _Np, index_sequence<_Is...>>
+      { using type = tuple<simd<remove_cvref_t<tuple_element_t<_Is, _Tp>>, _Np>...>; };
+
+    // Proxy for the chunk of _Cont::simd_size elements starting at element __first. _Cont provides
+    // _M_size, _M_member_ptr<_Ip>(__first), and _S_chunks_aligned<_Ip>.
+    template <typename _Cont, bool _Const>
+      class _SimdChunkReference
+      {
+        using _Seq = make_index_sequence<tuple_size_v<typename _Cont::value_type>>;
+
+        static constexpr size_t _S_width = _Cont::simd_size;
+
+        template <size_t _Ip>
+          using _Vp = typename _Cont::template member_simd<_Ip>;
+
+        template <size_t _Ip>
+          using _Tp = typename _Vp<_Ip>::value_type;
+
+        using _Ptr = conditional_t<_Const, const _Cont*, _Cont*>;
+
+        _Ptr _M_cont;
+
+        size_t _M_first;
+
+      public:
+        constexpr
+        _SimdChunkReference(_Ptr __c, size_t __first) noexcept
+        : _M_cont(__c), _M_first(__first)
+        {}
+
+        /// Index of the first element in the chunk.
+        constexpr size_t
+        index() const noexcept
+        { return _M_first; }
+
+        /// Number of elements of the chunk that are inside the container (at most simd_size).
+        constexpr size_t
+        size() const noexcept
+        { return std::min(_M_cont->_M_size - _M_first, _S_width); }
+
+        /// Which lanes of member_simd<_Ip> are inside the container.
+        template <size_t _Ip = 0>
+          typename _Vp<_Ip>::mask_type
+          mask() const noexcept
+          { return iota_v<_Vp<_Ip>> < _Tp<_Ip>(size()); }
+
+        template <size_t _Ip>
+          _Vp<_Ip>
+          get() const noexcept
+          {
+            const _Tp<_Ip>* __mem = _M_cont->template _M_member_ptr<_Ip>(_M_first);
+            if constexpr (_Cont::template _S_chunks_aligned<_Ip>)
+              return _Vp<_Ip>(__mem, simd_flag_aligned);
+            else
+              return _Vp<_Ip>(__mem);
+          }
+
+        typename _Cont::simd_value_type
+        load() const noexcept
+        {
+          return [&]<size_t... _Is>(index_sequence<_Is...>) {
+            return typename _Cont::simd_value_type(get<_Is>()...);
+          }(_Seq());
+        }
+
+        operator typename _Cont::simd_value_type() const noexcept
+        { return load(); }
+
+        template <size_t _Ip>
+          requires (not _Const)
+          void
+          set(_Vp<_Ip> __x) const noexcept
+          {
+            if (size() < _S_width)
+              __x = simd_select(mask<_Ip>(), __x, _Vp<_Ip>());
+            _Tp<_Ip>* __mem = _M_cont->template _M_member_ptr<_Ip>(_M_first);
+            if constexpr (_Cont::template _S_chunks_aligned<_Ip>)
+              __x.copy_to(__mem, simd_flag_aligned);
+            else
+              __x.copy_to(__mem);
+          }
+
+        void
+        store(const typename _Cont::simd_value_type& __x) const noexcept
+        requires (not _Const)
+        {
+          [&]<size_t... _Is>(index_sequence<_Is...>) {
+            (set<_Is>(std::get<_Is>(__x)), ...);
+          }(_Seq());
+        }
+
+        const _SimdChunkReference&
+        operator=(const typename _Cont::simd_value_type& __x) const noexcept
+        requires (not _Const)
+        {
+          store(__x);
+          return *this;
+        }
+      };
+
+    template <typename _Cont, bool _Const>
+      class _SimdChunkIterator
+      {
+        static constexpr ptrdiff_t _S_width = _Cont::simd_size;
+
+        using _Ptr = conditional_t<_Const, const _Cont*, _Cont*>;
+
+        _Ptr _M_cont = nullptr;
+
+        size_t _M_first = 0;
+
+      public:
+        using value_type = typename _Cont::simd_value_type;
+
+        using reference = _SimdChunkReference<_Cont, _Const>;
+
+        using difference_type = ptrdiff_t;
+
+        using iterator_concept = random_access_iterator_tag;
+
+        constexpr _SimdChunkIterator() = default;
+
+        constexpr
+        _SimdChunkIterator(_Ptr __c, size_t __first) noexcept
+        : _M_cont(__c), _M_first(__first)
+        {}
+
+        constexpr reference
+        operator*() const noexcept
+        { return {_M_cont, _M_first}; }
+
+        constexpr reference
+        operator[](difference_type __n) const noexcept
+        { return {_M_cont, _M_first + __n * _S_width}; }
+
+        constexpr _SimdChunkIterator&
+        operator++() noexcept
+        {
+          _M_first += _S_width;
+          return *this;
+        }
+
+        constexpr _SimdChunkIterator
+        operator++(int) noexcept
+        {
+          _SimdChunkIterator __r = *this;
+          _M_first += _S_width;
+          return __r;
+        }
+
+        constexpr _SimdChunkIterator&
+        operator--() noexcept
+        {
+          _M_first -= _S_width;
+          return *this;
+        }
+
+        constexpr _SimdChunkIterator
+        operator--(int) noexcept
+        {
+          _SimdChunkIterator __r = *this;
+          _M_first -= _S_width;
+          return __r;
+        }
+
+        constexpr _SimdChunkIterator&
+        operator+=(difference_type __n) noexcept
+        {
+          _M_first += __n * _S_width;
+          return *this;
+        }
+
+        constexpr _SimdChunkIterator&
+        operator-=(difference_type __n) noexcept
+        {
+          _M_first -= __n * _S_width;
+          return *this;
+        }
+
+        friend constexpr _SimdChunkIterator
+        operator+(_SimdChunkIterator __it, difference_type __n) noexcept
+        { return __it += __n; }
+
+        friend constexpr _SimdChunkIterator
+        operator+(difference_type __n, _SimdChunkIterator __it) noexcept
+        { return __it += __n; }
+
+        friend constexpr _SimdChunkIterator
+        operator-(_SimdChunkIterator __it, difference_type __n) noexcept
+        { return __it -= __n; }
+
+        friend constexpr difference_type
+        operator-(const _SimdChunkIterator& __a, const _SimdChunkIterator& __b) noexcept
+        { return (difference_type(__a._M_first) - difference_type(__b._M_first)) / _S_width; }
+
+        friend constexpr bool
+        operator==(const _SimdChunkIterator& __a, const _SimdChunkIterator& __b) noexcept
+        { return __a._M_first == __b._M_first; }
+
+        friend constexpr auto
+        operator<=>(const _SimdChunkIterator& __a, const _SimdChunkIterator& __b) noexcept
+        { return __a._M_first <=> __b._M_first; }
+      };
+
+    template <typename _Struct, size_t _Ip>
+      using __struct_member_t = remove_cvref_t<tuple_element_t<_Ip, _Struct>>;
+
+    // The storage of simd_vector: one column per member, each aligned to simd_alignment_v and
+    // padded to a multiple of _Np elements.
+    template <typename _Struct, _SimdSizeType _Np>
+      struct _SimdSoaStorage
+      {
+        static constexpr size_t _S_members = tuple_size_v<_Struct>;
+
+        using _Seq = make_index_sequence<_S_members>;
+
+        template <size_t _Ip>
+          using _Member = __struct_member_t<_Struct, _Ip>;
+
+        template <size_t _Ip>
+          static constexpr size_t _S_alignment = simd_alignment_v<simd<_Member<_Ip>, _Np>>;
+
+        // whether every chunk (offset k * _Np) of column _Ip is aligned to _S_alignment<_Ip>
+        template <size_t _Ip>
+          static constexpr bool _S_chunks_aligned
+            = _Np * sizeof(_Member<_Ip>) % _S_alignment<_Ip> == 0;
+
+        array<void*, _S_members> _M_columns = {};
+
+        template <size_t _Ip>
+          _Member<_Ip>*
+          _M_column() const noexcept
+          { return static_cast<_Member<_Ip>*>(_M_columns[_Ip]); }
+
+        template <size_t _Ip>
+          _Member<_Ip>*
+          _M_member_ptr(size_t __i) const noexcept
+          { return _M_column<_Ip>() + __i; }
+
+        // Allocates all new columns before touching the old ones: if an allocation throws, the
+        // ones already allocated are released and *this is unchanged.
+        void
+        _M_reallocate(pmr::memory_resource* __r, size_t __size, size_t __capacity,
+                      size_t __new_capacity)
+        {
+          array<void*, _S_members> __new = {};
+          [&]<size_t... _Is>(index_sequence<_Is...>) {
+            try
+              {
+                ((__new[_Is] = __r->allocate(__new_capacity * sizeof(_Member<_Is>),
+                                             _S_alignment<_Is>)), ...);
+              }
+            catch (...)
+              {
+                ((__new[_Is] ? __r->deallocate(__new[_Is], __new_capacity * sizeof(_Member<_Is>),
+                                               _S_alignment<_Is>)
+                             : void()), ...);
+                throw;
+              }
+            ([&] {
+              using _Tp = _Member<_Is>;
+              _Tp* __col = static_cast<_Tp*>(__new[_Is]);
+              if (__size > 0)
+                std::memcpy(__col, _M_column<_Is>(), __size * sizeof(_Tp));
+              std::memset(__col + __size, 0, (__new_capacity - __size) * sizeof(_Tp));
+            }(), ...);
+          }(_Seq());
+          _M_free(__r, __capacity);
+          _M_columns = __new;
+        }
+
+        void
+        _M_free(pmr::memory_resource* __r, size_t __capacity) noexcept
+        {
+          [&]<size_t... _Is>(index_sequence<_Is...>) {
+            ((_M_columns[_Is] ? __r->deallocate(_M_columns[_Is], __capacity * sizeof(_Member<_Is>),
+                                                _S_alignment<_Is>)
+                              : void()), ...);
+          }(_Seq());
+        }
+
+        // copies the first __size elements into storage of sufficient capacity
+        void
+        _M_copy(const _SimdSoaStorage& __other, size_t __size) noexcept
+        {
+          if (__size > 0)
+            [&]<size_t... _Is>(index_sequence<_Is...>) {
+              (std::memcpy(_M_column<_Is>(), __other.template _M_column<_Is>(),
+                           __size * sizeof(_Member<_Is>)), ...);
+            }(_Seq());
+        }
+
+        void
+        _M_zero(size_t __first, size_t __last) noexcept
+        {
+          [&]<size_t... _Is>(index_sequence<_Is...>) {
+            (std::memset(_M_column<_Is>() + __first, 0,
+                         (__last - __first) * sizeof(_Member<_Is>)), ...);
+          }(_Seq());
+        }
+      };
+
+    // The storage-independent part of simd_vector and simd_aosoa: the memory resource, size,
+    // capacity, and growth, element and chunk access. _Storage is a trivially copyable handle to
+    // the allocated memory, which is owned by this class (thus the capacity it was allocated with
+    // is always known). _Storage provides _S_chunks_aligned<_Ip> and _M_member_ptr<_Ip>(__i) for
+    // _SimdChunkReference, _M_reallocate (which leaves the storage unchanged if it throws),
+    // _M_free, _M_copy, and _M_zero.
+    template <typename _Struct, _SimdSizeType _Np, typename _Storage>
+      class _SimdContainer
+      {
+        using _Seq = make_index_sequence<tuple_size_v<_Struct>>;
+
+      public:
+        using value_type = _Struct;
+
+        using size_type = size_t;
+
+        template <size_t _Ip>
+          using member_simd = simd<__struct_member_t<_Struct, _Ip>, _Np>;
+
+        using simd_value_type = typename __simd_members<_Struct, _Np>::type;
+
+        static constexpr auto simd_size = __ic<_Np>;
+
+      protected:
+        template <size_t _Ip>
+          static constexpr bool _S_chunks_aligned = _Storage::template _S_chunks_aligned<_Ip>;
+
+        pmr::memory_resource* _M_resource = pmr::get_default_resource();
+
+        _Storage _M_storage = {};
+
+        size_t _M_size = 0;
+
+        // multiple of _Np; elements in [_M_size, _M_capacity) are zero
+        size_t _M_capacity = 0;
+
+        template <size_t _Ip>
+          __struct_member_t<_Struct, _Ip>*
+          _M_member_ptr(size_t __i) const noexcept
+          { return _M_storage.template _M_member_ptr<_Ip>(__i); }
+
+        static constexpr size_t
+        _S_round_up(size_t __n) noexcept
+        { return (__n + _Np - 1) / _Np * _Np; }
+
+        void
+        _M_reallocate(size_t __new_capacity)
+        {
+          _M_storage._M_reallocate(_M_resource, _M_size, _M_capacity, __new_capacity);
+          _M_capacity = __new_capacity;
+        }
+
+        void
+        _M_assign(const _SimdContainer& __other)
+        {
+          clear();
+          reserve(__other._M_size);
+          _M_storage._M_copy(__other._M_storage, __other._M_size);
+          _M_size = __other._M_size;
+        }
+
+        void
+        _M_swap(_SimdContainer& __other) noexcept
+        {
+          std::swap(_M_storage, __other._M_storage);
+          std::swap(_M_size, __other._M_size);
+          std::swap(_M_capacity, __other._M_capacity);
+        }
+
+        template <typename, bool>
+          friend class _SimdChunkReference;
+
+      public:
+        using chunk_reference = _SimdChunkReference<_SimdContainer, false>;
+
+        using const_chunk_reference = _SimdChunkReference<_SimdContainer, true>;
+
+        using chunk_iterator = _SimdChunkIterator<_SimdContainer, false>;
+
+        using const_chunk_iterator = _SimdChunkIterator<_SimdContainer, true>;
+
+        _SimdContainer() = default;
+
+        explicit
+        _SimdContainer(pmr::memory_resource* __r) noexcept
+        : _M_resource(__r)
+        {}
+
+        explicit
+        _SimdContainer(size_t __n, pmr::memory_resource* __r = pmr::get_default_resource())
+        : _M_resource(__r)
+        { resize(__n); }
+
+        _SimdContainer(initializer_list<value_type> __init,
+                       pmr::memory_resource* __r = pmr::get_default_resource())
+        : _M_resource(__r)
+        {
+          reserve(__init.size());
+          for (const value_type& __x : __init)
+            push_back(__x);
+        }
+
+        _SimdContainer(const _SimdContainer& __other)
+        : _SimdContainer(__other, pmr::get_default_resource())
+        {}
+
+        _SimdContainer(const _SimdContainer& __other, pmr::memory_resource* __r)
+        : _M_resource(__r)
+        { _M_assign(__other); }
+
+        _SimdContainer(_SimdContainer&& __other) noexcept
+        : _M_resource(__other._M_resource),
+          _M_storage(std::exchange(__other._M_storage, {})),
+          _M_size(std::exchange(__other._M_size, 0)),
+          _M_capacity(std::exchange(__other._M_capacity, 0))
+        {}
+
+        _SimdContainer&
+        operator=(const _SimdContainer& __other)
+        {
+          if (this != &__other)
+            _M_assign(__other);
+          return *this;
+        }
+
+        /// Copies instead of moving if the memory resources are not equal.
+        _SimdContainer&
+        operator=(_SimdContainer&& __other)
+        {
+          if (*_M_resource == *__other._M_resource)
+            _M_swap(__other);
+          else
+            _M_assign(__other);
+          return *this;
+        }
+
+        ~_SimdContainer()
+        { _M_storage._M_free(_M_resource, _M_capacity); }
+
+        pmr::memory_resource*
+        get_memory_resource() const noexcept
+        { return _M_resource; }
+
+        size_t
+        size() const noexcept
+        { return _M_size; }
+
+        bool
+        empty() const noexcept
+        { return _M_size == 0; }
+
+        size_t
+        capacity() const noexcept
+        { return _M_capacity; }
+
+        void
+        reserve(size_t __n)
+        {
+          if (__n > _M_capacity)
+            _M_reallocate(_S_round_up(__n));
+        }
+
+        void
+        resize(size_t __n)
+        {
+          if (__n > _M_capacity)
+            _M_reallocate(_S_round_up(std::max(__n, 2 * _M_capacity)));
+          else if (__n < _M_size)
+            _M_storage._M_zero(__n, _M_size);
+          _M_size = __n;
+        }
+
+        void
+        clear() noexcept
+        {
+          _M_storage._M_zero(0, _M_size);
+          _M_size = 0;
+        }
+
+        void
+        push_back(const value_type& __x)
+        {
+          if (_M_size == _M_capacity)
+            _M_reallocate(_S_round_up(std::max(size_t(_Np), 2 * _M_capacity)));
+          ++_M_size;
+          set(_M_size - 1, __x);
+        }
+
+        /// Scalar element access (gathers the members of element @p __i).
+        value_type
+        operator[](size_t __i) const noexcept
+        {
+          return [&]<size_t... _Is>(index_sequence<_Is...>) {
+            return value_type{*_M_member_ptr<_Is>(__i)...};
+          }(_Seq());
+        }
+
+        /// Scalar element access (scatters the members of @p __x).
+        void
+        set(size_t __i, const value_type& __x) noexcept
+        {
+          [&]<size_t... _Is>(index_sequence<_Is...>) {
+            ((*_M_member_ptr<_Is>(__i) = get<_Is>(__x)), ...);
+          }(_Seq());
+        }
+
+        /// The chunk of _Np elements starting at element @p __first (a multiple of _Np).
+        chunk_reference
+        chunk(size_t __first) noexcept
+        { return {this, __first}; }
+
+        const_chunk_reference
+        chunk(size_t __first) const noexcept
+        { return {this, __first}; }
+
+        /// Range of chunks of _Np elements; the last chunk may be partial.
+        ranges::subrange<chunk_iterator>
+        chunks() noexcept
+        { return {chunk_iterator(this, 0), chunk_iterator(this, _S_round_up(_M_size))}; }
+
+        ranges::subrange<const_chunk_iterator>
+        chunks() const noexcept
+        {
+          return {const_chunk_iterator(this, 0),
+                  const_chunk_iterator(this, _S_round_up(_M_size))};
+        }
+      };
+  }
+
+  template <__detail::__simd_reflectable _Struct,
+            __detail::_SimdSizeType _Np = simd_size_v<remove_cvref_t<tuple_element_t<0, _Struct>>>>
+    class simd_vector
+    : public __detail::_SimdContainer<_Struct, _Np, __detail::_SimdSoaStorage<_Struct, _Np>>
+    {
+      using _Base = __detail::_SimdContainer<_Struct, _Np, __detail::_SimdSoaStorage<_Struct, _Np>>;
+
+      template <size_t _Ip>
+        using _Member = __detail::__struct_member_t<_Struct, _Ip>;
+
+    public:
+      using _Base::_Base;
+
+      /// The contiguous column of member @p _Ip (without padding).
+      template <size_t _Ip>
+        span<_Member<_Ip>>
+        column() noexcept
+        { return {this->_M_storage.template _M_column<_Ip>(), this->_M_size}; }
+
+      template <size_t _Ip>
+        span<const _Member<_Ip>>
+        column() const noexcept
+        { return {this->_M_storage.template _M_column<_Ip>(), this->_M_size}; }
+    };
+}
+
+#endif  // PROTOTYPE_SIMD_VECTOR_H_
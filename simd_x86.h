@@ -9,6 +9,7 @@
 #include "simd_converter.h"
 #include "simd_builtin.h"
 #include "x86_detail.h"
+#include "flags.h"
 
 #include <x86intrin.h>
 
@@ -268,157 +269,196 @@ namespace std::__detail
 
       using _Base::_S_load;
 
-      template <__vec_builtin _TV, typename _Up>
-        static inline _TV
-        _S_masked_load(_TV __merge, _MaskMember<_TV> __k, const _Up* __mem)
+      /**
+       * Whether a vector of _Up with _S_full_size elements can be loaded/stored with a masked move
+       * instruction (AVX-512 masked loaddqu/storedqu or AVX vmaskmov) instead of iterating over the
+       * set bits of the mask.
+       */
+      template <typename _Up>
+        static constexpr bool _S_have_masked_loadstore
+          = sizeof(_Up) <= 8 and sizeof(_Up) * _S_full_size <= 64
+              and (_Flags._M_have_avx512vl
+                     ? sizeof(_Up) >= 4 or _Flags._M_have_avx512bw
+                     : _Flags._M_have_avx and sizeof(_Up) >= 4
+                         and sizeof(_Up) * _S_full_size <= 32);
+
+      template <__vec_builtin _TV, typename _Up, typename... _Fs>
+        _GLIBCXX_SIMD_INTRINSIC static _TV
+        _S_masked_load(_TV __merge, _MaskMember<_TV> __k, const _Up* __mem,
+                       simd_flags<_Fs...> __flags = {})
         {
           using _Tp = __value_type_of<_TV>;
           constexpr bool __no_conversion = is_same_v<_Tp, _Up>;
           constexpr bool __bitwise_conversion = sizeof(_Tp) == sizeof(_Up)
                                                   and is_integral_v<_Tp> == is_integral_v<_Up>;
-          if constexpr (__no_conversion or __bitwise_conversion)
+          if constexpr ((__no_conversion or __bitwise_conversion)
+                          and _S_have_masked_loadstore<_Tp>)
             {
-              [[maybe_unused]] const auto __intrin = __to_x86_intrin(__merge);
-              const auto __kk = _S_to_bitmask(__k);
+              // the padding elements must not be loaded
+              __k = _Abi::_S_masked(__k);
+              if constexpr (_Flags._M_have_avx512vl)
+                {
+                  const auto __intrin = __to_x86_intrin(__merge);
+                  const auto __kk = _S_to_bitmask(__k);
 
 #define _GLIBCXX_SIMD_MASK_LOAD(type, type2, bits)                                                 \
-  __merge = reinterpret_cast<_TV>(__builtin_ia32_loaddqu##type##i##bits##_mask(                    \
+  __merge = __vec_bitcast_trunc<_TV>(__builtin_ia32_loaddqu##type##i##bits##_mask(                 \
               reinterpret_cast<const type2*>(__mem),                                               \
-              reinterpret_cast<__vec_builtin_type<type2, bits / 8>>(__merge), __kk))
+              reinterpret_cast<__vec_builtin_type_bytes<type2, bits / 8>>(__intrin), __kk))
 
 #define _GLIBCXX_SIMD_MASK_LOAD_FLT(type, type2, bits)                                             \
-  __merge = reinterpret_cast<_TV>(__builtin_ia32_loadup##type##i##bits##_mask(                     \
+  __merge = __vec_bitcast_trunc<_TV>(__builtin_ia32_loadup##type##bits##_mask(                     \
               reinterpret_cast<const type2*>(__mem),                                               \
-              reinterpret_cast<__vec_builtin_type<type2, bits / 8>>(__merge), __kk))
-
-              if constexpr (_Flags._M_have_avx512bw and _Flags._M_have_avx512vl
-                              and sizeof(_Tp) == 1)
-                {
-                  if constexpr (sizeof(__intrin) == 16)
-                    _GLIBCXX_SIMD_MASK_LOAD(q, char, 128);
-                  else if constexpr (sizeof(__merge) == 32)
-                    _GLIBCXX_SIMD_MASK_LOAD(q, char, 256);
-                  else if constexpr (sizeof(__merge) == 64)
-                    _GLIBCXX_SIMD_MASK_LOAD(q, char, 512);
-                  else
-                    __assert_unreachable<_Tp>();
-                }
-              else if constexpr (_Flags._M_have_avx512bw and _Flags._M_have_avx512vl
-                                   and sizeof(_Tp) == 2)
-                {
-                  if constexpr (sizeof(__intrin) == 16)
-                    _GLIBCXX_SIMD_MASK_LOAD(h, short, 128);
-                  else if constexpr (sizeof(__intrin) == 32)
-                    _GLIBCXX_SIMD_MASK_LOAD(h, short, 256);
-                  else if constexpr (sizeof(__intrin) == 64)
-                    _GLIBCXX_SIMD_MASK_LOAD(h, short, 512);
-                  else
-                    __assert_unreachable<_Tp>();
-                }
-              else if constexpr (_Flags._M_have_avx512vl and sizeof(_Tp) == 4
-                                   and is_integral_v<_Up>)
-                {
-                  if constexpr (sizeof(__intrin) == 16)
-                    _GLIBCXX_SIMD_MASK_LOAD(s, int, 128);
-                  else if constexpr (sizeof(__intrin) == 32)
-                    _GLIBCXX_SIMD_MASK_LOAD(s, int, 256);
-                  else if constexpr (sizeof(__intrin) == 64)
-                    _GLIBCXX_SIMD_MASK_LOAD(s, int, 512);
-                  else
-                    __assert_unreachable<_Tp>();
-                }
-              else if constexpr (_Flags._M_have_avx512vl and sizeof(_Tp) == 4
-                                   and is_floating_point_v<_Up>)
-                {
-                  if constexpr (sizeof(__intrin) == 16)
-                    _GLIBCXX_SIMD_MASK_LOAD_FLT(s, float, 128);
-                  else if constexpr (sizeof(__intrin) == 32)
-                    _GLIBCXX_SIMD_MASK_LOAD_FLT(s, float, 256);
-                  else if constexpr (sizeof(__intrin) == 64)
-                    _GLIBCXX_SIMD_MASK_LOAD_FLT(s, float, 512);
+              reinterpret_cast<__vec_builtin_type_bytes<type2, bits / 8>>(__intrin), __kk))
+
+#define _GLIBCXX_SIMD_MASK_LOAD_ALL(type, type2, macro)                                            \
+  if constexpr (sizeof(__intrin) == 16)                                                            \
+    macro(type, type2, 128);                                                                       \
+  else if constexpr (sizeof(__intrin) == 32)                                                       \
+    macro(type, type2, 256);                                                                       \
+  else if constexpr (sizeof(__intrin) == 64)                                                       \
+    macro(type, type2, 512);                                                                       \
+  else                                                                                             \
+    __assert_unreachable<_Tp>()
+
+                  if constexpr (sizeof(_Tp) == 1)
+                    _GLIBCXX_SIMD_MASK_LOAD_ALL(q, char, _GLIBCXX_SIMD_MASK_LOAD);
+                  else if constexpr (sizeof(_Tp) == 2)
+                    _GLIBCXX_SIMD_MASK_LOAD_ALL(h, short, _GLIBCXX_SIMD_MASK_LOAD);
+                  else if constexpr (sizeof(_Tp) == 4 and is_integral_v<_Up>)
+                    _GLIBCXX_SIMD_MASK_LOAD_ALL(s, int, _GLIBCXX_SIMD_MASK_LOAD);
+                  else if constexpr (sizeof(_Tp) == 4)
+                    _GLIBCXX_SIMD_MASK_LOAD_ALL(s, float, _GLIBCXX_SIMD_MASK_LOAD_FLT);
+                  else if constexpr (sizeof(_Tp) == 8 and is_integral_v<_Up>)
+                    _GLIBCXX_SIMD_MASK_LOAD_ALL(d, long long, _GLIBCXX_SIMD_MASK_LOAD);
+                  else if constexpr (sizeof(_Tp) == 8)
+                    _GLIBCXX_SIMD_MASK_LOAD_ALL(d, double, _GLIBCXX_SIMD_MASK_LOAD_FLT);
                   else
                     __assert_unreachable<_Tp>();
+#undef _GLIBCXX_SIMD_MASK_LOAD_ALL
+#undef _GLIBCXX_SIMD_MASK_LOAD_FLT
+#undef _GLIBCXX_SIMD_MASK_LOAD
                 }
-              else if constexpr (_Flags._M_have_avx2 and sizeof(_Tp) == 4 and is_integral_v<_Up>)
-                {
-                  static_assert(_S_use_bitmasks == false);
-                  static_assert(sizeof(__intrin) == 16 or sizeof(__intrin) == 32);
-                  __merge = __vec_or(__vec_andnot(reinterpret_cast<_TV>(__k), __merge),
-                                     reinterpret_cast<_TV>(__maskload_epi32(__mem, __k)));
-                }
-              else if constexpr (_Flags._M_have_avx and sizeof(_Tp) == 4)
+              else
                 {
-                  static_assert(sizeof(__intrin) == 16 or sizeof(__intrin) == 32);
+                  // vmaskmov zeros the elements that are not loaded
+                  static_assert(not _S_use_bitmasks);
                   __merge = __vec_or(__vec_andnot(reinterpret_cast<_TV>(__k), __merge),
-                                     reinterpret_cast<_TV>(__maskload_ps(__mem, __k)));
+                                     __maskload<_TV, _Flags>(__mem, __k));
                 }
-              else if constexpr (_Flags._M_have_avx512vl and sizeof(_Tp) == 8
-                                   and is_integral_v<_Up>)
+            }
+#if _GLIBCXX_SIMD_PAGE_SAFE_OVERREAD
+          else if constexpr ((__no_conversion or __bitwise_conversion)
+                               and __flags._M_test(__simd_flag_page_safe))
+            {
+              // Without a masked move instruction, blend from a full load if that cannot fault
+              // and the caller allows reading the unselected elements (__simd_flag_page_safe):
+              // at least one element is selected, thus the page containing __mem is accessible.
+              if (_S_to_bits(__k).any() and (reinterpret_cast<uintptr_t>(__mem) % __min_page_size)
+                                              + sizeof(_TV) <= __min_page_size) [[likely]]
                 {
-                  if constexpr (sizeof(__intrin) == 16)
-                    _GLIBCXX_SIMD_MASK_LOAD(d, long long, 128);
-                  else if constexpr (sizeof(__intrin) == 32)
-                    _GLIBCXX_SIMD_MASK_LOAD(d, long long, 256);
-                  else if constexpr (sizeof(__intrin) == 64)
-                    _GLIBCXX_SIMD_MASK_LOAD(d, long long, 512);
-                  else
-                    __assert_unreachable<_Tp>();
+                  _TV __full;
+                  __builtin_memcpy(&__full, __mem, sizeof(_TV));
+                  _S_masked_assign(__k, __merge, __full);
                 }
-              else if constexpr (_Flags._M_have_avx512vl and sizeof(_Tp) == 8
-                                   and is_floating_point_v<_Up>)
+              else
+                __merge = _Base::_S_masked_load(__merge, __k, __mem);
+            }
+#endif
+          else if constexpr (_S_have_masked_loadstore<_Up>
+                               or (_GLIBCXX_SIMD_PAGE_SAFE_OVERREAD and sizeof(_Up) < sizeof(_Tp)
+                                     and __flags._M_test(__simd_flag_page_safe)))
+            {
+              // masked load of a vector of _Up (the other elements are zero) and convert
+              using _UV = __vec_builtin_type<_Up, _S_full_size>;
+              const _UV __uv = _S_masked_load(_UV(), _S_convert_mask_to<_UV, _TV>(__k),
+                                              __mem, __flags);
+              _S_masked_assign(__k, __merge, __vec_convert<_TV>(__uv));
+            }
+          else
+            __merge = _Base::_S_masked_load(__merge, __k, __mem);
+          return __merge;
+        }
+
+      template <__vec_builtin _TV, typename _Up>
+        _GLIBCXX_SIMD_INTRINSIC static void
+        _S_masked_store(const _TV __v, _Up* __mem, _MaskMember<_TV> __k)
+        {
+          using _Tp = __value_type_of<_TV>;
+          constexpr bool __no_conversion = is_same_v<_Tp, _Up>;
+          constexpr bool __bitwise_conversion = sizeof(_Tp) == sizeof(_Up)
+                                                  and is_integral_v<_Tp> == is_integral_v<_Up>;
+          if constexpr ((__no_conversion or __bitwise_conversion)
+                          and _S_have_masked_loadstore<_Tp>)
+            {
+              // the padding elements must not be stored
+              __k = _Abi::_S_masked(__k);
+              if constexpr (_Flags._M_have_avx512vl)
                 {
-                  if constexpr (sizeof(__intrin) == 16)
-                    _GLIBCXX_SIMD_MASK_LOAD_FLT(d, double, 128);
-                  else if constexpr (sizeof(__intrin) == 32)
-                    _GLIBCXX_SIMD_MASK_LOAD_FLT(d, double, 256);
-                  else if constexpr (sizeof(__intrin) == 64)
-                    _GLIBCXX_SIMD_MASK_LOAD_FLT(d, double, 512);
+                  const auto __intrin = __to_x86_intrin(__v);
+                  const auto __kk = _S_to_bitmask(__k);
+
+#define _GLIBCXX_SIMD_MASK_STORE(type, type2, bits)                                                \
+  __builtin_ia32_storedqu##type##i##bits##_mask(                                                   \
+    reinterpret_cast<type2*>(__mem),                                                               \
+    reinterpret_cast<__vec_builtin_type_bytes<type2, bits / 8>>(__intrin), __kk)
+
+#define _GLIBCXX_SIMD_MASK_STORE_FLT(type, type2, bits)                                            \
+  __builtin_ia32_storeup##type##bits##_mask(                                                       \
+    reinterpret_cast<type2*>(__mem),                                                               \
+    reinterpret_cast<__vec_builtin_type_bytes<type2, bits / 8>>(__intrin), __kk)
+
+#define _GLIBCXX_SIMD_MASK_STORE_ALL(type, type2, macro)                                           \
+  if constexpr (sizeof(__intrin) == 16)                                                            \
+    macro(type, type2, 128);                                                                       \
+  else if constexpr (sizeof(__intrin) == 32)                                                       \
+    macro(type, type2, 256);                                                                       \
+  else if constexpr (sizeof(__intrin) == 64)                                                       \
+    macro(type, type2, 512);                                                                       \
+  else                                                                                             \
+    __assert_unreachable<_Tp>()
+
+                  if constexpr (sizeof(_Tp) == 1)
+                    _GLIBCXX_SIMD_MASK_STORE_ALL(q, char, _GLIBCXX_SIMD_MASK_STORE);
+                  else if constexpr (sizeof(_Tp) == 2)
+                    _GLIBCXX_SIMD_MASK_STORE_ALL(h, short, _GLIBCXX_SIMD_MASK_STORE);
+                  else if constexpr (sizeof(_Tp) == 4 and is_integral_v<_Up>)
+                    _GLIBCXX_SIMD_MASK_STORE_ALL(s, int, _GLIBCXX_SIMD_MASK_STORE);
+                  else if constexpr (sizeof(_Tp) == 4)
+                    _GLIBCXX_SIMD_MASK_STORE_ALL(s, float, _GLIBCXX_SIMD_MASK_STORE_FLT);
+                  else if constexpr (sizeof(_Tp) == 8 and is_integral_v<_Up>)
+                    _GLIBCXX_SIMD_MASK_STORE_ALL(d, long long, _GLIBCXX_SIMD_MASK_STORE);
+                  else if constexpr (sizeof(_Tp) == 8)
+                    _GLIBCXX_SIMD_MASK_STORE_ALL(d, double, _GLIBCXX_SIMD_MASK_STORE_FLT);
                   else
                     __assert_unreachable<_Tp>();
+#undef _GLIBCXX_SIMD_MASK_STORE_ALL
+#undef _GLIBCXX_SIMD_MASK_STORE_FLT
+#undef _GLIBCXX_SIMD_MASK_STORE
                 }
-              else if constexpr (_Flags._M_have_avx2 and sizeof(_Tp) == 8 and is_integral_v<_Up>)
-                {
-                  static_assert(sizeof(__intrin) == 16 or sizeof(__intrin) == 32);
-                  __merge = __vec_or(__vec_andnot(reinterpret_cast<_TV>(__k), __merge),
-                                     reinterpret_cast<_TV>(__maskload_epi64( __mem, __k)));
-                }
-              else if constexpr (_Flags._M_have_avx and sizeof(_Tp) == 8)
-                {
-                  static_assert(sizeof(__intrin) == 16 or sizeof(__intrin) == 32);
-                  __merge = __vec_or(__vec_andnot(reinterpret_cast<_TV>(__k), __merge),
-                                     reinterpret_cast<_TV>(__maskload_pd(__mem, __k)));
-                }
-              else
-                _S_bit_iteration(_S_to_bits(__k),
-                                 [&] [[__gnu__::__always_inline__]] (auto __i) {
-                                   __merge[__i] = static_cast<_Tp>(__mem[__i]);
-                                 });
-            }
-	/* Very uncertain, that the following improves anything. Needs benchmarking
-	 * before it's activated.
-	else if constexpr (sizeof(_Up) <= 8 and // no long double
-			   !__converts_via_decomposition_v<
-			     _Up, _Tp,
-			     sizeof(__merge)> // conversion via decomposition
-					      // is better handled via the
-					      // bit_iteration fallback below
-	)
-	  {
-	    // TODO: copy pattern from _S_masked_store, which doesn't resort to
-	    // fixed_size
-	    using _Ap       = simd_abi::deduce_t<_Up, _Np>;
-	    using _ATraits = _SimdTraits<_Up, _Ap>;
-	    using _AImpl   = typename _ATraits::_SimdImpl;
-	    typename _ATraits::_SimdMember __uncvted{};
-	    typename _ATraits::_MaskMember __kk = _Ap::_Impl::template _S_convert<_Up>(__k);
-	    __uncvted = _AImpl::_S_masked_load(__uncvted, __kk, __mem);
-	    _SimdConverter<_Up, _Ap, _Tp, _Abi> __converter;
-	    _Base::_S_masked_assign(__k, __merge, __converter(__uncvted));
-	  }
-	  */
+              else
+                __maskstore<_Flags>(__mem, __v, __k);
+            }
+          else if constexpr (not __no_conversion and not __bitwise_conversion
+                               and _S_have_masked_loadstore<_Up>)
+            {
+              using _UV = __vec_builtin_type<_Up, _S_full_size>;
+              _S_masked_store(__vec_convert<_UV>(__v), __mem,
+                              _S_convert_mask_to<_UV, _TV>(__k));
+            }
           else
-            __merge = _Base::_S_masked_load(__merge, __k, __mem);
-          return __merge;
+            _Base::_S_masked_store(__v, __mem, __k);
+        }
+
+      // Returns the mask __k for vectors of __value_type_of<_UV> (with the same number of elements).
+      template <__vec_builtin _UV, __vec_builtin _TV>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _MaskMember<_UV>
+        _S_convert_mask_to(_MaskMember<_TV> __k)
+        {
+          if constexpr (_S_use_bitmasks)
+            return __k;
+          else
+            return __vec_convert<_MaskMember<_UV>>(__k);
         }
 
       // Returns: __k ? __a : __b
@@ -776,7 +816,7 @@ namespace std::__detail
                 {
                   const auto __xi = reinterpret_cast<int>(__x);
                   const auto __yi = reinterpret_cast<int>(__y);
-                  return reinterpret_cast<__vec_builtin_type<_Tp, 3>>(
+                  return reinterpret_cast<_TV>(
                            ((__xi * __yi) & 0xff)
                              | (((__xi >> 8) * (__yi & 0xff00)) & 0xff00)
                              | ((__xi >> 16) * (__yi & 0xff0000)));
@@ -824,7 +864,9 @@ namespace std::__detail
                     return _S_select_bitmask(0xaaaa'aaaa'aaaa'aaaaLL,
                                              __vec_bitcast<_Tp>(__odd), __vec_bitcast<_Tp>(__even));
                   else if constexpr (_Flags._M_have_sse4_1 and sizeof(_TV) > 2)
-                    return reinterpret_cast<_TV>(__high_byte ? __odd : __even);
+                    // blend bytewise (pblendvb), testing the 16-bit __high_byte would select __odd
+                    return __vec_bitcast<_Tp>(__high_byte) ? __vec_bitcast<_Tp>(__odd)
+                                                           : __vec_bitcast<_Tp>(__even);
                   else
                     return reinterpret_cast<_TV>(__vec_or(__vec_andnot(__high_byte, __even), __odd));
                 }
@@ -944,6 +986,486 @@ namespace std::__detail
 
 #endif
 
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_add_sat(_TV __x, _TV __y)
+        {
+          using _Tp = __value_type_of<_TV>;
+          if constexpr (sizeof(_Tp) > 2 or (sizeof(_TV) == 64 and not _Flags._M_have_avx512bw))
+            return _Base::_S_add_sat(__x, __y);
+          else if (__builtin_is_constant_evaluated())
+            return _Base::_S_add_sat(__x, __y);
+          else if constexpr (sizeof(_TV) < 16)
+            return __vec_bitcast_trunc<_TV>(_S_add_sat(__vec_zero_pad_to_16(__x),
+                                                       __vec_zero_pad_to_16(__y)));
+          else
+            {
+              const auto __xi = __to_x86_intrin(__x);
+              const auto __yi = __to_x86_intrin(__y);
+              if constexpr (sizeof(_TV) == 16 and sizeof(_Tp) == 1 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm_adds_epi8(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 16 and sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm_adds_epu8(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 16 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm_adds_epi16(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 16)
+                return reinterpret_cast<_TV>(_mm_adds_epu16(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32 and sizeof(_Tp) == 1 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm256_adds_epi8(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32 and sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm256_adds_epu8(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm256_adds_epi16(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32)
+                return reinterpret_cast<_TV>(_mm256_adds_epu16(__xi, __yi));
+              else if constexpr (sizeof(_Tp) == 1 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm512_adds_epi8(__xi, __yi));
+              else if constexpr (sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm512_adds_epu8(__xi, __yi));
+              else if constexpr (is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm512_adds_epi16(__xi, __yi));
+              else
+                return reinterpret_cast<_TV>(_mm512_adds_epu16(__xi, __yi));
+            }
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_sub_sat(_TV __x, _TV __y)
+        {
+          using _Tp = __value_type_of<_TV>;
+          if constexpr (sizeof(_Tp) > 2 or (sizeof(_TV) == 64 and not _Flags._M_have_avx512bw))
+            return _Base::_S_sub_sat(__x, __y);
+          else if (__builtin_is_constant_evaluated())
+            return _Base::_S_sub_sat(__x, __y);
+          else if constexpr (sizeof(_TV) < 16)
+            return __vec_bitcast_trunc<_TV>(_S_sub_sat(__vec_zero_pad_to_16(__x),
+                                                       __vec_zero_pad_to_16(__y)));
+          else
+            {
+              const auto __xi = __to_x86_intrin(__x);
+              const auto __yi = __to_x86_intrin(__y);
+              if constexpr (sizeof(_TV) == 16 and sizeof(_Tp) == 1 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm_subs_epi8(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 16 and sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm_subs_epu8(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 16 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm_subs_epi16(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 16)
+                return reinterpret_cast<_TV>(_mm_subs_epu16(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32 and sizeof(_Tp) == 1 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm256_subs_epi8(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32 and sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm256_subs_epu8(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm256_subs_epi16(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32)
+                return reinterpret_cast<_TV>(_mm256_subs_epu16(__xi, __yi));
+              else if constexpr (sizeof(_Tp) == 1 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm512_subs_epi8(__xi, __yi));
+              else if constexpr (sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm512_subs_epu8(__xi, __yi));
+              else if constexpr (is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm512_subs_epi16(__xi, __yi));
+              else
+                return reinterpret_cast<_TV>(_mm512_subs_epu16(__xi, __yi));
+            }
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_avg(_TV __x, _TV __y)
+        {
+          using _Tp = __value_type_of<_TV>;
+          if constexpr (sizeof(_Tp) > 2 or (sizeof(_TV) == 64 and not _Flags._M_have_avx512bw))
+            return _Base::_S_avg(__x, __y);
+          else if (__builtin_is_constant_evaluated())
+            return _Base::_S_avg(__x, __y);
+          else if constexpr (is_signed_v<_Tp>)
+            { // pavg only exists for unsigned integers: bias into the unsigned range and back
+              using _Up = __make_unsigned_int_t<_Tp>;
+              using _UV = __vec_builtin_type_bytes<_Up, sizeof(_TV)>;
+              constexpr _Up __bias = _Up(1) << (sizeof(_Tp) * __CHAR_BIT__ - 1);
+              return reinterpret_cast<_TV>(_S_avg(reinterpret_cast<_UV>(__x) ^ __bias,
+                                                  reinterpret_cast<_UV>(__y) ^ __bias) ^ __bias);
+            }
+          else if constexpr (sizeof(_TV) < 16)
+            return __vec_bitcast_trunc<_TV>(_S_avg(__vec_zero_pad_to_16(__x),
+                                                   __vec_zero_pad_to_16(__y)));
+          else
+            {
+              const auto __xi = __to_x86_intrin(__x);
+              const auto __yi = __to_x86_intrin(__y);
+              if constexpr (sizeof(_TV) == 16 and sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm_avg_epu8(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 16)
+                return reinterpret_cast<_TV>(_mm_avg_epu16(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32 and sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm256_avg_epu8(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32)
+                return reinterpret_cast<_TV>(_mm256_avg_epu16(__xi, __yi));
+              else if constexpr (sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm512_avg_epu8(__xi, __yi));
+              else
+                return reinterpret_cast<_TV>(_mm512_avg_epu16(__xi, __yi));
+            }
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_abs_diff(_TV __x, _TV __y)
+        {
+          using _Tp = __value_type_of<_TV>;
+          if constexpr (sizeof(_Tp) <= 2 and is_unsigned_v<_Tp>)
+            // psubus & psubus & por instead of pmaxu & pminu & psub (pminuw/pmaxuw need SSE4.1)
+            return __vec_or(_S_sub_sat(__x, __y), _S_sub_sat(__y, __x));
+          else
+            return _Base::_S_abs_diff(__x, __y);
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr __sad_result_t<__value_type_of<_TV>>
+        _S_sad(_TV __x, _TV __y)
+        {
+          using _Tp = __value_type_of<_TV>;
+          if constexpr (sizeof(_Tp) != 1 or (sizeof(_TV) == 64 and not _Flags._M_have_avx512bw))
+            return _Base::_S_sad(__x, __y);
+          else if (__builtin_is_constant_evaluated())
+            return _Base::_S_sad(__x, __y);
+          else if constexpr (is_signed_v<_Tp>)
+            { // |(x + 128) - (y + 128)| == |x - y|
+              using _UV = __vec_builtin_type_bytes<unsigned char, sizeof(_TV)>;
+              return _S_sad(reinterpret_cast<_UV>(__x) ^ 0x80, reinterpret_cast<_UV>(__y) ^ 0x80);
+            }
+          else
+            {
+              // psadbw sums over all bytes, thus padding must be equal in __x and __y
+              const _TV __xm = _Abi::_S_masked(__x);
+              const _TV __ym = _Abi::_S_masked(__y);
+              using _SumV = __vec_builtin_type_bytes<unsigned long long,
+                                                     sizeof(_TV) < 16 ? 16 : sizeof(_TV)>;
+              _SumV __s;
+              if constexpr (sizeof(_TV) <= 16)
+                __s = reinterpret_cast<_SumV>(
+                        _mm_sad_epu8(__to_x86_intrin(__vec_zero_pad_to_16(__xm)),
+                                     __to_x86_intrin(__vec_zero_pad_to_16(__ym))));
+              else if constexpr (sizeof(_TV) == 32)
+                __s = reinterpret_cast<_SumV>(_mm256_sad_epu8(__to_x86_intrin(__xm),
+                                                              __to_x86_intrin(__ym)));
+              else
+                __s = reinterpret_cast<_SumV>(_mm512_sad_epu8(__to_x86_intrin(__xm),
+                                                              __to_x86_intrin(__ym)));
+              __sad_result_t<_Tp> __r = 0;
+              for (int __i = 0; __i < __width_of<_SumV>; ++__i)
+                __r += __s[__i];
+              return __r;
+            }
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_mulhi(_TV __x, _TV __y)
+        {
+          using _Tp = __value_type_of<_TV>;
+          constexpr bool __have_width = sizeof(_TV) <= 16
+                                          or (sizeof(_TV) == 32 and _Flags._M_have_avx2)
+                                          or (sizeof(_TV) == 64 and _Flags._M_have_avx512f
+                                                and (sizeof(_Tp) == 4 or _Flags._M_have_avx512bw));
+          if (__builtin_is_constant_evaluated())
+            return _Base::_S_mulhi(__x, __y);
+          else if constexpr (not __have_width or sizeof(_Tp) == 1 or sizeof(_Tp) == 8
+                               or (sizeof(_Tp) == 4 and is_signed_v<_Tp>
+                                     and not _Flags._M_have_sse4_1))
+            // there is no high multiply for 8- and 64-bit elements (vpmullq is a low multiply)
+            return _Base::_S_mulhi(__x, __y);
+          else if constexpr (sizeof(_TV) < 16)
+            return __vec_bitcast_trunc<_TV>(_S_mulhi(__vec_zero_pad_to_16(__x),
+                                                     __vec_zero_pad_to_16(__y)));
+          else if constexpr (sizeof(_Tp) == 2)
+            {
+              const auto __xi = __to_x86_intrin(__x);
+              const auto __yi = __to_x86_intrin(__y);
+              if constexpr (sizeof(_TV) == 16 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm_mulhi_epi16(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 16)
+                return reinterpret_cast<_TV>(_mm_mulhi_epu16(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32 and is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm256_mulhi_epi16(__xi, __yi));
+              else if constexpr (sizeof(_TV) == 32)
+                return reinterpret_cast<_TV>(_mm256_mulhi_epu16(__xi, __yi));
+              else if constexpr (is_signed_v<_Tp>)
+                return reinterpret_cast<_TV>(_mm512_mulhi_epi16(__xi, __yi));
+              else
+                return reinterpret_cast<_TV>(_mm512_mulhi_epu16(__xi, __yi));
+            }
+          else
+            {
+              // pmuludq/pmuldq multiply the even elements to 64-bit products; the odd elements are
+              // shifted into the even positions for a second multiplication
+              using _UV = __vec_builtin_type_bytes<unsigned long long, sizeof(_TV)>;
+              auto __mul_even = [](_UV __a, _UV __b) [[__gnu__::__always_inline__]] {
+                const auto __ai = __to_x86_intrin(__a);
+                const auto __bi = __to_x86_intrin(__b);
+                if constexpr (sizeof(_TV) == 16 and is_signed_v<_Tp>)
+                  return reinterpret_cast<_UV>(_mm_mul_epi32(__ai, __bi));
+                else if constexpr (sizeof(_TV) == 16)
+                  return reinterpret_cast<_UV>(_mm_mul_epu32(__ai, __bi));
+                else if constexpr (sizeof(_TV) == 32 and is_signed_v<_Tp>)
+                  return reinterpret_cast<_UV>(_mm256_mul_epi32(__ai, __bi));
+                else if constexpr (sizeof(_TV) == 32)
+                  return reinterpret_cast<_UV>(_mm256_mul_epu32(__ai, __bi));
+                else if constexpr (is_signed_v<_Tp>)
+                  return reinterpret_cast<_UV>(_mm512_mul_epi32(__ai, __bi));
+                else
+                  return reinterpret_cast<_UV>(_mm512_mul_epu32(__ai, __bi));
+              };
+              const _UV __xu = reinterpret_cast<_UV>(__x);
+              const _UV __yu = reinterpret_cast<_UV>(__y);
+              const _UV __even = __mul_even(__xu, __yu);
+              const _UV __odd = __mul_even(__xu >> 32, __yu >> 32);
+              return reinterpret_cast<_TV>((__even >> 32) | (__odd & 0xffff'ffff'0000'0000ull));
+            }
+        }
+
+      template <typename _TV>
+        static constexpr bool _S_have_pshufb
+          = sizeof(_TV) <= 16 ? _Flags._M_have_ssse3
+                              : sizeof(_TV) == 32 ? _Flags._M_have_avx2 : _Flags._M_have_avx512bw;
+
+      // Looks up every byte of __idx (all values must be less than 16) in the table __lut.
+      template <__vec_builtin _BV>
+        _GLIBCXX_SIMD_INTRINSIC static _BV
+        _S_nibble_lookup(const unsigned char (&__lut)[16], _BV __idx)
+        {
+          static_assert(sizeof(_BV) >= 16 and sizeof(__value_type_of<_BV>) == 1);
+          const auto __tbl = __to_x86_intrin(_GLIBCXX_SIMD_VEC_GEN(_BV, __width_of<_BV>, _Is, {
+                                               __lut[_Is % 16]...
+                                             }));
+          if constexpr (sizeof(_BV) == 16)
+            return reinterpret_cast<_BV>(_mm_shuffle_epi8(__tbl, __to_x86_intrin(__idx)));
+          else if constexpr (sizeof(_BV) == 32)
+            return reinterpret_cast<_BV>(_mm256_shuffle_epi8(__tbl, __to_x86_intrin(__idx)));
+          else
+            return reinterpret_cast<_BV>(_mm512_shuffle_epi8(__tbl, __to_x86_intrin(__idx)));
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_popcount(_TV __x)
+        {
+          using _Tp = __value_type_of<_TV>;
+          constexpr bool __have_width = sizeof(_TV) == 64 or _Flags._M_have_avx512vl;
+          if (__builtin_is_constant_evaluated())
+            return _Base::_S_popcount(__x);
+          else if constexpr (sizeof(_TV) < 16)
+            return __vec_bitcast_trunc<_TV>(_S_popcount(__vec_zero_pad_to_16(__x)));
+          else if constexpr (sizeof(_Tp) >= 4 and _Flags._M_have_avx512vpopcntdq and __have_width)
+            {
+              const auto __xi = __to_x86_intrin(__x);
+              if constexpr (sizeof(_TV) == 16 and sizeof(_Tp) == 4)
+                return reinterpret_cast<_TV>(_mm_popcnt_epi32(__xi));
+              else if constexpr (sizeof(_TV) == 16)
+                return reinterpret_cast<_TV>(_mm_popcnt_epi64(__xi));
+              else if constexpr (sizeof(_TV) == 32 and sizeof(_Tp) == 4)
+                return reinterpret_cast<_TV>(_mm256_popcnt_epi32(__xi));
+              else if constexpr (sizeof(_TV) == 32)
+                return reinterpret_cast<_TV>(_mm256_popcnt_epi64(__xi));
+              else if constexpr (sizeof(_Tp) == 4)
+                return reinterpret_cast<_TV>(_mm512_popcnt_epi32(__xi));
+              else
+                return reinterpret_cast<_TV>(_mm512_popcnt_epi64(__xi));
+            }
+          else if constexpr (sizeof(_Tp) <= 2 and _Flags._M_have_avx512bitalg and __have_width)
+            {
+              const auto __xi = __to_x86_intrin(__x);
+              if constexpr (sizeof(_TV) == 16 and sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm_popcnt_epi8(__xi));
+              else if constexpr (sizeof(_TV) == 16)
+                return reinterpret_cast<_TV>(_mm_popcnt_epi16(__xi));
+              else if constexpr (sizeof(_TV) == 32 and sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm256_popcnt_epi8(__xi));
+              else if constexpr (sizeof(_TV) == 32)
+                return reinterpret_cast<_TV>(_mm256_popcnt_epi16(__xi));
+              else if constexpr (sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(_mm512_popcnt_epi8(__xi));
+              else
+                return reinterpret_cast<_TV>(_mm512_popcnt_epi16(__xi));
+            }
+          else if constexpr (_S_have_pshufb<_TV>)
+            {
+              static constexpr unsigned char __lut[16]
+                = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+              using _BV = __vec_builtin_type_bytes<unsigned char, sizeof(_TV)>;
+              const _BV __b = reinterpret_cast<_BV>(__x);
+              const _BV __c = _S_nibble_lookup(__lut, __b & 0x0f)
+                                + _S_nibble_lookup(__lut, __b >> 4);
+              if constexpr (sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(__c);
+              else if constexpr (sizeof(_Tp) == 8)
+                { // psadbw against zero sums the bytes of every 64-bit element
+                  const auto __ci = __to_x86_intrin(__c);
+                  if constexpr (sizeof(_TV) == 16)
+                    return reinterpret_cast<_TV>(_mm_sad_epu8(__ci, __m128i()));
+                  else if constexpr (sizeof(_TV) == 32)
+                    return reinterpret_cast<_TV>(_mm256_sad_epu8(__ci, __m256i()));
+                  else
+                    return reinterpret_cast<_TV>(_mm512_sad_epu8(__ci, __m512i()));
+                }
+              else
+                {
+                  using _U16V = __vec_builtin_type_bytes<unsigned short, sizeof(_TV)>;
+                  using _U32V = __vec_builtin_type_bytes<unsigned int, sizeof(_TV)>;
+                  const _U16V __c16 = reinterpret_cast<_U16V>(__c);
+                  const _U16V __s16 = (__c16 & 0xff) + (__c16 >> 8);
+                  if constexpr (sizeof(_Tp) == 2)
+                    return reinterpret_cast<_TV>(__s16);
+                  else
+                    {
+                      const _U32V __c32 = reinterpret_cast<_U32V>(__s16);
+                      return reinterpret_cast<_TV>((__c32 & 0xffff) + (__c32 >> 16));
+                    }
+                }
+            }
+          else
+            return _Base::_S_popcount(__x);
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_countl_zero(_TV __x)
+        {
+          using _Tp = __value_type_of<_TV>;
+          constexpr bool __have_width = sizeof(_TV) == 64 or _Flags._M_have_avx512vl;
+          if (__builtin_is_constant_evaluated())
+            return _Base::_S_countl_zero(__x);
+          else if constexpr (sizeof(_TV) < 16)
+            return __vec_bitcast_trunc<_TV>(_S_countl_zero(__vec_zero_pad_to_16(__x)));
+          else if constexpr (sizeof(_Tp) >= 4 and _Flags._M_have_avx512cd and __have_width)
+            {
+              const auto __xi = __to_x86_intrin(__x);
+              if constexpr (sizeof(_TV) == 16 and sizeof(_Tp) == 4)
+                return reinterpret_cast<_TV>(_mm_lzcnt_epi32(__xi));
+              else if constexpr (sizeof(_TV) == 16)
+                return reinterpret_cast<_TV>(_mm_lzcnt_epi64(__xi));
+              else if constexpr (sizeof(_TV) == 32 and sizeof(_Tp) == 4)
+                return reinterpret_cast<_TV>(_mm256_lzcnt_epi32(__xi));
+              else if constexpr (sizeof(_TV) == 32)
+                return reinterpret_cast<_TV>(_mm256_lzcnt_epi64(__xi));
+              else if constexpr (sizeof(_Tp) == 4)
+                return reinterpret_cast<_TV>(_mm512_lzcnt_epi32(__xi));
+              else
+                return reinterpret_cast<_TV>(_mm512_lzcnt_epi64(__xi));
+            }
+          else if constexpr (sizeof(_Tp) <= 2 and _S_have_pshufb<_TV>)
+            {
+              static constexpr unsigned char __lut[16]
+                = {4, 3, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0};
+              using _BV = __vec_builtin_type_bytes<unsigned char, sizeof(_TV)>;
+              const _BV __b = reinterpret_cast<_BV>(__x);
+              const _BV __hi = _S_nibble_lookup(__lut, __b >> 4);
+              const _BV __lo = _S_nibble_lookup(__lut, __b & 0x0f);
+              // the low nibble/byte only counts if the high nibble/byte is zero
+              const _BV __c = __hi + (reinterpret_cast<_BV>(__hi == 4) & __lo);
+              if constexpr (sizeof(_Tp) == 1)
+                return reinterpret_cast<_TV>(__c);
+              else
+                {
+                  using _U16V = __vec_builtin_type_bytes<unsigned short, sizeof(_TV)>;
+                  const _U16V __c16 = reinterpret_cast<_U16V>(__c);
+                  const _U16V __h16 = __c16 >> 8;
+                  return reinterpret_cast<_TV>(
+                           __h16 + (reinterpret_cast<_U16V>(__h16 == 8) & (__c16 & 0xff)));
+                }
+            }
+          else
+            return _Base::_S_countl_zero(__x);
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_countr_zero(_TV __x)
+        {
+          using _Tp = __value_type_of<_TV>;
+          if constexpr (sizeof(_Tp) >= 4 and _Flags._M_have_avx512cd
+                          and not _Flags._M_have_avx512vpopcntdq)
+            {
+              // lzcnt instead of a popcount emulation: N - countl_zero(~x & (x - 1))
+              using _UV = __vec_builtin_type_bytes<__make_unsigned_int_t<_Tp>, sizeof(_TV)>;
+              const _UV __v = reinterpret_cast<_UV>(__x);
+              const _UV __lz = reinterpret_cast<_UV>(
+                                 _S_countl_zero(reinterpret_cast<_TV>(~__v & (__v - 1))));
+              return reinterpret_cast<_TV>(int(sizeof(_Tp) * __CHAR_BIT__) - __lz);
+            }
+          else
+            return _Base::_S_countr_zero(__x);
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_bit_reverse(_TV __x)
+        {
+          if (__builtin_is_constant_evaluated())
+            return _Base::_S_bit_reverse(__x);
+          else if constexpr (sizeof(_TV) < 16)
+            return __vec_bitcast_trunc<_TV>(_S_bit_reverse(__vec_zero_pad_to_16(__x)));
+          else if constexpr (_S_have_pshufb<_TV>)
+            {
+              static constexpr unsigned char __lut[16]
+                = {0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf};
+              using _BV = __vec_builtin_type_bytes<unsigned char, sizeof(_TV)>;
+              const _BV __b = reinterpret_cast<_BV>(_Base::_S_byteswap(__x));
+              return reinterpret_cast<_TV>((_S_nibble_lookup(__lut, __b & 0x0f) << 4)
+                                             | _S_nibble_lookup(__lut, __b >> 4));
+            }
+          else
+            return _Base::_S_bit_reverse(__x);
+        }
+
+      template <__vec_builtin _TV>
+        requires integral<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_rotl(_TV __x, int __s)
+        {
+          using _Tp = __value_type_of<_TV>;
+          if (__builtin_is_constant_evaluated())
+            return _Base::_S_rotl(__x, __s);
+          else if constexpr (sizeof(_Tp) >= 4 and _Flags._M_have_avx512f
+                               and (sizeof(_TV) == 64 or _Flags._M_have_avx512vl))
+            {
+              if constexpr (sizeof(_TV) < 16)
+                return __vec_bitcast_trunc<_TV>(_S_rotl(__vec_zero_pad_to_16(__x), __s));
+              else
+                {
+                  const auto __xi = __to_x86_intrin(__x);
+                  const auto __si = __to_x86_intrin(_TV() + _Tp(__s));
+                  if constexpr (sizeof(_TV) == 16 and sizeof(_Tp) == 4)
+                    return reinterpret_cast<_TV>(_mm_rolv_epi32(__xi, __si));
+                  else if constexpr (sizeof(_TV) == 16)
+                    return reinterpret_cast<_TV>(_mm_rolv_epi64(__xi, __si));
+                  else if constexpr (sizeof(_TV) == 32 and sizeof(_Tp) == 4)
+                    return reinterpret_cast<_TV>(_mm256_rolv_epi32(__xi, __si));
+                  else if constexpr (sizeof(_TV) == 32)
+                    return reinterpret_cast<_TV>(_mm256_rolv_epi64(__xi, __si));
+                  else if constexpr (sizeof(_Tp) == 4)
+                    return reinterpret_cast<_TV>(_mm512_rolv_epi32(__xi, __si));
+                  else
+                    return reinterpret_cast<_TV>(_mm512_rolv_epi64(__xi, __si));
+                }
+            }
+          else
+            return _Base::_S_rotl(__x, __s);
+        }
+
       template <unsigned_integral _Tp>
         _GLIBCXX_SIMD_INTRINSIC static constexpr _Tp
         _S_bit_and(_Tp __x, _Tp __y)
@@ -2311,6 +2833,61 @@ namespace std::__detail
             return _Base::_S_nearbyint(__x);
         }
 
+      template <__vec_builtin _TV>
+        requires floating_point<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_addsub(_TV __x, _TV __y)
+        {
+          if (__builtin_is_constant_evaluated())
+            return _Base::_S_addsub(__x, __y);
+          else if constexpr (__vec_builtin_sizeof<_TV, 8, 64>)
+            return _mm512_fmaddsub_pd(_mm512_set1_pd(1.), __x, __y);
+          else if constexpr (__vec_builtin_sizeof<_TV, 4, 64>)
+            return _mm512_fmaddsub_ps(_mm512_set1_ps(1.f), __x, __y);
+          else if constexpr (__vec_builtin_sizeof<_TV, 8, 32>)
+            return _mm256_addsub_pd(__x, __y);
+          else if constexpr (__vec_builtin_sizeof<_TV, 4, 32>)
+            return _mm256_addsub_ps(__x, __y);
+          else if constexpr (__vec_builtin_sizeof<_TV, 8, 16> and _Flags._M_have_sse3)
+            return _mm_addsub_pd(__x, __y);
+          else if constexpr (__vec_builtin_sizeof<_TV, 4, 16> and _Flags._M_have_sse3)
+            return _mm_addsub_ps(__x, __y);
+          else if constexpr (sizeof(_TV) < 16 and sizeof(__value_type_of<_TV>) >= 4
+                               and _Flags._M_have_sse3)
+            return __vec_bitcast_trunc<_TV>(_S_addsub(__vec_zero_pad_to_16(__x),
+                                                      __vec_zero_pad_to_16(__y)));
+          else
+            return _Base::_S_addsub(__x, __y);
+        }
+
+      template <__vec_builtin _TV>
+        requires floating_point<__value_type_of<_TV>>
+        _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
+        _S_fmaddsub(_TV __x, _TV __y, _TV __z)
+        {
+          if (__builtin_is_constant_evaluated())
+            return _Base::_S_fmaddsub(__x, __y, __z);
+          else if constexpr (__vec_builtin_sizeof<_TV, 8, 64>)
+            return _mm512_fmaddsub_pd(__x, __y, __z);
+          else if constexpr (__vec_builtin_sizeof<_TV, 4, 64>)
+            return _mm512_fmaddsub_ps(__x, __y, __z);
+          else if constexpr (__vec_builtin_sizeof<_TV, 8, 32> and _Flags._M_have_fma)
+            return _mm256_fmaddsub_pd(__x, __y, __z);
+          else if constexpr (__vec_builtin_sizeof<_TV, 4, 32> and _Flags._M_have_fma)
+            return _mm256_fmaddsub_ps(__x, __y, __z);
+          else if constexpr (__vec_builtin_sizeof<_TV, 8, 16> and _Flags._M_have_fma)
+            return _mm_fmaddsub_pd(__x, __y, __z);
+          else if constexpr (__vec_builtin_sizeof<_TV, 4, 16> and _Flags._M_have_fma)
+            return _mm_fmaddsub_ps(__x, __y, __z);
+          else if constexpr (sizeof(_TV) < 16 and sizeof(__value_type_of<_TV>) >= 4
+                               and _Flags._M_have_fma)
+            return __vec_bitcast_trunc<_TV>(_S_fmaddsub(__vec_zero_pad_to_16(__x),
+                                                        __vec_zero_pad_to_16(__y),
+                                                        __vec_zero_pad_to_16(__z)));
+          else
+            return _Base::_S_fmaddsub(__x, __y, __z);
+        }
+
       template <__vec_builtin _TV>
         requires floating_point<__value_type_of<_TV>>
         _GLIBCXX_SIMD_INTRINSIC static constexpr _TV
@@ -3234,6 +3811,24 @@ namespace std::__detail
               return __m;
             }
 
+          else if constexpr (sizeof(__value_type_of<_TV>) == 2 and sizeof(_TV) <= 32)
+            {
+              // packsswb reduces the elements to one byte each, then pmovmskb collects the MSBs
+              const auto __k16 = [&] [[__gnu__::__always_inline__]] {
+                if constexpr (sizeof(_TV) == 32)
+                  return __builtin_ia32_packsswb128(__vec_bitcast<short>(__vec_lo128(__x)),
+                                                    __vec_bitcast<short>(__vec_hi128(__x)));
+                else
+                  return __builtin_ia32_packsswb128(__vec_bitcast<short>(__vec_zero_pad_to_16(__x)),
+                                                    __vec_builtin_type<short, 8>());
+              }();
+              return _SanitizedBitMask<_S_size>(static_cast<unsigned>(__movmsk(__k16)));
+            }
+
+          else if constexpr (requires { __movmsk(__x); })
+            // every bit of a mask element is equal to its MSB
+            return _SanitizedBitMask<_S_size>(static_cast<unsigned>(__movmsk(__x)));
+
           else
             return _Base::_S_to_bits(__x);
         }
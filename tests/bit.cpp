@@ -0,0 +1,105 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_bit.h"
+
+#include <bit>
+#include <limits>
+
+template <typename T>
+  constexpr T
+  ref_byteswap(T x)
+  {
+    using U = std::make_unsigned_t<T>;
+    U r = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+      r = U(r << 8) | U(U(x) >> (i * 8) & 0xff);
+    return T(r);
+  }
+
+template <typename T>
+  constexpr T
+  ref_bit_reverse(T x)
+  {
+    T r = 0;
+    for (int i = 0; i < std::numeric_limits<T>::digits; ++i)
+      r = T(r << 1) | T((x >> i) & 1);
+    return r;
+  }
+
+template <typename V>
+  struct bit
+  {
+    using T = typename V::value_type;
+
+    static constexpr T max = std::numeric_limits<T>::max();
+
+    static constexpr std::array<T, 14> values
+      = {T(0), T(1), T(2), T(3), T(0x5a), T(0x80), T(0xf0), max, T(max - 1), T(max / 2),
+         T(max / 2 + 1), T(max / 3), T(~T(0x0f)), T(max / 255 * 0x12)};
+
+    static void
+    run()
+    {
+      if constexpr (std::integral<T> and requires(V x) { std::byteswap(x); })
+        {
+          using U = std::make_unsigned_t<T>;
+          using UV = std::rebind_simd_t<U, V>;
+          using S = std::make_signed_t<T>;
+          using SV = std::rebind_simd_t<S, V>;
+          for (std::size_t offset = 0; offset < values.size(); ++offset)
+            {
+              log_start();
+              const UV x([&](int i) { return U(values[(i + offset) % values.size()]); });
+              const UV xu = make_value_unknown(x);
+
+              const V bs_ref([&](int i) { return ref_byteswap(T(x[i])); });
+              verify_equal(std::byteswap(V(x)), bs_ref)(x);
+              verify_equal(std::byteswap(V(xu)), bs_ref)(x);
+
+              const SV pop_ref([&](int i) { return S(std::popcount(x[i])); });
+              verify_equal(std::popcount(x), pop_ref)(x);
+              verify_equal(std::popcount(xu), pop_ref)(x);
+
+              const SV clz_ref([&](int i) { return S(std::countl_zero(x[i])); });
+              verify_equal(std::countl_zero(x), clz_ref)(x);
+              verify_equal(std::countl_zero(xu), clz_ref)(x);
+              verify_equal(std::countl_one(xu), SV([&](int i) { return S(std::countl_one(x[i])); }))(x);
+
+              const SV ctz_ref([&](int i) { return S(std::countr_zero(x[i])); });
+              verify_equal(std::countr_zero(x), ctz_ref)(x);
+              verify_equal(std::countr_zero(xu), ctz_ref)(x);
+              verify_equal(std::countr_one(xu), SV([&](int i) { return S(std::countr_one(x[i])); }))(x);
+
+              const SV width_ref([&](int i) { return S(std::bit_width(x[i])); });
+              verify_equal(std::bit_width(xu), width_ref)(x);
+              verify_equal(std::has_single_bit(xu), std::popcount(xu) == S(1))(x);
+
+              const UV rev_ref([&](int i) { return ref_bit_reverse(x[i]); });
+              verify_equal(std::bit_reverse(x), rev_ref)(x);
+              verify_equal(std::bit_reverse(xu), rev_ref)(x);
+
+              for (int s : {0, 1, 3, 7, 8, int(sizeof(T) * 8 - 1), int(sizeof(T) * 8), -1, -9,
+                            std::numeric_limits<int>::min(), std::numeric_limits<int>::max()})
+                {
+                  const UV rotl_ref([&](int i) { return std::rotl(x[i], s); });
+                  const UV rotr_ref([&](int i) { return std::rotr(x[i], s); });
+                  verify_equal(std::rotl(x, s), rotl_ref)(x, s);
+                  verify_equal(std::rotl(xu, make_value_unknown(s)), rotl_ref)(x, s);
+                  verify_equal(std::rotr(xu, make_value_unknown(s)), rotr_ref)(x, s);
+                  verify_equal(std::rotl(xu, SV(S(s))), rotl_ref)(x, s);
+                  verify_equal(std::rotr(xu, SV(S(s))), rotr_ref)(x, s);
+                }
+              const SV sv([&](int i) { return S(i * 3 - 5); });
+              verify_equal(std::rotl(xu, sv), UV([&](int i) { return std::rotl(x[i], sv[i]); }))(x, sv);
+              verify_equal(std::rotr(xu, sv), UV([&](int i) { return std::rotr(x[i], sv[i]); }))(x, sv);
+            }
+        }
+    }
+  };
+
+auto tests = register_tests<bit>();
@@ -0,0 +1,130 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_complex.h"
+
+template <typename V>
+  struct complex_arithmetic
+  {
+    using T = typename V::value_type;
+    using C = std::complex<T>;
+
+    // all results are exactly representable, so that FMA contraction cannot change them; the
+    // divisors have power-of-2 norms
+    static constexpr std::array<C, 6> divisors
+      = {C(1, 1), C(2, 2), C(1, 0), C(0, 2), C(-1, 1), C(4, 0)};
+
+    static C
+    a_at(int i)
+    { return C(T(i % 7) - 3, T(i % 5) - T(2.5)); }
+
+    static C
+    b_at(int i)
+    { return divisors[i % divisors.size()]; }
+
+    static C
+    c_at(int i)
+    { return C(T(i % 3), -T(i % 4)); }
+
+    template <typename CV>
+      static void
+      verify_elements(const CV& x, auto&& ref, std::source_location loc
+                                                 = std::source_location::current())
+      {
+        const V re([&](int i) { return ref(i).real(); });
+        const V im([&](int i) { return ref(i).imag(); });
+        verify_equal(x.real(), re, loc)(x.real(), x.imag());
+        verify_equal(x.imag(), im, loc)(x.real(), x.imag());
+      }
+
+    template <std::simd_complex_layout Layout>
+      static void
+      run_layout()
+      {
+        using CV = std::simd_complex<V, Layout>;
+        log_start();
+        std::array<C, V::size()> mem_a, mem_b, mem_c, out;
+        for (int i = 0; i < V::size(); ++i)
+          {
+            mem_a[i] = a_at(i);
+            mem_b[i] = b_at(i);
+            mem_c[i] = c_at(i);
+          }
+        const CV a(mem_a.begin());
+        const CV b = make_value_unknown(CV(mem_b.begin()));
+        const CV c(mem_c.begin());
+
+        verify_elements(a, a_at);
+        for (int i = 0; i < V::size(); ++i)
+          verify_equal(a[i], mem_a[i])(i);
+
+        a.copy_to(out.begin());
+        verify_equal(out == mem_a, true);
+
+        verify_elements(CV(a.real(), a.imag()), a_at);
+        verify_elements(CV(C(2, -3)), [](int) { return C(2, -3); });
+        verify_elements(CV(a.real()), [](int i) { return C(a_at(i).real(), 0); });
+
+        verify_elements(-a, [](int i) { return -a_at(i); });
+        verify_elements(a + b, [](int i) { return a_at(i) + b_at(i); });
+        verify_elements(a - b, [](int i) { return a_at(i) - b_at(i); });
+        verify_elements(a * b, [](int i) { return a_at(i) * b_at(i); });
+        verify_elements(b * a, [](int i) { return a_at(i) * b_at(i); });
+        verify_elements(a / b, [](int i) { return a_at(i) / b_at(i); });
+        verify_elements(conj(a), [](int i) { return std::conj(a_at(i)); });
+        verify_elements(fma(a, b, c), [](int i) { return a_at(i) * b_at(i) + c_at(i); });
+        verify_equal(norm(a), V([](int i) { return std::norm(a_at(i)); }));
+        verify_equal(real(a), a.real());
+        verify_equal(imag(a), a.imag());
+
+        CV x = a;
+        x *= b;
+        x += c;
+        x -= a;
+        x /= b;
+        verify_elements(x, [](int i) { return (a_at(i) * b_at(i) + c_at(i) - a_at(i)) / b_at(i); });
+
+        constexpr auto other = Layout == std::simd_complex_layout::split
+                                 ? std::simd_complex_layout::interleaved
+                                 : std::simd_complex_layout::split;
+        const std::simd_complex<V, other> y(a);
+        verify_elements(y, a_at);
+        verify_elements(CV(y), a_at);
+      }
+
+    // x * x -/+ z with (1 + small)² not representable: a fused fmaddsub yields small², an unfused
+    // one 0; either way a simd split into chunks must round like the native simd does
+    static void
+    fmaddsub_matches_native()
+    {
+      using W = std::resize_simd_t<2 * V::size(), V>;
+      using N = std::simd<T>;
+      log_start();
+      const T small = std::ldexp(T(1), -(std::numeric_limits<T>::digits + 1) / 2);
+      const T one = make_value_unknown(T(1));
+      auto zgen = [&](int i) { return i % 2 == 0 ? one + 2 * small : -(one + 2 * small); };
+      const W w = std::__detail::__fmaddsub(W(one + small), W(one + small), W(zgen));
+      const N n = std::__detail::__fmaddsub(N(one + small), N(one + small), N(zgen));
+      verify_equal(n[0], n[1]);
+      verify_equal(w, W(n[0]))(w, n);
+    }
+
+    static void
+    run()
+    {
+      if constexpr (std::floating_point<T>
+                      and std::destructible<std::resize_simd_t<2 * V::size(), V>>)
+        {
+          run_layout<std::simd_complex_layout::interleaved>();
+          run_layout<std::simd_complex_layout::split>();
+          if constexpr (std::simd<T>::size() % 2 == 0)
+            fmaddsub_matches_native();
+        }
+    }
+  };
+
+auto tests = register_tests<complex_arithmetic>();
@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_divider.h"
+
+#include <limits>
+
+template <typename T>
+  constexpr T
+  ref_divides(T a, T b)
+  {
+    if constexpr (std::is_signed_v<T>)
+      if (b == -1) // avoid UB on min / -1, simd_divider wraps like unary minus
+        return T(-std::make_unsigned_t<T>(a));
+    return T(a / b);
+  }
+
+// x - q * d with wrapping arithmetic
+template <typename T>
+  constexpr T
+  ref_modulus(T x, T q, T d)
+  {
+    using U = unsigned long long;
+    return T(U(x) - U(q) * U(d));
+  }
+
+template <typename V>
+  struct divider
+  {
+    using T = typename V::value_type;
+
+    static constexpr T min = std::numeric_limits<T>::min();
+    static constexpr T max = std::numeric_limits<T>::max();
+
+    static constexpr std::array<T, 12> values
+      = {T(0), T(1), T(2), T(3), T(7), max, T(max - 1), T(max / 2), T(max / 3), min, T(min + 1),
+         T(min / 2)};
+
+    static constexpr std::array<T, 16> divisors
+      = {T(1), T(2), T(3), T(5), T(7), T(10), T(16), T(25), T(max), T(max - 1), T(max / 2 + 1),
+         T(max / 7), T(min), T(min + 1), T(min / 3), T(-1)};
+
+    static void
+    run()
+    {
+      if constexpr (std::integral<T> and requires { std::simd_divider<T>(T(1)); })
+        {
+          for (T d : divisors)
+            {
+              if (d == 0)
+                continue;
+              log_start();
+              const std::simd_divider<T> div(d);
+              const std::simd_divider<T> div_unknown(make_value_unknown(d));
+              verify_equal(div.divisor(), d);
+              const V dv = d;
+              for (std::size_t offset = 0; offset < values.size(); ++offset)
+                {
+                  const V x([&](int i) { return values[(i + offset) % values.size()]; });
+                  const V q_ref([&](int i) { return ref_divides(x[i], d); });
+                  const V r_ref([&](int i) { return ref_modulus(x[i], q_ref[i], d); });
+                  verify_equal(x / div, q_ref)(x, d);
+                  verify_equal(make_value_unknown(x) / div_unknown, q_ref)(x, d);
+                  verify_equal(x % div, r_ref)(x, d);
+                  verify_equal(make_value_unknown(x) % div_unknown, r_ref)(x, d);
+                  if (d != T(-1))
+                    verify_equal(x / div, x / dv)(x, d);
+                }
+              // all values of the type for 8-bit types, or a strided range for larger types
+              constexpr std::size_t step = sizeof(T) == 1 ? 1 : (std::size_t(max) >> 10) | 1;
+              for (std::size_t i = 0; i < 1024; ++i)
+                {
+                  const V x([&](int j) { return T((i * V::size() + j) * step); });
+                  const V q_ref([&](int j) { return ref_divides(x[j], d); });
+                  verify_equal(make_value_unknown(x) / div_unknown, q_ref)(x, d);
+                }
+            }
+        }
+    }
+  };
+
+auto tests = register_tests<divider>();
@@ -0,0 +1,112 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_integer.h"
+
+#include <limits>
+
+template <typename T>
+  constexpr T
+  ref_add_sat(T a, T b)
+  {
+    T r;
+    if (not __builtin_add_overflow(a, b, &r))
+      return r;
+    else if (std::is_unsigned_v<T> or a > 0)
+      return std::numeric_limits<T>::max();
+    else
+      return std::numeric_limits<T>::min();
+  }
+
+template <typename T>
+  constexpr T
+  ref_sub_sat(T a, T b)
+  {
+    T r;
+    if (not __builtin_sub_overflow(a, b, &r))
+      return r;
+    else if (std::is_unsigned_v<T> or a < 0)
+      return std::numeric_limits<T>::min();
+    else
+      return std::numeric_limits<T>::max();
+  }
+
+template <typename T>
+  constexpr std::make_unsigned_t<T>
+  ref_abs_diff(T a, T b)
+  {
+    using U = std::make_unsigned_t<T>;
+    return a < b ? U(U(b) - U(a)) : U(U(a) - U(b));
+  }
+
+template <typename T>
+  constexpr T
+  ref_avg(T a, T b)
+  {
+    // (a + b + 1) >> 1 without overflow
+    const auto d = ref_abs_diff(a, b);
+    const T lo = std::min(a, b);
+    return T(lo + T(d / 2) + T(d & 1));
+  }
+
+template <typename V>
+  struct integer_arithmetic
+  {
+    using T = typename V::value_type;
+    using M = typename V::mask_type;
+
+    static constexpr T min = std::numeric_limits<T>::min();
+    static constexpr T max = std::numeric_limits<T>::max();
+
+    static constexpr std::array<T, 12> values
+      = {T(0), T(1), T(2), max, T(max - 1), T(max / 2), T(max / 2 + 1), min, T(min + 1),
+         T(min / 2), T(min / 2 - 1), T(max / 3)};
+
+    static void
+    run()
+    {
+      if constexpr (requires(V x) { std::add_sat(x, x); })
+        {
+          using U = std::make_unsigned_t<T>;
+          using UV = std::rebind_simd_t<U, V>;
+          for (std::size_t offset = 0; offset < values.size(); ++offset)
+            {
+              log_start();
+              const V x([](int i) { return values[i % values.size()]; });
+              const V y([&](int i) { return values[(i * 5 + offset) % values.size()]; });
+
+              const V add_ref([&](int i) { return ref_add_sat(x[i], y[i]); });
+              verify_equal(std::add_sat(x, y), add_ref)(x, y);
+              verify_equal(std::add_sat(make_value_unknown(x), make_value_unknown(y)), add_ref)(x, y);
+              verify_equal(std::add_sat(y, x), add_ref)(x, y);
+
+              const V sub_ref([&](int i) { return ref_sub_sat(x[i], y[i]); });
+              verify_equal(std::sub_sat(x, y), sub_ref)(x, y);
+              verify_equal(std::sub_sat(make_value_unknown(x), make_value_unknown(y)), sub_ref)(x, y);
+
+              const V avg_ref([&](int i) { return ref_avg(x[i], y[i]); });
+              verify_equal(std::avg(x, y), avg_ref)(x, y);
+              verify_equal(std::avg(make_value_unknown(x), make_value_unknown(y)), avg_ref)(x, y);
+              verify_equal(std::avg(y, x), avg_ref)(x, y);
+
+              const UV diff_ref([&](int i) { return ref_abs_diff(x[i], y[i]); });
+              verify_equal(std::abs_diff(x, y), diff_ref)(x, y);
+              verify_equal(std::abs_diff(make_value_unknown(x), make_value_unknown(y)), diff_ref)(x, y);
+              verify_equal(std::abs_diff(y, x), diff_ref)(x, y);
+
+              decltype(std::sad(x, y)) sad_ref = 0;
+              for (int i = 0; i < V::size(); ++i)
+                sad_ref += diff_ref[i];
+              verify_equal(std::sad(x, y), sad_ref)(x, y);
+              verify_equal(std::sad(make_value_unknown(x), make_value_unknown(y)), sad_ref)(x, y);
+              verify_equal(std::sad(y, x), sad_ref)(x, y);
+            }
+        }
+    }
+  };
+
+auto tests = register_tests<integer_arithmetic>();
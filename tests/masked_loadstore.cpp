@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+template <typename V>
+  struct masked_loadstore_tests
+  {
+    using T = typename V::value_type;
+
+    using M = typename V::mask_type;
+
+    static constexpr int N = V::size();
+
+    static void
+    run()
+    {
+      test_masked<T>();
+      test_masked<short>();
+      test_masked<double>();
+      test_page_end();
+    }
+
+    static M
+    make_mask(unsigned long long bits)
+    { return V([&](int i) { return T((bits >> (i % 64)) & 1); }) != T(); }
+
+    // masked copy_from/copy_to, with and without conversion
+    template <typename U>
+      static void
+      test_masked()
+      {
+        alignas(64) U mem[N + 64];
+        alignas(64) U out[N + 64];
+        for (int offset : {0, 1})
+          for (unsigned long long bits : {0ull, ~0ull, 1ull, 1ull << (N - 1), 0x5555555555555555ull,
+                                          0xf0f0f0f0f0f0f0f0ull, (1ull << (N / 2)) - 1})
+            {
+              log_start();
+              const M k = make_mask(bits);
+              for (int i = 0; i < N + 64; ++i)
+                {
+                  mem[i] = U(i + 1);
+                  out[i] = U(-1);
+                }
+              V x(T(-2));
+              x.copy_from(mem + offset, k, std::simd_flag_convert);
+              verify_equal(x, V([&](int i) { return k[i] ? T(U(i + 1 + offset)) : T(-2); }))(
+                offset, bits);
+
+              // may read the unselected elements (blend from a full load)
+              V y(T(-2));
+              y.copy_from(mem + offset, k, std::simd_flag_convert | std::__simd_flag_page_safe);
+              verify_equal(y, x)(offset, bits);
+
+              x.copy_to(out + offset, k, std::simd_flag_convert);
+              for (int i = 0; i < N + 64; ++i)
+                {
+                  const int lane = i - offset;
+                  const bool stored = lane >= 0 and lane < N and k[lane];
+                  verify_equal(out[i], stored ? U(i + 1) : U(-1))(offset, bits, i);
+                }
+            }
+      }
+
+    // masked loads and stores next to an inaccessible page must not fault
+    static void
+    test_page_end()
+    {
+      log_start();
+      const std::size_t page = sysconf(_SC_PAGESIZE);
+      if (page < N * sizeof(T))
+        return;
+      char* mem = static_cast<char*>(mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE,
+                                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+      verify(mem != MAP_FAILED);
+      mprotect(mem + page, page, PROT_NONE);
+      T* const page_end = reinterpret_cast<T*>(mem + page);
+      for (int n = 0; n <= N; ++n)
+        {
+          T* const ptr = page_end - n;
+          for (int i = 0; i < n; ++i)
+            ptr[i] = T(i + 1);
+          const M k = V([](int i) { return T(i); }) < T(n);
+          V x = V();
+          x.copy_from(ptr, k);
+          verify_equal(x, V([&](int i) { return i < n ? T(i + 1) : T(); }))(n);
+          V y = V();
+          y.copy_from(ptr, k, std::__simd_flag_page_safe);
+          verify_equal(y, x)(n);
+          (x + T(1)).copy_to(ptr, k);
+          for (int i = 0; i < n; ++i)
+            verify_equal(ptr[i], T(i + 2))(n, i);
+        }
+      munmap(mem, 2 * page);
+    }
+  };
+
+auto tests = register_tests<masked_loadstore_tests>();
@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_polynomial.h"
+
+template <typename T, typename... Cs>
+  constexpr T
+  ref_horner(T x, Cs... cs)
+  {
+    const T c[] = {T(cs)...};
+    T r = c[sizeof...(Cs) - 1];
+    for (int i = sizeof...(Cs) - 2; i >= 0; --i)
+      r = T(r * x + c[i]);
+    return r;
+  }
+
+template <typename V>
+  struct polynomial
+  {
+    using T = typename V::value_type;
+
+    template <int N>
+      static void
+      test_lut()
+      {
+        using Tab = std::simd<T, N>;
+        if constexpr (std::destructible<Tab>)
+          {
+            const Tab table([](int i) { return T((i * 7) % 5) - T(i) / T(4); });
+            const Tab tu = make_value_unknown(table);
+            for (int offset = -8; offset < 4 * N + 8; offset += int(V::size()))
+              {
+                const V x([&](int i) { return T(offset + i) / T(4); });
+                const V ref([&](int i) {
+                  const T xi = std::min(std::max(x[i], T()), T(N - 1));
+                  const int j = std::min(int(xi), N - 2);
+                  return table[j] + (xi - T(j)) * (table[j + 1] - table[j]);
+                });
+                verify_equal(std::simd_lut_interpolate(table, x), ref)(table, x);
+                verify_equal(std::simd_lut_interpolate(tu, make_value_unknown(x)), ref)(table, x);
+              }
+          }
+      }
+
+    static void
+    run()
+    {
+      log_start();
+      for (int offset = 0; offset < 5; ++offset)
+        {
+          const V x([&](int i) { return T((i + offset) % 5 - 2); });
+          const V xu = make_value_unknown(x);
+
+          verify_equal(std::simd_horner(xu, vir::cw<3>), V(T(3)))(x);
+          verify_equal(std::simd_horner(xu, vir::cw<0>, vir::cw<1>), x)(x);
+          verify_equal(std::simd_horner(xu, vir::cw<1>, vir::cw<2>),
+                       V([&](int i) { return ref_horner(x[i], 1, 2); }))(x);
+
+          const V ref([&](int i) { return ref_horner(x[i], 3, 0, -1, 1, 2); });
+          verify_equal(std::simd_horner(x, vir::cw<3>, vir::cw<0>, vir::cw<-1>, vir::cw<1>,
+                                        vir::cw<2>), ref)(x);
+          verify_equal(std::simd_horner(xu, vir::cw<3>, vir::cw<0>, vir::cw<-1>, vir::cw<1>,
+                                        vir::cw<2>), ref)(x);
+          verify_equal(std::simd_estrin(xu, vir::cw<3>, vir::cw<0>, vir::cw<-1>, vir::cw<1>,
+                                        vir::cw<2>), ref)(x);
+          verify_equal(std::simd_estrin(xu, vir::cw<3>), V(T(3)))(x);
+
+          const V ref6([&](int i) { return ref_horner(x[i], 1, -1, 2, 0, 1, 1); });
+          verify_equal(std::simd_estrin(xu, vir::cw<1>, vir::cw<-1>, vir::cw<2>, vir::cw<0>,
+                                        vir::cw<1>, vir::cw<1>), ref6)(x);
+          verify_equal(std::simd_horner(xu, vir::cw<1>, vir::cw<-1>, vir::cw<2>, vir::cw<0>,
+                                        vir::cw<1>, vir::cw<1>), ref6)(x);
+        }
+
+      // runtime-index permute
+      using I = std::rebind_simd_t<int, V>;
+      if constexpr (std::destructible<I>)
+        {
+          const V v([](int i) { return T(i + 1); });
+          const I idx([](int i) { return int(V::size()) - 1 - (i * 3) % int(V::size()); });
+          verify_equal(std::simd_permute(make_value_unknown(v), make_value_unknown(idx)),
+                       V([&](int i) { return v[idx[i]]; }))(idx);
+        }
+
+      if constexpr (std::floating_point<T>)
+        {
+          const V x([](int i) { return T(i) / T(8) - T(1); });
+          verify_equal(std::simd_horner(make_value_unknown(x), vir::cw<.5>, vir::cw<.25>),
+                       x * T(.25) + T(.5))(x);
+          test_lut<2>();
+          test_lut<4>();
+          test_lut<8>();
+          test_lut<16>();
+        }
+    }
+  };
+
+auto tests = register_tests<polynomial>();
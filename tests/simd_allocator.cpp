@@ -0,0 +1,107 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_allocator.h"
+#include "../iota.h"
+
+#include <cstdint>
+#include <new>
+#include <vector>
+
+template <typename V>
+  struct simd_allocator_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int N = V::size();
+
+    static bool
+    is_aligned(const void* p, std::size_t alignment)
+    { return reinterpret_cast<std::uintptr_t>(p) % alignment == 0; }
+
+    // loads at multiples of N are aligned only if N * sizeof(T) is a multiple of the alignment
+    static V
+    load(const T* p)
+    {
+      if constexpr (N * sizeof(T) % std::simd_alignment_v<V> == 0)
+        return V(p, std::simd_flag_aligned);
+      else
+        return V(p);
+    }
+
+    static void
+    run()
+    {
+      using A = std::simd_allocator<T, V>;
+      static_assert(A::alignment >= std::simd_alignment_v<V>);
+      static_assert(A::alignment % alignof(T) == 0);
+
+      log_start();
+      // the padding after the requested elements is zero
+      for (int n : {1, N - 1, N, N + 1, 3 * N + 2})
+        {
+          if (n <= 0)
+            continue;
+          A alloc;
+          T* p = alloc.allocate(n);
+          verify(is_aligned(p, A::alignment))(n);
+          verify_equal(A::padded_size(n) % N, 0u)(n);
+          std::fill_n(p, n, T(1));
+          const V last = load(p + (n - 1) / N * N);
+          verify_equal(last, std::simd_select(std::iota_v<V> < T(n - (n - 1) / N * N),
+                                              V(T(1)), V()))(n);
+          alloc.deallocate(p, n);
+        }
+
+      // std::vector with simd_allocator
+      std::vector<T, A> v(N + 1, T(2));
+      verify(is_aligned(v.data(), A::alignment));
+      const V x = load(v.data() + N);
+      verify_equal(x[0], T(2));
+
+      // simd_buffer is zero-initialized and padded
+      std::simd_buffer<T, V> b(2 * N + 1);
+      verify_equal(b.size(), std::size_t(2 * N + 1));
+      verify_equal(b.padded_size(), std::size_t((2 * N + 1 + N - 1) / N * N));
+      verify_equal(b.padded().size(), b.padded_size());
+      verify(is_aligned(b.data(), A::alignment));
+      for (std::size_t i = 0; i < b.size(); ++i)
+        b[i] = T(i % 64);
+      for (std::size_t i = 0; i < b.padded_size(); i += N)
+        {
+          const V chunk = load(b.data() + i);
+          verify_equal(chunk, V([&](std::size_t j) {
+                         return i + j < b.size() ? T((i + j) % 64) : T();
+                       }))(i);
+        }
+      const std::simd_buffer<T, V> copy = b;
+      verify_equal(copy[2 * N], T(2 * N % 64));
+      verify_equal(std::span<const T>(copy).size(), b.size());
+      std::simd_buffer<T, V> filled(3, T(3));
+      verify_equal(filled[2], T(3));
+
+      // huge allocations are aligned to the huge page size
+      const std::size_t huge = (std::size_t(4) << 20) / sizeof(T) + 1;
+      std::simd_buffer<T, V> large(huge);
+      verify(is_aligned(large.data(), std::size_t(2) << 20));
+      verify_equal(large[huge - 1], T());
+
+      // sizes for which the rounding to the huge page size overflows are rejected
+      bool caught = false;
+      try
+        {
+          (void) std::simd_allocator<T, V>().allocate(std::size_t(-1) / sizeof(T) - N);
+        }
+      catch (const std::bad_array_new_length&)
+        {
+          caught = true;
+        }
+      verify(caught);
+    }
+  };
+
+auto tests = register_tests<simd_allocator_tests>();
@@ -0,0 +1,153 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_aosoa.h"
+
+// a user-defined aggregate that opts into the tuple protocol
+template <typename T>
+  struct Particle
+  {
+    T x;
+    float m;
+
+    friend constexpr bool
+    operator==(const Particle&, const Particle&) = default;
+
+    friend std::ostream&
+    operator<<(std::ostream& s, const Particle& p)
+    { return s << '{' << p.x << ", " << p.m << '}'; }
+  };
+
+template <typename T>
+  struct std::tuple_size<Particle<T>>
+  : std::integral_constant<std::size_t, 2>
+  {};
+
+template <std::size_t I, typename T>
+  struct std::tuple_element<I, Particle<T>>
+  { using type = std::conditional_t<I == 0, T, float>; };
+
+template <std::size_t I, typename T>
+  constexpr const auto&
+  get(const Particle<T>& p)
+  {
+    if constexpr (I == 0)
+      return p.x;
+    else
+      return p.m;
+  }
+
+template <typename V>
+  struct simd_aosoa_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int N = V::size();
+
+    using P = Particle<T>;
+
+    static P
+    make(int i)
+    { return {T(i % 100), float(i) / 2}; }
+
+    static void
+    run()
+    {
+      if constexpr (std::destructible<std::simd<float, N>>)
+        {
+          using SV = std::simd_aosoa<P, N>;
+          static_assert(std::same_as<typename SV::simd_value_type,
+                                     std::tuple<V, std::simd<float, N>>>);
+          for (int n : {0, 1, N - 1, N, N + 1, 3 * N + 2})
+            {
+              log_start();
+              SV v;
+              for (int i = 0; i < n; ++i)
+                v.push_back(make(i));
+              verify_equal(v.size(), std::size_t(n));
+              verify_equal(v.capacity() % N, 0u);
+              for (int i = 0; i < n; ++i)
+                verify_equal(v[i], make(i))(i);
+
+              // chunk loads zero the lanes past the end
+              int count = 0;
+              for (auto&& chunk : v.chunks())
+                {
+                  verify_equal(chunk.index(), std::size_t(count * N));
+                  const auto [x, m] = chunk.load();
+                  verify_equal(x, V([&](int i) {
+                                 return chunk.index() + i < std::size_t(n) ? T((count * N + i) % 100)
+                                                                         : T();
+                               }))(n, count);
+                  verify_equal(m[0], float(count * N) / 2)(n, count);
+                  verify_equal(reduce_count(chunk.mask()), int(chunk.size()))(n, count);
+                  ++count;
+                }
+              verify_equal(count, (n + N - 1) / N);
+
+              // chunk stores keep the padding zero
+              for (auto chunk : v.chunks())
+                {
+                  auto [x, m] = chunk.load();
+                  chunk = {x + T(1), m * 2.f};
+                }
+              for (int i = 0; i < n; ++i)
+                verify_equal(v[i], P{T(make(i).x + T(1)), float(i)})(i);
+              if (n % N != 0)
+                {
+                  const auto last = v.chunk(n / N * N);
+                  verify_equal(last.template get<0>(),
+                               V([&](int i) { return i < n % N ? T((n / N * N + i) % 100 + 1)
+                                                               : T(); }))(n);
+                }
+
+              // shrinking re-zeroes the removed elements, copies are deep
+              const SV copy = v;
+              v.resize(n / 2);
+              v.resize(n);
+              for (int i = n / 2; i < n; ++i)
+                verify_equal(v[i], P{})(i);
+              for (int i = 0; i < n; ++i)
+                verify_equal(copy[i], P{T(make(i).x + T(1)), float(i)})(i);
+              verify_equal(copy.size(), std::size_t(n));
+            }
+
+          // std::tuple works out of the box
+          std::simd_aosoa<std::tuple<T, double>, N> t = {{T(1), 2.}, {T(3), 4.}};
+          verify_equal(std::get<1>(t[1]), 4.);
+          verify_equal(std::get<0>(t.chunk(1 / N * N).load())[1 % N], T(3));
+
+          // members of different size and alignment share a block
+          if constexpr (std::destructible<std::simd<double, N>>
+                          and std::destructible<std::simd<char, N>>
+                          and std::destructible<std::simd<short, N>>)
+            {
+              std::simd_aosoa<std::tuple<char, double, short>, N> m;
+              for (int i = 0; i < 2 * N + 1; ++i)
+                m.push_back({char(i), double(i) / 4, short(-i)});
+              for (int i = 0; i < 2 * N + 1; ++i)
+                {
+                  const auto [c, d, s] = m[i];
+                  verify_equal(c, char(i))(i);
+                  verify_equal(d, double(i) / 4)(i);
+                  verify_equal(s, short(-i))(i);
+                }
+              for (auto chunk : m.chunks())
+                {
+                  const auto [c, d, s] = chunk.load();
+                  verify_equal(d, std::simd<double, N>([&](int i) {
+                                 return chunk.index() + i < m.size()
+                                          ? double(chunk.index() + i) / 4 : 0.;
+                               }))(chunk.index());
+                  verify_equal(s[0], short(-int(chunk.index())));
+                }
+            }
+        }
+    }
+  };
+
+auto tests = register_tests<simd_aosoa_tests>();
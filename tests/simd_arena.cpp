@@ -0,0 +1,121 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_arena.h"
+#include "../simd_vector.h"
+
+#include <cstdint>
+#include <new>
+
+template <typename V>
+  struct simd_arena_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int N = V::size();
+
+    static bool
+    is_aligned(const void* p, std::size_t alignment)
+    { return reinterpret_cast<std::uintptr_t>(p) % alignment == 0; }
+
+    static void
+    run()
+    {
+      log_start();
+      std::simd_arena arena(256);
+      for (int n : {1, N - 1, N + 1, 3 * N + 2})
+        {
+          if (n <= 0)
+            continue;
+          std::span<T> s = arena.template allocate<T, V>(n);
+          verify_equal(s.size(), std::size_t(n));
+          verify(is_aligned(s.data(), std::simd_alignment_v<V>))(n);
+          std::fill(s.begin(), s.end(), T(1));
+          for (int i = n; i < (n + N - 1) / N * N; ++i)
+            verify_equal(s.data()[i], T())(n, i);
+        }
+
+      // arrays of simd objects, e.g. for the result of simd_split
+      std::span<V> vs = arena.template allocate<V>(5);
+      verify(is_aligned(vs.data(), alignof(V)));
+      vs[4] = V(T(2));
+      verify_equal(vs[4], V(T(2)));
+
+      // larger than the initial block
+      std::span<T> big = arena.template allocate<T>(1000);
+      big.back() = T(3);
+      verify(is_aligned(big.data(), std::simd_alignment_v<std::simd<T>>));
+
+      // reset reuses the blocks without allocating new ones
+      const std::size_t cap = arena.capacity();
+      arena.reset();
+      T* first = arena.template allocate<T, V>(1).data();
+      for (int i = 0; i < 100; ++i)
+        {
+          arena.reset();
+          verify_equal(arena.template allocate<T, V>(1).data(), first)(i);
+          (void) arena.template allocate<T>(1000);
+        }
+      verify_equal(arena.capacity(), cap);
+
+      // sizes that overflow throw instead of returning memory from the current block
+      constexpr std::size_t max = std::size_t(-1);
+      const auto throws = [&](auto&& f) {
+        bool caught = false;
+        try
+          {
+            (void) f();
+          }
+        catch (const std::bad_alloc&)
+          {
+            caught = true;
+          }
+        return caught;
+      };
+      verify(throws([&] { return arena.allocate_bytes(max - 64, 16); }));
+      verify(throws([&] { return arena.allocate_bytes(max, 128); }));
+      verify(throws([&] { return arena.template allocate<T>(max / 2); }));
+      verify(throws([&] { return arena.template allocate<T, V>(max - 1); }));
+      verify(throws([&] { return arena.template allocate<V>(max / sizeof(V) + 1); }));
+      bool bad_length = false;
+      try
+        {
+          (void) arena.template allocate<T, V>(max / sizeof(T));
+        }
+      catch (const std::bad_array_new_length&)
+        {
+          bad_length = true;
+        }
+      verify(bad_length);
+      verify_equal(arena.capacity(), cap);
+      verify(is_aligned(arena.template allocate<T, V>(N).data(), std::simd_alignment_v<V>));
+
+      // pmr adaptor
+      if constexpr (std::destructible<std::simd<float, N>>)
+        {
+          std::simd_arena_resource res(std::this_thread_simd_arena());
+          std::simd_vector<std::tuple<T, float>, N> v(&res);
+          for (int i = 0; i < 3 * N + 1; ++i)
+            v.push_back({T(i % 100), float(i)});
+          verify_equal(v.get_memory_resource(), &res);
+          verify_equal(std::get<0>(v[3 * N]), T(3 * N % 100));
+          verify_equal(std::get<1>(v.chunk(3 * N).load())[N - 1], N == 1 ? float(3 * N) : 0.f);
+
+          // copies use the default resource, moves keep the resource
+          auto copy = v;
+          verify_equal(copy.get_memory_resource(), std::pmr::get_default_resource());
+          auto moved = std::move(v);
+          verify_equal(moved.get_memory_resource(), &res);
+          copy = std::move(moved);
+          verify_equal(copy.get_memory_resource(), std::pmr::get_default_resource());
+          verify_equal(std::get<1>(copy[3 * N]), float(3 * N));
+          std::this_thread_simd_arena().reset();
+        }
+    }
+  };
+
+auto tests = register_tests<simd_arena_tests>();
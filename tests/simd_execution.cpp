@@ -0,0 +1,243 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_execution.h"
+
+#include <atomic>
+#include <list>
+#include <thread>
+#include <vector>
+
+template <typename V>
+  struct simd_execution_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int N = std::simd<T>::size();
+
+    // element-wise operations that only work with simd arguments
+    static constexpr auto clamp_op = [](auto x) {
+      static_assert(std::is_simd_v<decltype(x)>);
+      return std::simd_select(x > T(50), decltype(x)(T(50)), x);
+    };
+
+    static constexpr auto max_op = [](auto a, auto b) {
+      static_assert(std::is_simd_v<decltype(a)>);
+      return std::simd_select(a < b, b, a);
+    };
+
+    static void
+    run()
+    {
+      for (int n : {0, 1, N - 1, N + 1, 1000, 100'000})
+        {
+          test_transform(std::execution::unseq, n);
+          test_transform(std::execution::par_unseq, n);
+          test_reduce(std::execution::unseq, n);
+          test_reduce(std::execution::par_unseq, n);
+          test_transform_reduce(std::execution::unseq, n);
+          test_transform_reduce(std::execution::par_unseq, n);
+        }
+      test_fallback();
+      test_concurrent();
+      if constexpr (std::integral<T>)
+        for (int n : {1, N - 1, N + 1, 1000})
+          test_trapping(n);
+    }
+
+    static std::vector<T>
+    make_input(int n)
+    {
+      std::vector<T> r(n + 1);
+      for (int i = 0; i < n + 1; ++i)
+        r[i] = T((i * 7) % 100);
+      return r;
+    }
+
+    static void
+    test_transform(const auto& policy, int n)
+    {
+      log_start();
+      const std::vector<T> in = make_input(n);
+      std::vector<T> in2(n + 1);
+      for (int i = 0; i < n + 1; ++i)
+        in2[i] = T((i * 3) % 100);
+      for (int offset : {0, 1})
+        {
+          std::vector<T> out(n + 2, T(1));
+          auto end = std::simd_execution::transform(policy, in.begin() + offset,
+                                                    in.begin() + offset + n,
+                                                    out.begin() + offset, clamp_op);
+          verify_equal(end - out.begin(), offset + n);
+          for (int i = 0; i < n + 2; ++i)
+            {
+              const bool written = i >= offset and i < offset + n;
+              verify_equal(out[i], written ? std::min(in[i], T(50)) : T(1))(n, offset, i);
+            }
+
+          // two inputs, converting to the output type
+          std::vector<double> out2(n + 2, -1.);
+          std::simd_execution::transform(policy, in.begin() + offset, in.begin() + offset + n,
+                                         in2.begin() + offset, out2.begin() + offset, max_op);
+          for (int i = 0; i < n + 2; ++i)
+            {
+              const bool written = i >= offset and i < offset + n;
+              verify_equal(out2[i], written ? double(std::max(in[i], in2[i])) : -1.)(n, offset,
+                                                                                      i);
+            }
+        }
+    }
+
+    static void
+    test_reduce(const auto& policy, int n)
+    {
+      log_start();
+      const std::vector<T> in = make_input(n);
+      for (int offset : {0, 1})
+        {
+          const auto first = in.begin() + offset;
+          const auto last = first + n;
+          T max = T(3);
+          for (auto it = first; it != last; ++it)
+            max = std::max(max, *it);
+          // max_op has no known identity element
+          verify_equal(std::simd_execution::reduce(policy, first, last, T(3), max_op), max)(
+            n, offset);
+          if constexpr (sizeof(T) >= 4)
+            {
+              const T sum = std::reduce(first, last, T(5));
+              verify_equal(std::simd_execution::reduce(policy, first, last), T(sum - T(5)))(
+                n, offset);
+              verify_equal(std::simd_execution::reduce(policy, first, last, T(5)), sum)(n, offset);
+            }
+          // accumulate in a wider type
+          verify_equal(std::simd_execution::reduce(policy, first, last, 1.),
+                       std::reduce(first, last, 1.))(n, offset);
+        }
+    }
+
+    static void
+    test_transform_reduce(const auto& policy, int n)
+    {
+      log_start();
+      const std::vector<T> a = make_input(n);
+      std::vector<T> b(n);
+      for (int i = 0; i < n; ++i)
+        b[i] = T(i % 3);
+      double dot = 0, clamped = 0;
+      for (int i = 0; i < n; ++i)
+        {
+          dot += double(a[i]) * double(b[i]);
+          clamped += std::min(a[i], T(50));
+        }
+      verify_equal(std::simd_execution::transform_reduce(
+                     policy, a.begin(), a.begin() + n, b.begin(), 2., std::plus<>(),
+                     [](auto x, auto y) {
+                       using D = std::rebind_simd_t<double, decltype(x)>;
+                       return D(x) * D(y);
+                     }), dot + 2.)(n);
+      verify_equal(std::simd_execution::transform_reduce(policy, a.begin(), a.begin() + n, 0.,
+                                                         std::plus<>(), [](auto x) {
+                     return std::rebind_simd_t<double, decltype(x)>(clamp_op(x));
+                   }), clamped)(n);
+      if constexpr (sizeof(T) >= 4)
+        verify_equal(std::simd_execution::transform_reduce(policy, a.begin(), a.begin() + n,
+                                                           b.begin(), T(0)), T(dot))(n);
+    }
+
+    // the operations are only called with values of the range (integer division by zero traps)
+    static void
+    test_trapping(int n)
+    {
+      log_start();
+      const std::vector<T> a(n + 1, T(7));
+      const std::vector<T> b(n + 1, T(3));
+      std::vector<T> out(n + 1);
+      const auto div = [](auto x) { return decltype(x)(T(100)) / x; };
+      for (int offset : {0, 1})
+        {
+          const auto first = a.begin() + offset;
+          const auto last = first + (n - offset);
+          std::simd_execution::transform(std::execution::unseq, first, last, out.begin(), div);
+          for (int i = 0; i < n - offset; ++i)
+            verify_equal(out[i], T(100 / 7))(n, offset, i);
+          std::simd_execution::transform(std::execution::unseq, first, last,
+                                         b.begin() + offset, out.begin(),
+                                         [](auto x, auto y) { return x / y + y / x; });
+          for (int i = 0; i < n - offset; ++i)
+            verify_equal(out[i], T(7 / 3))(n, offset, i);
+          verify_equal(std::simd_execution::transform_reduce(std::execution::unseq, first, last,
+                                                             0LL, std::plus<>(), div),
+                       (n - offset) * (100LL / 7))(n, offset);
+          verify_equal(std::simd_execution::transform_reduce(
+                         std::execution::unseq, first, last, b.begin() + offset, 0LL,
+                         std::plus<>(), [](auto x, auto y) { return x / y + y / x; }),
+                       (n - offset) * 2LL)(n, offset);
+        }
+    }
+
+    // concurrent and nested par_unseq calls share the executor (or run on the calling thread)
+    static void
+    test_concurrent()
+    {
+      log_start();
+      constexpr int n = 100'000;
+      const std::vector<T> in = make_input(n);
+      std::vector<T> expected(n);
+      for (int i = 0; i < n; ++i)
+        expected[i] = std::min(in[i], T(50));
+      auto work = [&](std::vector<T>& out) {
+        for (int rep = 0; rep < 20; ++rep)
+          std::simd_execution::transform(std::execution::par_unseq, in.begin(),
+                                         in.begin() + n, out.begin(), clamp_op);
+      };
+      std::vector<T> out1(n), out2(n);
+      {
+        std::jthread t1(work, std::ref(out1));
+        std::jthread t2(work, std::ref(out2));
+      }
+      verify(out1 == expected);
+      verify(out2 == expected);
+
+      // the first chunk calls par_unseq again
+      std::atomic<bool> first = true;
+      T inner = T();
+      std::vector<T> out3(n);
+      std::simd_execution::transform(std::execution::par_unseq, in.begin(), in.begin() + n,
+                                     out3.begin(), [&](auto x) {
+                                       if (first.exchange(false))
+                                         inner = std::simd_execution::reduce(
+                                                   std::execution::par_unseq, in.begin(),
+                                                   in.begin() + n, std::numeric_limits<T>::lowest(),
+                                                   max_op);
+                                       return clamp_op(x);
+                                     });
+      verify(out3 == expected);
+      verify_equal(inner, *std::ranges::max_element(in.begin(), in.begin() + n));
+    }
+
+    // non-contiguous ranges, scalar-only operations, and other policies use the std algorithms
+    static void
+    test_fallback()
+    {
+      log_start();
+      const std::list<T> l = {T(1), T(2), T(3)};
+      std::vector<T> out(3);
+      std::simd_execution::transform(std::execution::unseq, l.begin(), l.end(), out.begin(),
+                                     [](T x) { return T(x + 1); });
+      for (int i = 0; i < 3; ++i)
+        verify_equal(out[i], T(i + 2));
+      verify_equal(std::simd_execution::reduce(std::execution::seq, out.begin(), out.end()),
+                   T(9));
+      verify_equal(std::simd_execution::transform_reduce(std::execution::unseq, l.begin(),
+                                                         l.end(), T(0), std::plus<>(),
+                                                         [](T x) { return T(x * 2); }),
+                   T(12));
+    }
+  };
+
+auto tests = register_tests<simd_execution_tests>();
@@ -0,0 +1,161 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_executor.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <sys/resource.h>
+
+template <typename V>
+  struct simd_executor_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int N = V::size();
+
+    // an operation without known identity element
+    static constexpr auto max_op = [](auto a, auto b) { return std::simd_select(a < b, b, a); };
+
+    static void
+    run()
+    {
+      for (unsigned threads : {1u, 2u, 3u})
+        {
+          std::simd_executor exec(threads);
+          verify_equal(exec.concurrency(), threads);
+          for (int n : {0, 1, N - 1, N + 1, 1000, 100'000})
+            {
+              test_for_each(exec, n);
+              test_reduce(exec, n);
+            }
+          test_errors(exec);
+        }
+      test_startup_failure();
+    }
+
+    // if starting a thread fails, the constructor throws and the threads that already run stop
+    // (instead of ~jthread waiting for them forever)
+    static void
+    test_startup_failure()
+    {
+      log_start();
+      rlimit old;
+      verify(getrlimit(RLIMIT_AS, &old) == 0);
+      std::size_t pages = 0;
+      std::ifstream("/proc/self/statm") >> pages;
+      if (pages == 0)
+        return;
+      // room for a few thread stacks, but not for 64
+      rlimit limit = old;
+      limit.rlim_cur = pages * sysconf(_SC_PAGESIZE) + (64 << 20);
+      if (limit.rlim_cur > old.rlim_max)
+        return;
+      verify(setrlimit(RLIMIT_AS, &limit) == 0);
+      bool thrown = false;
+      try
+        {
+          std::simd_executor exec(64);
+        }
+      catch (const std::system_error&)
+        {
+          thrown = true;
+        }
+      setrlimit(RLIMIT_AS, &old);
+      verify(thrown);
+    }
+
+    // every element is visited exactly once, with the right index
+    static void
+    test_for_each(std::simd_executor& exec, int n)
+    {
+      log_start();
+      std::vector<T> data(n + 1);
+      for (int offset : {0, 1})
+        {
+          std::ranges::fill(data, T(0));
+          const std::span<T> range(data.data() + offset, n);
+          std::simd_for_each<V>(exec, range, [&](auto chunk) {
+            const auto i = chunk.index();
+            auto x = chunk.load();
+            x += V([&](int j) { return T(((i + j) % 7) + 1); });
+            if constexpr (decltype(chunk)::is_partial)
+              x.copy_to(range.data() + i, chunk.mask());
+            else
+              x.copy_to(range.data() + i);
+          });
+          for (int i = 0; i < n; ++i)
+            verify_equal(range[i], T((i % 7) + 1))(exec.concurrency(), n, offset, i);
+          if (offset == 1)
+            verify_equal(data[0], T(0));
+          else
+            verify_equal(data[n], T(0));
+        }
+    }
+
+    static void
+    test_reduce(std::simd_executor& exec, int n)
+    {
+      log_start();
+      std::vector<T> data(n + 1);
+      for (int i = 0; i < n + 1; ++i)
+        data[i] = T((i * 13) % 100);
+      for (int offset : {0, 1})
+        {
+          const std::span<const T> range(data.data() + offset, n);
+          T max = std::numeric_limits<T>::lowest();
+          for (T x : range)
+            max = std::max(max, x);
+          verify_equal(std::simd_reduce<V>(exec, range, std::numeric_limits<T>::lowest(), max_op),
+                       max)(exec.concurrency(), n, offset);
+          if constexpr (sizeof(T) >= 4)
+            {
+              // the sums are exact for float, too
+              T sum = 0;
+              for (T x : range)
+                sum += x;
+              verify_equal(std::simd_reduce<V>(exec, range), sum)(exec.concurrency(), n, offset);
+            }
+          if constexpr (std::integral<T>)
+            {
+              T bits = 0;
+              for (T x : range)
+                bits |= x;
+              verify_equal(std::simd_reduce<V>(exec, range, std::bit_or<>()), bits)(
+                exec.concurrency(), n, offset);
+            }
+        }
+    }
+
+    // an exception thrown from any worker is rethrown, and the executor remains usable
+    static void
+    test_errors(std::simd_executor& exec)
+    {
+      log_start();
+      const std::vector<T> data(100'000, T(1));
+      bool thrown = false;
+      try
+        {
+          std::simd_for_each<V>(exec, data, [](auto chunk) {
+            if (chunk.index() >= 50'000 and chunk.index() < 50'000 + N)
+              throw std::runtime_error("chunk");
+          });
+        }
+      catch (const std::runtime_error& e)
+        {
+          thrown = e.what() == std::string_view("chunk");
+        }
+      verify(thrown);
+      if constexpr (sizeof(T) >= 4)
+        verify_equal(std::simd_reduce<V>(exec, data), T(100'000));
+    }
+  };
+
+auto tests = register_tests<simd_executor_tests>();
@@ -0,0 +1,138 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_group_prefetch.h"
+
+#include <stdexcept>
+#include <vector>
+
+template <typename V>
+  struct simd_group_prefetch_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int K = std::min(V::size(), 64);
+
+    // a chain of links: lookup i follows i % 4 links, starting at i % size, and returns the
+    // element it ends up at
+    static constexpr int size = 97;
+
+    struct Node
+    {
+      int next;
+      T value;
+    };
+
+    static inline const std::vector<Node> nodes = [] {
+      std::vector<Node> r(size);
+      for (int i = 0; i < size; ++i)
+        r[i] = {(i * 13 + 5) % size, T(i % 100)};
+      return r;
+    }();
+
+    static T
+    expected(std::size_t id)
+    {
+      int i = id % size;
+      for (std::size_t link = 0; link < id % 4; ++link)
+        i = nodes[i].next;
+      return nodes[i].value;
+    }
+
+    static std::simd_prefetch_task<T>
+    lookup(std::size_t id)
+    {
+      int i = id % size;
+      for (std::size_t link = 0; link < id % 4; ++link)
+        {
+          co_await std::simd_prefetch(&nodes[nodes[i].next]);
+          i = nodes[i].next;
+        }
+      co_return nodes[i].value;
+    }
+
+    static void
+    run()
+    {
+      for (std::size_t n : {0, 1, K - 1, K, K + 1, 1000})
+        test_lookups(n);
+      test_exception();
+    }
+
+    // every lookup is reported exactly once, with the right value, in batches of K
+    static void
+    test_lookups(std::size_t n)
+    {
+      log_start();
+      std::vector<int> seen(n);
+      std::size_t batches = 0;
+      std::size_t valid = 0;
+      std::simd_group_prefetch<K>(n, lookup, [&](const auto& values, const auto& ids,
+                                                 const auto& k) {
+        static_assert(std::remove_cvref_t<decltype(values)>::size() == K);
+        static_assert(std::same_as<typename std::remove_cvref_t<decltype(ids)>::value_type,
+                                   std::uint32_t>);
+        ++batches;
+        for (int i = 0; i < K; ++i)
+          if (k[i])
+            {
+              ++valid;
+              verify(ids[i] < n)(n, i, ids[i]);
+              ++seen[ids[i]];
+              verify_equal(values[i], expected(ids[i]))(n, i, ids[i]);
+            }
+          else
+            verify_equal(values[i], T())(n, i);
+      });
+      verify_equal(valid, n);
+      verify_equal(batches, (n + K - 1) / K);
+      for (std::size_t id = 0; id < n; ++id)
+        verify_equal(seen[id], 1)(n, id);
+    }
+
+    static void
+    test_exception()
+    {
+      log_start();
+      auto throwing = [](std::size_t id) -> std::simd_prefetch_task<T> {
+        co_await std::simd_prefetch(&nodes[id % size]);
+        if (id == 10)
+          throw std::runtime_error("lookup failed");
+        co_return T();
+      };
+      bool caught = false;
+      try
+        {
+          std::simd_group_prefetch<K>(100, throwing, [](auto&&...) {});
+        }
+      catch (const std::runtime_error&)
+        {
+          caught = true;
+        }
+      verify(caught);
+
+      // the ids must fit into uint32_t
+      caught = false;
+      std::size_t lookups = 0;
+      try
+        {
+          std::simd_group_prefetch<K>(std::size_t(UINT32_MAX) + 2,
+                                      [&](std::size_t id) {
+                                        ++lookups;
+                                        return lookup(id % size);
+                                      }, [](auto&&...) {});
+        }
+      catch (const std::length_error&)
+        {
+          caught = true;
+        }
+      verify(caught);
+      verify_equal(lookups, 0u);
+    }
+  };
+
+auto tests = register_tests<simd_group_prefetch_tests>();
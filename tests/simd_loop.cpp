@@ -0,0 +1,116 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_loop.h"
+
+#include <cstdint>
+#include <span>
+#include <sys/mman.h>
+#include <unistd.h>
+
+template <typename V>
+  struct simd_loop_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int N = V::size();
+
+    static constexpr std::size_t alignment = std::simd_alignment_v<V>;
+
+    static void
+    run()
+    {
+      test_for_each(std::simd_flag_default);
+      test_for_each(std::__simd_flag_page_safe);
+      test_for_each(std::__simd_flag_prefetch_stream<>);
+      test_for_each(std::__simd_flag_prefetch_stream<100> | std::__simd_flag_page_safe);
+      test_partial_load();
+    }
+
+    // partial loads next to an inaccessible page must not fault
+    static void
+    test_partial_load()
+    {
+      log_start();
+      const std::size_t page = sysconf(_SC_PAGESIZE);
+      if (page < N * sizeof(T))
+        return;
+      char* mem = static_cast<char*>(mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE,
+                                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+      verify(mem != MAP_FAILED);
+      mprotect(mem + page, page, PROT_NONE);
+      T* const page_end = reinterpret_cast<T*>(mem + page);
+      for (int n = 0; n <= N; ++n)
+        {
+          for (T* ptr : {page_end - n, reinterpret_cast<T*>(mem) + 3})
+            {
+              for (int i = 0; i < n; ++i)
+                ptr[i] = T(i + 1);
+              const V expected([&](int i) { return i < n ? T(i + 1) : T(); });
+              verify_equal(std::simd_partial_load<V>(ptr, n), expected)(n);
+              verify_equal(std::simd_partial_load<V>(ptr, n, std::__simd_flag_page_safe),
+                           expected)(n);
+            }
+        }
+      munmap(mem, 2 * page);
+    }
+
+    static void
+    test_for_each(auto flags)
+    {
+      alignas(64) T mem[4 * 64 + 8] = {};
+      constexpr int total = sizeof(mem) / sizeof(T);
+      for (int offset = 0; offset <= N + 1; ++offset)
+        for (int n : {0, 1, N - 1, N, N + 1, 3 * N + 2})
+          {
+            if (n < 0 or offset + n + 1 > total)
+              continue;
+            log_start();
+            for (int i = 0; i < total; ++i)
+              mem[i] = T(i % 64);
+            std::span<T> data(mem + offset, n);
+
+            // every element is visited exactly once; lanes are in order
+            int visited = 0;
+            int partial_chunks = 0;
+            std::simd_for_each_aligned<V>(data, [&](auto chunk) {
+              using C = decltype(chunk);
+              verify_equal(std::size_t(visited), chunk.index())(offset, n);
+              visited += chunk.size();
+              verify_equal(reduce_count(chunk.mask()), int(chunk.size()))(offset, n);
+              if constexpr (C::is_partial)
+                ++partial_chunks;
+              else if constexpr (N * sizeof(T) % alignment == 0)
+                verify_equal(reinterpret_cast<std::uintptr_t>(data.data() + chunk.index())
+                               % alignment, 0u)(offset, n, chunk.index());
+              const V x = chunk.load();
+              verify_equal(x, V([&](int i) {
+                             return i < int(chunk.size()) ? T((offset + chunk.index() + i) % 64)
+                                                          : T();
+                           }))(offset, n);
+              chunk.store(x + T(1));
+            }, flags);
+            verify_equal(visited, n);
+            verify(partial_chunks <= 2)(offset, n);
+
+            // the stores touch only the range
+            for (int i = 0; i < total; ++i)
+              verify_equal(mem[i], T(i % 64 + (i >= offset and i < offset + n)))(offset, n, i);
+
+            // read-only ranges
+            const std::span<const T> cdata = data;
+            V sum = V();
+            std::simd_for_each_aligned<V>(cdata, [&](auto chunk) { sum += chunk.load(); }, flags);
+            T expected = T();
+            for (T x : cdata)
+              expected += x;
+            verify_equal(reduce(sum), expected)(offset, n);
+          }
+    }
+  };
+
+auto tests = register_tests<simd_loop_tests>();
@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_mapped_span.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <system_error>
+#include <vector>
+
+template <typename V>
+  struct simd_mapped_span_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int N = V::size();
+
+    static void
+    run()
+    {
+      const int page_elements = sysconf(_SC_PAGESIZE) / sizeof(T);
+      for (int n : {0, 1, N - 1, N, N + 1, 3 * N + 2, page_elements, 2 * page_elements - 1})
+        {
+          test_map(n, std::simd_map_advice::sequential);
+          test_map(n, std::simd_map_advice::normal);
+        }
+      test_map(page_elements, std::simd_map_advice::huge_pages | std::simd_map_advice::populate);
+      test_missing_file();
+    }
+
+    // writes a file with n elements and returns its path
+    static std::string
+    make_file(int n)
+    {
+      char path[] = "/tmp/simd_mapped_span_XXXXXX";
+      const int fd = mkstemp(path);
+      verify(fd >= 0);
+      std::vector<T> data(n);
+      for (int i = 0; i < n; ++i)
+        data[i] = T(i % 100 + 1);
+      verify_equal(write(fd, data.data(), n * sizeof(T)), ssize_t(n * sizeof(T)));
+      close(fd);
+      return path;
+    }
+
+    // loads at multiples of N are aligned only if N * sizeof(T) is a multiple of the alignment
+    static V
+    load(const T* p)
+    {
+      if constexpr (N * sizeof(T) % std::simd_alignment_v<V> == 0)
+        return V(p, std::simd_flag_aligned);
+      else
+        return V(p);
+    }
+
+    static void
+    test_map(int n, std::simd_map_advice advice)
+    {
+      log_start();
+      const std::string path = make_file(n);
+      std::simd_mapped_span<T, V> mapped(path.c_str(), advice);
+      unlink(path.c_str());
+      verify_equal(mapped.size(), std::size_t(n));
+      verify_equal(mapped.empty(), n == 0);
+      verify_equal(mapped.padded_size() % N, 0u);
+      verify(mapped.padded_size() >= mapped.size());
+      verify_equal(reinterpret_cast<std::uintptr_t>(mapped.data()) % std::simd_alignment_v<V>,
+                   0u);
+      for (int i = 0; i < n; ++i)
+        verify_equal(mapped[i], T(i % 100 + 1))(n, i);
+
+      // full-width loads of the padded range, the padding is zero
+      const std::span<const T> padded = mapped.padded();
+      for (std::size_t i = 0; i < padded.size(); i += N)
+        verify_equal(load(padded.data() + i),
+                     V([&](std::size_t j) {
+                       return i + j < std::size_t(n) ? T((i + j) % 100 + 1) : T();
+                     }))(n, i);
+
+      // a contiguous range for the basic_simd range constructors
+      if (n >= N)
+        verify_equal(V(mapped), V([](int i) { return T(i % 100 + 1); }));
+
+      const std::simd_mapped_span<T, V> moved = std::move(mapped);
+      verify_equal(moved.size(), std::size_t(n));
+      verify_equal(mapped.size(), 0u);
+    }
+
+    static void
+    test_missing_file()
+    {
+      log_start();
+      bool thrown = false;
+      try
+        {
+          std::simd_mapped_span<T, V> mapped("/nonexistent/simd_mapped_span");
+        }
+      catch (const std::system_error& e)
+        {
+          thrown = e.code().value() == ENOENT;
+        }
+      verify(thrown);
+    }
+  };
+
+auto tests = register_tests<simd_mapped_span_tests>();
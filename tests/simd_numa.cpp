@@ -0,0 +1,96 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_allocator.h"
+#include "../simd_executor.h"
+#include "../simd_numa.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+// a directory with the layout of /sys/devices/system/node: two nodes with CPUs and a memory-only
+// node
+static const std::string fake_sysfs = [] {
+  char tmpl[] = "/tmp/simd_numa_XXXXXX";
+  const std::string dir = mkdtemp(tmpl);
+  auto write = [&](const std::string& file, const char* content) {
+    std::filesystem::create_directories(std::filesystem::path(dir + file).parent_path());
+    std::ofstream(dir + file) << content;
+  };
+  write("/online", "0-2\n");
+  write("/node0/cpulist", "0-1,4\n");
+  write("/node1/cpulist", "2-3,5-6\n");
+  write("/node2/cpulist", "\n");
+  return dir;
+}();
+
+static const int cleanup = std::atexit([] { std::filesystem::remove_all(fake_sysfs); });
+
+template <typename V>
+  struct simd_numa_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int N = V::size();
+
+    static void
+    run()
+    {
+      test_topology();
+      test_executor(std::simd_numa_topology(), 0);
+      test_executor(std::simd_numa_topology(fake_sysfs), 0);
+      test_executor(std::simd_numa_topology(fake_sysfs), 3);
+    }
+
+    static void
+    test_topology()
+    {
+      log_start();
+      const std::simd_numa_topology fake(fake_sysfs);
+      verify_equal(fake.nodes().size(), 2u);
+      verify_equal(fake.nodes()[0].id, 0u);
+      verify(fake.nodes()[0].cpus == std::vector<unsigned>{0, 1, 4});
+      verify_equal(fake.nodes()[1].id, 1u);
+      verify(fake.nodes()[1].cpus == std::vector<unsigned>{2, 3, 5, 6});
+      verify_equal(fake.cpus(), 7u);
+
+      // a missing directory is a single node
+      const std::simd_numa_topology missing(fake_sysfs + "/nonexistent");
+      verify_equal(missing.nodes().size(), 1u);
+      verify_equal(missing.cpus(), 1u);
+
+      const std::simd_numa_topology machine;
+      verify(machine.nodes().size() >= 1);
+      verify(machine.cpus() >= 1);
+      for (const std::simd_numa_node& node : machine.nodes())
+        verify(not node.cpus.empty())(node.id);
+    }
+
+    static void
+    test_executor(const std::simd_numa_topology& topology, unsigned threads)
+    {
+      log_start();
+      std::simd_executor exec(topology, threads);
+      verify_equal(exec.concurrency(), threads == 0 ? topology.cpus() : threads);
+      for (int n : {0, 1, N + 1, 100'000})
+        {
+          auto buf = std::simd_buffer<T, V>::for_overwrite(n);
+          std::simd_first_touch<V>(exec, buf, T(1));
+          for (int i = 0; i < n; ++i)
+            verify_equal(buf[i], T(1))(n, i);
+          for (std::size_t i = n; i < buf.padded_size(); ++i)
+            verify_equal(buf.padded()[i], T())(n, i);
+          if constexpr (sizeof(T) >= 4)
+            verify_equal(std::simd_reduce<V>(exec, buf), T(n))(n);
+          else if constexpr (std::integral<T>)
+            verify_equal(std::simd_reduce<V>(exec, buf, std::bit_or<>()), T(n > 0))(n);
+        }
+    }
+  };
+
+auto tests = register_tests<simd_numa_tests>();
@@ -0,0 +1,170 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_pipeline.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <typename V>
+  struct simd_pipeline_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int N = V::size();
+
+    static constexpr auto pipeline
+      = std::simd_pipeline() | [](auto x) { return x * T(2); } | [](auto x) { return x + T(1); }
+          | [](auto x) { return std::simd_select(x > T(50), x - T(50), x); };
+
+    static constexpr T
+    expected(T x)
+    {
+      const T y = T(T(x * T(2)) + T(1));
+      return y > T(50) ? T(y - T(50)) : y;
+    }
+
+    static void
+    run()
+    {
+      test_pipeline();
+      for (int n : {0, 1, N - 1, N, N + 1, 3 * N + 2, 1000})
+        test_transform(n);
+      if constexpr (std::is_integral_v<T>)
+        for (int n : {1, N - 1, N + 1, 1000})
+          test_trapping(n);
+      for (int n : {0, 1, 777, 5000, 20000})
+        test_stream(n);
+      test_stream_errors();
+    }
+
+    static void
+    test_pipeline()
+    {
+      log_start();
+      const V x([](int i) { return T(i % 40); });
+      verify_equal(pipeline(x), V([&](int i) { return expected(x[i]); }));
+      // pipelines are stages, too
+      const auto twice = std::simd_pipeline() | pipeline | pipeline;
+      verify_equal(twice(x), V([&](int i) { return expected(expected(x[i])); }));
+    }
+
+    static void
+    test_transform(int n)
+    {
+      log_start();
+      std::vector<T> in(n + 1), out(n + N + 1, T(-1));
+      for (int i = 0; i < n + 1; ++i)
+        in[i] = T(i % 40);
+      for (int offset : {0, 1})
+        {
+          std::ranges::fill(out, T(-1));
+          const std::span<const T> src(in.data() + offset, n);
+          std::simd_transform<V>(src, std::span<T>(out.data() + offset, n), pipeline);
+          for (int i = 0; i < n + N + 1; ++i)
+            {
+              const bool written = i >= offset and i < offset + n;
+              verify_equal(out[i], written ? expected(in[i]) : T(-1))(n, offset, i);
+            }
+        }
+    }
+
+    // fn must not see the padding lanes of partial chunks (integer division by zero traps)
+    static void
+    test_trapping(int n)
+    {
+      log_start();
+      constexpr auto div = [](auto x) { return decltype(x)(T(100)) / x; };
+      std::vector<T> in(n + 1, T(7)), out(n + 1, T(-1));
+      for (int offset : {0, 1})
+        {
+          std::simd_transform<V>(std::span<const T>(in.data() + offset, n),
+                                 std::span<T>(out.data() + offset, n), div);
+          for (int i = offset; i < offset + n; ++i)
+            verify_equal(out[i], T(100 / 7))(n, offset, i);
+        }
+      std::vector<T> streamed;
+      bool done = false;
+      std::simd_stream<V>([&](std::span<T> block) {
+        if (std::exchange(done, true))
+          return std::size_t();
+        const std::size_t k = std::min(std::size_t(n), block.size());
+        std::ranges::fill(block.first(k), T(7));
+        return k;
+      }, div, [&](std::span<const T> results) {
+        streamed.insert(streamed.end(), results.begin(), results.end());
+      });
+      verify(not streamed.empty());
+      for (int i = 0; i < int(streamed.size()); ++i)
+        verify_equal(streamed[i], T(100 / 7))(n, i);
+    }
+
+    // the source delivers 333 elements per call (less than a block)
+    static void
+    test_stream(int n)
+    {
+      log_start();
+      std::vector<T> out;
+      int next = 0;
+      std::simd_stream<V>([&](std::span<T> block) {
+        const int k = std::min({n - next, int(block.size()), 333});
+        for (int i = 0; i < k; ++i)
+          block[i] = T((next + i) % 40);
+        next += k;
+        return std::size_t(k);
+      }, pipeline, [&](std::span<const T> results) {
+        out.insert(out.end(), results.begin(), results.end());
+      });
+      verify_equal(out.size(), std::size_t(n));
+      for (int i = 0; i < int(out.size()); ++i)
+        verify_equal(out[i], expected(T(i % 40)))(n, i);
+    }
+
+    static void
+    test_stream_errors()
+    {
+      log_start();
+      int calls = 0;
+      auto endless = [&](std::span<T> block) {
+        if (++calls == 10)
+          throw std::runtime_error("source");
+        std::ranges::fill(block, T(1));
+        return block.size();
+      };
+      bool thrown = false;
+      try
+        {
+          std::simd_stream<V>(endless, pipeline, [](std::span<const T>) {});
+        }
+      catch (const std::runtime_error& e)
+        {
+          thrown = e.what() == std::string_view("source");
+        }
+      verify(thrown);
+
+      calls = 0;
+      thrown = false;
+      int sunk = 0;
+      try
+        {
+          std::simd_stream<V>(endless, pipeline, [&](std::span<const T>) {
+            if (++sunk == 3)
+              throw std::runtime_error("sink");
+          });
+        }
+      catch (const std::runtime_error& e)
+        {
+          thrown = e.what() == std::string_view("sink");
+        }
+      verify(thrown);
+      verify_equal(sunk, 3);
+    }
+  };
+
+auto tests = register_tests<simd_pipeline_tests>();
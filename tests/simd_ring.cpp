@@ -0,0 +1,160 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_ring.h"
+
+#include <thread>
+#include <vector>
+
+template <typename V>
+  struct simd_ring_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int N = V::size();
+
+    static V
+    batch(int k)
+    { return V([&](int i) { return T((k + i) % 100); }); }
+
+    static void
+    run()
+    {
+      test_single_thread<std::simd_ring_kind::spsc>();
+      test_single_thread<std::simd_ring_kind::mpmc>();
+      test_spsc_threads();
+      test_mpmc_threads();
+    }
+
+    template <std::simd_ring_kind Kind>
+      static void
+      test_single_thread()
+      {
+        log_start();
+        verify_equal(std::simd_ring<V, Kind>(0).capacity(), 1u);
+        verify_equal(std::simd_ring<V, Kind>(5).capacity(), 8u);
+        verify_equal(std::simd_ring<V, Kind>(8).capacity(), 8u);
+
+        std::simd_ring<V, Kind> ring(8);
+        verify_equal(ring.size(), 0u);
+        V x = batch(0);
+        verify(not ring.try_pop(x));
+
+        std::vector<V> in(20), out(20);
+        for (int k = 0; k < 20; ++k)
+          in[k] = batch(k);
+        // full: only a prefix is pushed
+        verify_equal(ring.push(std::span(in).first(5)), 5u);
+        verify_equal(ring.push(std::span(in).subspan(5, 10)), 3u);
+        verify_equal(ring.size(), 8u);
+        verify(not ring.try_push(in[8]));
+
+        // partial pop, then wrap around
+        verify_equal(ring.pop(std::span(out).first(6)), 6u);
+        verify_equal(ring.size(), 2u);
+        verify_equal(ring.push(std::span(in).subspan(8, 6)), 6u);
+        verify_equal(ring.pop(std::span(out).subspan(6)), 8u);
+        verify_equal(ring.size(), 0u);
+        for (int k = 0; k < 14; ++k)
+          verify(all_of(out[k] == in[k]))(k, out[k], in[k]);
+
+        // zero-copy construction and processing in place
+        verify_equal(ring.produce(0, [](V&, std::size_t) {}), 0u);
+        verify_equal(ring.produce(3, [](V& slot, std::size_t i) { slot = batch(int(i) + 50); }),
+                     3u);
+        verify(ring.try_push(batch(53)));
+        std::size_t seen = 0;
+        verify_equal(ring.consume(10, [&](V& slot, std::size_t i) {
+                       verify(all_of(slot == batch(int(i) + 50)))(i, slot);
+                       ++seen;
+                     }), 4u);
+        verify_equal(seen, 4u);
+        verify_equal(ring.consume(10, [](V&, std::size_t) {}), 0u);
+      }
+
+    // one producer and one consumer thread: every batch arrives, in order
+    static void
+    test_spsc_threads()
+    {
+      log_start();
+      constexpr int count = 20'000;
+      std::simd_ring<V> ring(16);
+      std::jthread producer([&] {
+        for (int k = 0; k < count;)
+          k += ring.produce(std::min(5, count - k), [&](V& slot, std::size_t i) {
+                 slot = batch(k + int(i));
+               });
+      });
+      int mismatch = -1;
+      for (int k = 0; k < count;)
+        k += ring.consume(7, [&](V& slot, std::size_t i) {
+               if (mismatch < 0 and not all_of(slot == batch(k + int(i))))
+                 mismatch = k + int(i);
+             });
+      verify_equal(mismatch, -1);
+      verify_equal(ring.size(), 0u);
+    }
+
+    // several producer and consumer threads: every batch arrives exactly once
+    static void
+    test_mpmc_threads()
+    {
+      log_start();
+      constexpr int threads = 3;
+      constexpr int count = 10'000;
+      std::simd_ring<V, std::simd_ring_kind::mpmc> ring(16);
+      // received[c][p]: the number of batches consumer c received from producer p
+      std::vector<std::vector<int>> received(threads, std::vector<int>(threads));
+      std::vector<int> torn(threads);
+      std::atomic<int> remaining = threads * count;
+      {
+        std::vector<std::jthread> workers;
+        for (int p = 0; p < threads; ++p)
+          workers.emplace_back([&, p] {
+            for (int k = 0; k < count;)
+              {
+                const std::size_t pushed = ring.produce(std::min(4, count - k),
+                                                        [&](V& slot, std::size_t) {
+                                                          slot = V(T(p + 1));
+                                                        });
+                if (pushed == 0)
+                  std::this_thread::yield();
+                k += pushed;
+              }
+          });
+        for (int c = 0; c < threads; ++c)
+          workers.emplace_back([&, c] {
+            while (remaining.load(std::memory_order_relaxed) > 0)
+              {
+                const std::size_t popped = ring.consume(3, [&](V& slot, std::size_t) {
+                  const int p = int(slot[0]) - 1;
+                  if (p < 0 or p >= threads or not all_of(slot == slot[0]))
+                    ++torn[c];
+                  else
+                    ++received[c][p];
+                });
+                if (popped == 0)
+                  std::this_thread::yield();
+                remaining -= popped;
+              }
+          });
+      }
+      verify_equal(remaining.load(), 0);
+      verify_equal(ring.size(), 0u);
+      for (int c = 0; c < threads; ++c)
+        verify_equal(torn[c], 0)(c);
+      for (int p = 0; p < threads; ++p)
+        {
+          int total = 0;
+          for (int c = 0; c < threads; ++c)
+            total += received[c][p];
+          verify_equal(total, count)(p);
+        }
+    }
+  };
+
+auto tests = register_tests<simd_ring_tests>();
@@ -0,0 +1,198 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2024 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                  Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include "../simd_vector.h"
+
+#include <map>
+
+// throws on the allocation with index fail_at and records deallocations whose size does not
+// match the allocation
+struct FailingResource : std::pmr::memory_resource
+{
+  int allocations = 0;
+
+  int fail_at = -1;
+
+  int mismatches = 0;
+
+  std::map<void*, std::size_t> live;
+
+  void*
+  do_allocate(std::size_t n, std::size_t a) override
+  {
+    if (allocations++ == fail_at)
+      throw std::bad_alloc();
+    void* p = std::pmr::new_delete_resource()->allocate(n, a);
+    live[p] = n;
+    return p;
+  }
+
+  void
+  do_deallocate(void* p, std::size_t n, std::size_t a) override
+  {
+    const auto it = live.find(p);
+    if (it == live.end())
+      {
+        ++mismatches;
+        return;
+      }
+    mismatches += it->second != n;
+    std::pmr::new_delete_resource()->deallocate(p, it->second, a);
+    live.erase(it);
+  }
+
+  bool
+  do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  { return this == &other; }
+};
+
+// a user-defined aggregate that opts into the tuple protocol
+template <typename T>
+  struct Particle
+  {
+    T x;
+    float m;
+
+    friend constexpr bool
+    operator==(const Particle&, const Particle&) = default;
+
+    friend std::ostream&
+    operator<<(std::ostream& s, const Particle& p)
+    { return s << '{' << p.x << ", " << p.m << '}'; }
+  };
+
+template <typename T>
+  struct std::tuple_size<Particle<T>>
+  : std::integral_constant<std::size_t, 2>
+  {};
+
+template <std::size_t I, typename T>
+  struct std::tuple_element<I, Particle<T>>
+  { using type = std::conditional_t<I == 0, T, float>; };
+
+template <std::size_t I, typename T>
+  constexpr const auto&
+  get(const Particle<T>& p)
+  {
+    if constexpr (I == 0)
+      return p.x;
+    else
+      return p.m;
+  }
+
+template <typename V>
+  struct simd_vector_tests
+  {
+    using T = typename V::value_type;
+
+    static constexpr int N = V::size();
+
+    using P = Particle<T>;
+
+    static P
+    make(int i)
+    { return {T(i % 100), float(i) / 2}; }
+
+    static void
+    run()
+    {
+      if constexpr (std::destructible<std::simd<float, N>>)
+        {
+          using SV = std::simd_vector<P, N>;
+          static_assert(std::same_as<typename SV::simd_value_type,
+                                     std::tuple<V, std::simd<float, N>>>);
+          for (int n : {0, 1, N - 1, N, N + 1, 3 * N + 2})
+            {
+              log_start();
+              SV v;
+              for (int i = 0; i < n; ++i)
+                v.push_back(make(i));
+              verify_equal(v.size(), std::size_t(n));
+              verify_equal(v.capacity() % N, 0u);
+              for (int i = 0; i < n; ++i)
+                verify_equal(v[i], make(i))(i);
+
+              // chunk loads zero the lanes past the end
+              int count = 0;
+              for (auto&& chunk : v.chunks())
+                {
+                  verify_equal(chunk.index(), std::size_t(count * N));
+                  const auto [x, m] = chunk.load();
+                  verify_equal(x, V([&](int i) {
+                                 return chunk.index() + i < std::size_t(n) ? T((count * N + i) % 100)
+                                                                         : T();
+                               }))(n, count);
+                  verify_equal(m[0], float(count * N) / 2)(n, count);
+                  verify_equal(reduce_count(chunk.mask()), int(chunk.size()))(n, count);
+                  ++count;
+                }
+              verify_equal(count, (n + N - 1) / N);
+
+              // chunk stores keep the padding zero
+              for (auto chunk : v.chunks())
+                {
+                  auto [x, m] = chunk.load();
+                  chunk = {x + T(1), m * 2.f};
+                }
+              for (int i = 0; i < n; ++i)
+                verify_equal(v[i], P{T(make(i).x + T(1)), float(i)})(i);
+              if (n % N != 0)
+                {
+                  const auto last = v.chunk(n / N * N);
+                  verify_equal(last.template get<0>(),
+                               V([&](int i) { return i < n % N ? T((n / N * N + i) % 100 + 1)
+                                                               : T(); }))(n);
+                }
+
+              // shrinking re-zeroes the removed elements, copies are deep
+              const SV copy = v;
+              v.resize(n / 2);
+              v.resize(n);
+              for (int i = n / 2; i < n; ++i)
+                verify_equal(v[i], P{})(i);
+              for (int i = 0; i < n; ++i)
+                verify_equal(copy[i], P{T(make(i).x + T(1)), float(i)})(i);
+              verify_equal(copy.template column<1>().size(), std::size_t(n));
+            }
+
+          // std::tuple works out of the box
+          std::simd_vector<std::tuple<T, double>, N> t = {{T(1), 2.}, {T(3), 4.}};
+          verify_equal(std::get<1>(t[1]), 4.);
+          verify_equal(std::get<0>(t.chunk(1 / N * N).load())[1 % N], T(3));
+
+          // a reallocation that fails on the second column releases the first and leaves the
+          // vector unchanged
+          log_start();
+          FailingResource res;
+          {
+            SV v(&res);
+            v.push_back(make(1));
+            const std::size_t capacity = v.capacity();
+            res.fail_at = res.allocations + 1;
+            bool thrown = false;
+            try
+              {
+                v.reserve(capacity + 1);
+              }
+            catch (const std::bad_alloc&)
+              {
+                thrown = true;
+              }
+            verify_equal(thrown, true);
+            verify_equal(v.capacity(), capacity);
+            verify_equal(v.size(), 1u);
+            verify_equal(v[0], make(1));
+            v.reserve(capacity + 1);
+            verify_equal(v[0], make(1));
+          }
+          verify_equal(res.mismatches, 0);
+          verify_equal(res.live.size(), 0u);
+        }
+    }
+  };
+
+auto tests = register_tests<simd_vector_tests>();
@@ -236,6 +236,120 @@ namespace std::__detail
         __assert_unreachable<decltype(__x)>();
     }
 
+  /**
+   * vmaskmovps/pd (AVX) and vpmaskmovd/q (AVX2): Load the elements of \p __mem selected by the MSB
+   * of the corresponding element in \p __k. The other elements are zero and their memory is not
+   * accessed, i.e. cannot fault. Inputs smaller than 16 Bytes are zero-padded (and thus the padding
+   * is not loaded).
+   */
+  template <__vec_builtin _TV, auto _Flags = _MachineFlags()>
+    requires (sizeof(__value_type_of<_TV>) >= 4 and sizeof(_TV) <= 32)
+    _GLIBCXX_SIMD_ALWAYS_INLINE inline _TV
+    __maskload(const void* __mem, __vec_builtin auto __k) noexcept
+    {
+      static_assert(_Flags._M_have_avx and sizeof(__k) == sizeof(_TV));
+      using _Tp = __value_type_of<_TV>;
+      if constexpr (sizeof(_TV) < 16)
+        return __vec_bitcast_trunc<_TV>(
+                 __maskload<__vec_builtin_type_bytes<_Tp, 16>>(__mem, __vec_zero_pad_to_16(__k)));
+      else if constexpr (sizeof(_Tp) == 4 and sizeof(_TV) == 16)
+        {
+          const auto __ki = reinterpret_cast<__v4int32>(__k);
+          if constexpr (_Flags._M_have_avx2 and is_integral_v<_Tp>)
+            return reinterpret_cast<_TV>(
+                     __builtin_ia32_maskloadd(static_cast<const __v4int32*>(__mem), __ki));
+          else
+            return reinterpret_cast<_TV>(
+                     __builtin_ia32_maskloadps(static_cast<const __v4float*>(__mem), __ki));
+        }
+      else if constexpr (sizeof(_Tp) == 4)
+        {
+          const auto __ki = reinterpret_cast<__v8int32>(__k);
+          if constexpr (_Flags._M_have_avx2 and is_integral_v<_Tp>)
+            return reinterpret_cast<_TV>(
+                     __builtin_ia32_maskloadd256(static_cast<const __v8int32*>(__mem), __ki));
+          else
+            return reinterpret_cast<_TV>(
+                     __builtin_ia32_maskloadps256(static_cast<const __v8float*>(__mem), __ki));
+        }
+      else if constexpr (sizeof(_TV) == 16)
+        {
+          const auto __ki = reinterpret_cast<__v2llong>(__k);
+          if constexpr (_Flags._M_have_avx2 and is_integral_v<_Tp>)
+            return reinterpret_cast<_TV>(
+                     __builtin_ia32_maskloadq(static_cast<const __v2llong*>(__mem), __ki));
+          else
+            return reinterpret_cast<_TV>(
+                     __builtin_ia32_maskloadpd(static_cast<const __v2double*>(__mem), __ki));
+        }
+      else
+        {
+          const auto __ki = reinterpret_cast<__v4llong>(__k);
+          if constexpr (_Flags._M_have_avx2 and is_integral_v<_Tp>)
+            return reinterpret_cast<_TV>(
+                     __builtin_ia32_maskloadq256(static_cast<const __v4llong*>(__mem), __ki));
+          else
+            return reinterpret_cast<_TV>(
+                     __builtin_ia32_maskloadpd256(static_cast<const __v4double*>(__mem), __ki));
+        }
+    }
+
+  /**
+   * vmaskmovps/pd (AVX) and vpmaskmovd/q (AVX2): Store the elements of \p __v selected by the MSB
+   * of the corresponding element in \p __k. The memory of the other elements is not accessed.
+   */
+  template <auto _Flags = _MachineFlags()>
+    _GLIBCXX_SIMD_ALWAYS_INLINE inline void
+    __maskstore(void* __mem, __vec_builtin auto __v, __vec_builtin auto __k) noexcept
+    {
+      using _TV = decltype(__v);
+      using _Tp = __value_type_of<_TV>;
+      static_assert(_Flags._M_have_avx and sizeof(__k) == sizeof(_TV) and sizeof(_Tp) >= 4
+                      and sizeof(_TV) <= 32);
+      if constexpr (sizeof(_TV) < 16)
+        __maskstore(__mem, __vec_zero_pad_to_16(__v), __vec_zero_pad_to_16(__k));
+      else if constexpr (sizeof(_Tp) == 4 and sizeof(_TV) == 16)
+        {
+          const auto __ki = reinterpret_cast<__v4int32>(__k);
+          if constexpr (_Flags._M_have_avx2 and is_integral_v<_Tp>)
+            __builtin_ia32_maskstored(static_cast<__v4int32*>(__mem), __ki,
+                                      reinterpret_cast<__v4int32>(__v));
+          else
+            __builtin_ia32_maskstoreps(static_cast<__v4float*>(__mem), __ki,
+                                       reinterpret_cast<__v4float>(__v));
+        }
+      else if constexpr (sizeof(_Tp) == 4)
+        {
+          const auto __ki = reinterpret_cast<__v8int32>(__k);
+          if constexpr (_Flags._M_have_avx2 and is_integral_v<_Tp>)
+            __builtin_ia32_maskstored256(static_cast<__v8int32*>(__mem), __ki,
+                                         reinterpret_cast<__v8int32>(__v));
+          else
+            __builtin_ia32_maskstoreps256(static_cast<__v8float*>(__mem), __ki,
+                                          reinterpret_cast<__v8float>(__v));
+        }
+      else if constexpr (sizeof(_TV) == 16)
+        {
+          const auto __ki = reinterpret_cast<__v2llong>(__k);
+          if constexpr (_Flags._M_have_avx2 and is_integral_v<_Tp>)
+            __builtin_ia32_maskstoreq(static_cast<__v2llong*>(__mem), __ki,
+                                      reinterpret_cast<__v2llong>(__v));
+          else
+            __builtin_ia32_maskstorepd(static_cast<__v2double*>(__mem), __ki,
+                                       reinterpret_cast<__v2double>(__v));
+        }
+      else
+        {
+          const auto __ki = reinterpret_cast<__v4llong>(__k);
+          if constexpr (_Flags._M_have_avx2 and is_integral_v<_Tp>)
+            __builtin_ia32_maskstoreq256(static_cast<__v4llong*>(__mem), __ki,
+                                         reinterpret_cast<__v4llong>(__v));
+          else
+            __builtin_ia32_maskstorepd256(static_cast<__v4double*>(__mem), __ki,
+                                          reinterpret_cast<__v4double>(__v));
+        }
+    }
+
   // calling the andnot builtins inhibits some optimizations, whereas GCC seems to be perfectly able
   // to choose andn instructions by itself without any help
 #if 0 // not defined __clang__